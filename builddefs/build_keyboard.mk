@@ -564,6 +564,16 @@ top-symbols: build
 	echo "###########################################"
 endif
 
+# Debounce state is statically allocated, report how much RAM it takes.
+# Every debounce algorithm names its state with a debounce_ prefix so it is counted here.
+ifneq ($(strip $(DEBOUNCE_TYPE)), custom)
+all: debounce-size
+check-size: debounce-size
+debounce-size: build
+	$(eval DEBOUNCE_SIZE=$(shell $(NM) -S -t d $(BUILD_DIR)/$(TARGET).elf | $(AWK) '$$3 ~ /^[bBdD]$$/ && $$4 ~ /^debounce_/ {total += $$2} END {print total + 0}'))
+	printf "Debounce RAM usage ($(strip $(DEBOUNCE_TYPE))): $(DEBOUNCE_SIZE) bytes\n"
+endif
+
 include $(BUILDDEFS_PATH)/show_options.mk
 include $(BUILDDEFS_PATH)/common_rules.mk
 
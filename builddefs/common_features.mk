@@ -78,6 +78,12 @@ ifeq ($(strip $(SEQUENCER_ENABLE)), yes)
     MUSIC_ENABLE = yes
 endif
 
+ifeq ($(strip $(SEND_STRING_ASYNC_ENABLE)), yes)
+    SEND_STRING_ENABLE = yes
+    OPT_DEFS += -DSEND_STRING_ASYNC_ENABLE
+    SRC += $(QUANTUM_DIR)/send_string/send_string_async.c
+endif
+
 ifeq ($(strip $(MIDI_ENABLE)), yes)
     OPT_DEFS += -DMIDI_ENABLE
     MUSIC_ENABLE = yes
@@ -131,6 +137,7 @@ ifeq ($(strip $(POINTING_DEVICE_ENABLE)), yes)
         SRC += $(QUANTUM_DIR)/pointing_device/pointing_device.c
         SRC += $(QUANTUM_DIR)/pointing_device/pointing_device_drivers.c
         SRC += $(QUANTUM_DIR)/pointing_device/pointing_device_auto_mouse.c
+        SRC += $(QUANTUM_DIR)/pointing_device/pointing_device_subpixel.c
         ifneq ($(strip $(POINTING_DEVICE_DRIVER)), custom)
             SRC += drivers/sensors/$(strip $(POINTING_DEVICE_DRIVER)).c
             OPT_DEFS += -DPOINTING_DEVICE_DRIVER_$(strip $(shell echo $(POINTING_DEVICE_DRIVER) | tr '[:lower:]' '[:upper:]'))
@@ -372,66 +379,77 @@ ifeq ($(strip $(LED_MATRIX_ENABLE)), yes)
 
     ifeq ($(strip $(LED_MATRIX_DRIVER)), is31fl3729)
         I2C_DRIVER_REQUIRED = yes
+        LED_I2C_FLUSH_REQUIRED = yes
         COMMON_VPATH += $(DRIVER_PATH)/led/issi
         SRC += is31fl3729-mono.c
     endif
 
     ifeq ($(strip $(LED_MATRIX_DRIVER)), is31fl3731)
         I2C_DRIVER_REQUIRED = yes
+        LED_I2C_FLUSH_REQUIRED = yes
         COMMON_VPATH += $(DRIVER_PATH)/led/issi
         SRC += is31fl3731-mono.c
     endif
 
     ifeq ($(strip $(LED_MATRIX_DRIVER)), is31fl3733)
         I2C_DRIVER_REQUIRED = yes
+        LED_I2C_FLUSH_REQUIRED = yes
         COMMON_VPATH += $(DRIVER_PATH)/led/issi
         SRC += is31fl3733-mono.c
     endif
 
     ifeq ($(strip $(LED_MATRIX_DRIVER)), is31fl3736)
         I2C_DRIVER_REQUIRED = yes
+        LED_I2C_FLUSH_REQUIRED = yes
         COMMON_VPATH += $(DRIVER_PATH)/led/issi
         SRC += is31fl3736-mono.c
     endif
 
     ifeq ($(strip $(LED_MATRIX_DRIVER)), is31fl3737)
         I2C_DRIVER_REQUIRED = yes
+        LED_I2C_FLUSH_REQUIRED = yes
         COMMON_VPATH += $(DRIVER_PATH)/led/issi
         SRC += is31fl3737-mono.c
     endif
 
     ifeq ($(strip $(LED_MATRIX_DRIVER)), is31fl3741)
         I2C_DRIVER_REQUIRED = yes
+        LED_I2C_FLUSH_REQUIRED = yes
         COMMON_VPATH += $(DRIVER_PATH)/led/issi
         SRC += is31fl3741-mono.c
     endif
 
     ifeq ($(strip $(LED_MATRIX_DRIVER)), is31fl3742a)
         I2C_DRIVER_REQUIRED = yes
+        LED_I2C_FLUSH_REQUIRED = yes
         COMMON_VPATH += $(DRIVER_PATH)/led/issi
         SRC += is31fl3742a-mono.c
     endif
 
     ifeq ($(strip $(LED_MATRIX_DRIVER)), is31fl3743a)
         I2C_DRIVER_REQUIRED = yes
+        LED_I2C_FLUSH_REQUIRED = yes
         COMMON_VPATH += $(DRIVER_PATH)/led/issi
         SRC += is31fl3743a-mono.c
     endif
 
     ifeq ($(strip $(LED_MATRIX_DRIVER)), is31fl3745)
         I2C_DRIVER_REQUIRED = yes
+        LED_I2C_FLUSH_REQUIRED = yes
         COMMON_VPATH += $(DRIVER_PATH)/led/issi
         SRC += is31fl3745-mono.c
     endif
 
     ifeq ($(strip $(LED_MATRIX_DRIVER)), is31fl3746a)
         I2C_DRIVER_REQUIRED = yes
+        LED_I2C_FLUSH_REQUIRED = yes
         COMMON_VPATH += $(DRIVER_PATH)/led/issi
         SRC += is31fl3746a-mono.c
     endif
 
     ifeq ($(strip $(LED_MATRIX_DRIVER)), snled27351)
         I2C_DRIVER_REQUIRED = yes
+        LED_I2C_FLUSH_REQUIRED = yes
         COMMON_VPATH += $(DRIVER_PATH)/led
         SRC += snled27351-mono.c
     endif
@@ -487,66 +505,77 @@ ifeq ($(strip $(RGB_MATRIX_ENABLE)), yes)
 
     ifeq ($(strip $(RGB_MATRIX_DRIVER)), is31fl3729)
         I2C_DRIVER_REQUIRED = yes
+        LED_I2C_FLUSH_REQUIRED = yes
         COMMON_VPATH += $(DRIVER_PATH)/led/issi
         SRC += is31fl3729.c
     endif
 
     ifeq ($(strip $(RGB_MATRIX_DRIVER)), is31fl3731)
         I2C_DRIVER_REQUIRED = yes
+        LED_I2C_FLUSH_REQUIRED = yes
         COMMON_VPATH += $(DRIVER_PATH)/led/issi
         SRC += is31fl3731.c
     endif
 
     ifeq ($(strip $(RGB_MATRIX_DRIVER)), is31fl3733)
         I2C_DRIVER_REQUIRED = yes
+        LED_I2C_FLUSH_REQUIRED = yes
         COMMON_VPATH += $(DRIVER_PATH)/led/issi
         SRC += is31fl3733.c
     endif
 
     ifeq ($(strip $(RGB_MATRIX_DRIVER)), is31fl3736)
         I2C_DRIVER_REQUIRED = yes
+        LED_I2C_FLUSH_REQUIRED = yes
         COMMON_VPATH += $(DRIVER_PATH)/led/issi
         SRC += is31fl3736.c
     endif
 
     ifeq ($(strip $(RGB_MATRIX_DRIVER)), is31fl3737)
         I2C_DRIVER_REQUIRED = yes
+        LED_I2C_FLUSH_REQUIRED = yes
         COMMON_VPATH += $(DRIVER_PATH)/led/issi
         SRC += is31fl3737.c
     endif
 
     ifeq ($(strip $(RGB_MATRIX_DRIVER)), is31fl3741)
         I2C_DRIVER_REQUIRED = yes
+        LED_I2C_FLUSH_REQUIRED = yes
         COMMON_VPATH += $(DRIVER_PATH)/led/issi
         SRC += is31fl3741.c
     endif
 
     ifeq ($(strip $(RGB_MATRIX_DRIVER)), is31fl3742a)
         I2C_DRIVER_REQUIRED = yes
+        LED_I2C_FLUSH_REQUIRED = yes
         COMMON_VPATH += $(DRIVER_PATH)/led/issi
         SRC += is31fl3742a.c
     endif
 
     ifeq ($(strip $(RGB_MATRIX_DRIVER)), is31fl3743a)
         I2C_DRIVER_REQUIRED = yes
+        LED_I2C_FLUSH_REQUIRED = yes
         COMMON_VPATH += $(DRIVER_PATH)/led/issi
         SRC += is31fl3743a.c
     endif
 
     ifeq ($(strip $(RGB_MATRIX_DRIVER)), is31fl3745)
         I2C_DRIVER_REQUIRED = yes
+        LED_I2C_FLUSH_REQUIRED = yes
         COMMON_VPATH += $(DRIVER_PATH)/led/issi
         SRC += is31fl3745.c
     endif
 
     ifeq ($(strip $(RGB_MATRIX_DRIVER)), is31fl3746a)
         I2C_DRIVER_REQUIRED = yes
+        LED_I2C_FLUSH_REQUIRED = yes
         COMMON_VPATH += $(DRIVER_PATH)/led/issi
         SRC += is31fl3746a.c
     endif
 
     ifeq ($(strip $(RGB_MATRIX_DRIVER)), snled27351)
         I2C_DRIVER_REQUIRED = yes
+        LED_I2C_FLUSH_REQUIRED = yes
         COMMON_VPATH += $(DRIVER_PATH)/led
         SRC += snled27351.c
     endif
@@ -649,6 +678,20 @@ ifneq ($(strip $(CUSTOM_MATRIX)), yes)
     endif
 endif
 
+ifeq ($(strip $(MATRIX_WAKEUP_ENABLE)), yes)
+    OPT_DEFS += -DMATRIX_WAKEUP_ENABLE
+    QUANTUM_SRC += $(QUANTUM_DIR)/matrix_wakeup.c
+    # Platforms without pin change interrupt support fall back to continuous scanning
+    SRC += $(wildcard $(PLATFORM_PATH)/$(PLATFORM_KEY)/matrix_wakeup.c)
+endif
+
+ifeq ($(strip $(MATRIX_SCAN_THREAD_ENABLE)), yes)
+    OPT_DEFS += -DMATRIX_SCAN_THREAD_ENABLE
+    QUANTUM_SRC += $(QUANTUM_DIR)/matrix_scan_thread.c
+    # Platforms without thread support scan from keyboard_task()
+    SRC += $(wildcard $(PLATFORM_PATH)/$(PLATFORM_KEY)/matrix_scan_thread.c)
+endif
+
 # Debounce Modules. Set DEBOUNCE_TYPE=custom if including one manually.
 DEBOUNCE_TYPE ?= sym_defer_g
 ifneq ($(strip $(DEBOUNCE_TYPE)), custom)
@@ -674,7 +717,8 @@ ifeq ($(strip $(SPLIT_KEYBOARD)), yes)
     # Determine which (if any) transport files are required
     ifneq ($(strip $(SPLIT_TRANSPORT)), custom)
         QUANTUM_SRC += $(QUANTUM_DIR)/split_common/transport.c \
-                       $(QUANTUM_DIR)/split_common/transactions.c
+                       $(QUANTUM_DIR)/split_common/transactions.c \
+                       $(QUANTUM_DIR)/split_common/split_delta.c
 
         OPT_DEFS += -DSPLIT_COMMON_TRANSACTIONS
 
@@ -960,6 +1004,13 @@ ifeq ($(strip $(ANALOG_DRIVER_REQUIRED)), yes)
     QUANTUM_LIB_SRC += analog.c
 endif
 
+ifeq ($(strip $(LED_I2C_FLUSH_REQUIRED)), yes)
+    COMMON_VPATH += $(DRIVER_PATH)/led
+    SRC += led_i2c_flush.c
+    # Platforms without thread support always write synchronously
+    SRC += $(wildcard $(PLATFORM_PATH)/$(PLATFORM_KEY)/$(DRIVER_DIR)/led_i2c_flush_thread.c)
+endif
+
 ifeq ($(strip $(I2C_DRIVER_REQUIRED)), yes)
     OPT_DEFS += -DHAL_USE_I2C=TRUE
     QUANTUM_LIB_SRC += i2c_master.c
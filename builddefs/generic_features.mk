@@ -36,6 +36,7 @@ GENERIC_FEATURES = \
     HAPTIC \
     KEY_LOCK \
     KEY_OVERRIDE \
+    LATENCY_TRACE \
     LEADER \
     MAGIC \
     MOUSEKEY \
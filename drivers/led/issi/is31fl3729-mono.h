@@ -51,6 +51,12 @@
 #    define IS31FL3729_DRIVER_COUNT 1
 #endif
 
+#define IS31FL3729_PWM_REGISTER_COUNT 143
+#define IS31FL3729_PWM_TRANSFER_SIZE 13
+
+// Writes queued by a PWM update of every driver, used to size the LED_I2C_FLUSH_ASYNC queue
+#define IS31FL3729_I2C_FLUSH_WRITE_COUNT (IS31FL3729_DRIVER_COUNT * CEILING(IS31FL3729_PWM_REGISTER_COUNT, IS31FL3729_PWM_TRANSFER_SIZE))
+
 typedef struct is31fl3729_led_t {
     uint8_t driver : 2;
     uint8_t v;
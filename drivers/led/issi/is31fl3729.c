@@ -18,10 +18,10 @@
 
 #include "is31fl3729.h"
 #include "i2c_master.h"
+#include "led_i2c_flush.h"
 #include "gpio.h"
 #include "wait.h"
 
-#define IS31FL3729_PWM_REGISTER_COUNT 143
 #define IS31FL3729_SCALING_REGISTER_COUNT 16
 
 #ifndef IS31FL3729_I2C_TIMEOUT
@@ -80,42 +80,26 @@ const uint8_t i2c_addresses[IS31FL3729_DRIVER_COUNT] = {
 // These buffers match the PWM & scaling registers.
 // Storing them like this is optimal for I2C transfers to the registers.
 typedef struct is31fl3729_driver_t {
-    uint8_t pwm_buffer[IS31FL3729_PWM_REGISTER_COUNT];
-    bool    pwm_buffer_dirty;
-    uint8_t scaling_buffer[IS31FL3729_SCALING_REGISTER_COUNT];
-    bool    scaling_buffer_dirty;
+    uint8_t         pwm_buffer[IS31FL3729_PWM_REGISTER_COUNT];
+    led_i2c_dirty_t pwm_buffer_dirty;
+    uint8_t         scaling_buffer[IS31FL3729_SCALING_REGISTER_COUNT];
+    bool            scaling_buffer_dirty;
 } PACKED is31fl3729_driver_t;
 
 is31fl3729_driver_t driver_buffers[IS31FL3729_DRIVER_COUNT] = {{
     .pwm_buffer           = {0},
-    .pwm_buffer_dirty     = false,
+    .pwm_buffer_dirty     = 0,
     .scaling_buffer       = {0},
     .scaling_buffer_dirty = false,
 }};
 
 void is31fl3729_write_register(uint8_t index, uint8_t reg, uint8_t data) {
-#if IS31FL3729_I2C_PERSISTENCE > 0
-    for (uint8_t i = 0; i < IS31FL3729_I2C_PERSISTENCE; i++) {
-        if (i2c_write_register(i2c_addresses[index] << 1, reg, &data, 1, IS31FL3729_I2C_TIMEOUT) == I2C_STATUS_SUCCESS) break;
-    }
-#else
-    i2c_write_register(i2c_addresses[index] << 1, reg, &data, 1, IS31FL3729_I2C_TIMEOUT);
-#endif
+    led_i2c_write_register(i2c_addresses[index] << 1, reg, data, IS31FL3729_I2C_TIMEOUT, IS31FL3729_I2C_PERSISTENCE);
 }
 
 void is31fl3729_write_pwm_buffer(uint8_t index) {
-    // Transmit PWM registers in 11 transfers of 13 bytes.
-
-    // Iterate over the pwm_buffer contents at 13 byte intervals.
-    for (uint8_t i = 0; i <= IS31FL3729_PWM_REGISTER_COUNT; i += 13) {
-#if IS31FL3729_I2C_PERSISTENCE > 0
-        for (uint8_t j = 0; j < IS31FL3729_I2C_PERSISTENCE; j++) {
-            if (i2c_write_register(i2c_addresses[index] << 1, IS31FL3729_REG_PWM + i, driver_buffers[index].pwm_buffer + i, 13, IS31FL3729_I2C_TIMEOUT) == I2C_STATUS_SUCCESS) break;
-        }
-#else
-        i2c_write_register(i2c_addresses[index] << 1, IS31FL3729_REG_PWM + i, driver_buffers[index].pwm_buffer + i, 13, IS31FL3729_I2C_TIMEOUT);
-#endif
-    }
+    // Transmit the changed PWM registers, in transfers of 13 bytes.
+    led_i2c_write_chunks(i2c_addresses[index] << 1, IS31FL3729_REG_PWM, driver_buffers[index].pwm_buffer, IS31FL3729_PWM_REGISTER_COUNT, IS31FL3729_PWM_TRANSFER_SIZE, driver_buffers[index].pwm_buffer_dirty, IS31FL3729_I2C_TIMEOUT, IS31FL3729_I2C_PERSISTENCE);
 }
 
 void is31fl3729_init_drivers(void) {
@@ -152,6 +136,7 @@ void is31fl3729_init(uint8_t index) {
     is31fl3729_write_register(index, IS31FL3729_REG_CONFIGURATION, IS31FL3729_CONFIGURATION);
 
     // Wait 10ms to ensure the device has woken up.
+    led_i2c_flush_wait();
     wait_ms(10);
 }
 
@@ -167,7 +152,9 @@ void is31fl3729_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
         driver_buffers[led.driver].pwm_buffer[led.r] = red;
         driver_buffers[led.driver].pwm_buffer[led.g] = green;
         driver_buffers[led.driver].pwm_buffer[led.b] = blue;
-        driver_buffers[led.driver].pwm_buffer_dirty  = true;
+        driver_buffers[led.driver].pwm_buffer_dirty |= led_i2c_chunk_bit(led.r, IS31FL3729_PWM_TRANSFER_SIZE);
+        driver_buffers[led.driver].pwm_buffer_dirty |= led_i2c_chunk_bit(led.g, IS31FL3729_PWM_TRANSFER_SIZE);
+        driver_buffers[led.driver].pwm_buffer_dirty |= led_i2c_chunk_bit(led.b, IS31FL3729_PWM_TRANSFER_SIZE);
     }
 }
 
@@ -198,7 +185,7 @@ void is31fl3729_update_pwm_buffers(uint8_t index) {
     if (driver_buffers[index].pwm_buffer_dirty) {
         is31fl3729_write_pwm_buffer(index);
 
-        driver_buffers[index].pwm_buffer_dirty = false;
+        driver_buffers[index].pwm_buffer_dirty = 0;
     }
 }
 
@@ -18,10 +18,10 @@
 
 #include "is31fl3731.h"
 #include "i2c_master.h"
+#include "led_i2c_flush.h"
 #include "gpio.h"
 #include "wait.h"
 
-#define IS31FL3731_PWM_REGISTER_COUNT 144
 #define IS31FL3731_LED_CONTROL_REGISTER_COUNT 18
 
 #ifndef IS31FL3731_I2C_TIMEOUT
@@ -51,27 +51,21 @@ const uint8_t i2c_addresses[IS31FL3731_DRIVER_COUNT] = {
 // buffers and the transfers in is31fl3731_write_pwm_buffer() but it's
 // probably not worth the extra complexity.
 typedef struct is31fl3731_driver_t {
-    uint8_t pwm_buffer[IS31FL3731_PWM_REGISTER_COUNT];
-    bool    pwm_buffer_dirty;
-    uint8_t led_control_buffer[IS31FL3731_LED_CONTROL_REGISTER_COUNT];
-    bool    led_control_buffer_dirty;
+    uint8_t         pwm_buffer[IS31FL3731_PWM_REGISTER_COUNT];
+    led_i2c_dirty_t pwm_buffer_dirty;
+    uint8_t         led_control_buffer[IS31FL3731_LED_CONTROL_REGISTER_COUNT];
+    bool            led_control_buffer_dirty;
 } PACKED is31fl3731_driver_t;
 
 is31fl3731_driver_t driver_buffers[IS31FL3731_DRIVER_COUNT] = {{
     .pwm_buffer               = {0},
-    .pwm_buffer_dirty         = false,
+    .pwm_buffer_dirty         = 0,
     .led_control_buffer       = {0},
     .led_control_buffer_dirty = false,
 }};
 
 void is31fl3731_write_register(uint8_t index, uint8_t reg, uint8_t data) {
-#if IS31FL3731_I2C_PERSISTENCE > 0
-    for (uint8_t i = 0; i < IS31FL3731_I2C_PERSISTENCE; i++) {
-        if (i2c_write_register(i2c_addresses[index] << 1, reg, &data, 1, IS31FL3731_I2C_TIMEOUT) == I2C_STATUS_SUCCESS) break;
-    }
-#else
-    i2c_write_register(i2c_addresses[index] << 1, reg, &data, 1, IS31FL3731_I2C_TIMEOUT);
-#endif
+    led_i2c_write_register(i2c_addresses[index] << 1, reg, data, IS31FL3731_I2C_TIMEOUT, IS31FL3731_I2C_PERSISTENCE);
 }
 
 void is31fl3731_select_page(uint8_t index, uint8_t page) {
@@ -80,18 +74,8 @@ void is31fl3731_select_page(uint8_t index, uint8_t page) {
 
 void is31fl3731_write_pwm_buffer(uint8_t index) {
     // Assumes page 0 is already selected.
-    // Transmit PWM registers in 9 transfers of 16 bytes.
-
-    // Iterate over the pwm_buffer contents at 16 byte intervals.
-    for (uint8_t i = 0; i < IS31FL3731_PWM_REGISTER_COUNT; i += 16) {
-#if IS31FL3731_I2C_PERSISTENCE > 0
-        for (uint8_t j = 0; j < IS31FL3731_I2C_PERSISTENCE; j++) {
-            if (i2c_write_register(i2c_addresses[index] << 1, IS31FL3731_FRAME_REG_PWM + i, driver_buffers[index].pwm_buffer + i, 16, IS31FL3731_I2C_TIMEOUT) == I2C_STATUS_SUCCESS) break;
-        }
-#else
-        i2c_write_register(i2c_addresses[index] << 1, IS31FL3731_FRAME_REG_PWM + i, driver_buffers[index].pwm_buffer + i, 16, IS31FL3731_I2C_TIMEOUT);
-#endif
-    }
+    // Transmit the changed PWM registers, in transfers of 16 bytes.
+    led_i2c_write_chunks(i2c_addresses[index] << 1, IS31FL3731_FRAME_REG_PWM, driver_buffers[index].pwm_buffer, IS31FL3731_PWM_REGISTER_COUNT, IS31FL3731_PWM_TRANSFER_SIZE, driver_buffers[index].pwm_buffer_dirty, IS31FL3731_I2C_TIMEOUT, IS31FL3731_I2C_PERSISTENCE);
 }
 
 void is31fl3731_init_drivers(void) {
@@ -130,6 +114,7 @@ void is31fl3731_init(uint8_t index) {
 #endif
 
     // this delay was copied from other drivers, might not be needed
+    led_i2c_flush_wait();
     wait_ms(10);
 
     // picture mode
@@ -180,7 +165,9 @@ void is31fl3731_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
         driver_buffers[led.driver].pwm_buffer[led.r] = red;
         driver_buffers[led.driver].pwm_buffer[led.g] = green;
         driver_buffers[led.driver].pwm_buffer[led.b] = blue;
-        driver_buffers[led.driver].pwm_buffer_dirty  = true;
+        driver_buffers[led.driver].pwm_buffer_dirty |= led_i2c_chunk_bit(led.r, IS31FL3731_PWM_TRANSFER_SIZE);
+        driver_buffers[led.driver].pwm_buffer_dirty |= led_i2c_chunk_bit(led.g, IS31FL3731_PWM_TRANSFER_SIZE);
+        driver_buffers[led.driver].pwm_buffer_dirty |= led_i2c_chunk_bit(led.b, IS31FL3731_PWM_TRANSFER_SIZE);
     }
 }
 
@@ -224,7 +211,7 @@ void is31fl3731_update_pwm_buffers(uint8_t index) {
     if (driver_buffers[index].pwm_buffer_dirty) {
         is31fl3731_write_pwm_buffer(index);
 
-        driver_buffers[index].pwm_buffer_dirty = false;
+        driver_buffers[index].pwm_buffer_dirty = 0;
     }
 }
 
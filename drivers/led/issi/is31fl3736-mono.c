@@ -17,10 +17,10 @@
 
 #include "is31fl3736-mono.h"
 #include "i2c_master.h"
+#include "led_i2c_flush.h"
 #include "gpio.h"
 #include "wait.h"
 
-#define IS31FL3736_PWM_REGISTER_COUNT 192 // actually 96
 #define IS31FL3736_LED_CONTROL_REGISTER_COUNT 24
 
 #ifndef IS31FL3736_I2C_TIMEOUT
@@ -67,27 +67,21 @@ const uint8_t i2c_addresses[IS31FL3736_DRIVER_COUNT] = {
 // buffers and the transfers in is31fl3736_write_pwm_buffer() but it's
 // probably not worth the extra complexity.
 typedef struct is31fl3736_driver_t {
-    uint8_t pwm_buffer[IS31FL3736_PWM_REGISTER_COUNT];
-    bool    pwm_buffer_dirty;
-    uint8_t led_control_buffer[IS31FL3736_LED_CONTROL_REGISTER_COUNT];
-    bool    led_control_buffer_dirty;
+    uint8_t         pwm_buffer[IS31FL3736_PWM_REGISTER_COUNT];
+    led_i2c_dirty_t pwm_buffer_dirty;
+    uint8_t         led_control_buffer[IS31FL3736_LED_CONTROL_REGISTER_COUNT];
+    bool            led_control_buffer_dirty;
 } PACKED is31fl3736_driver_t;
 
 is31fl3736_driver_t driver_buffers[IS31FL3736_DRIVER_COUNT] = {{
     .pwm_buffer               = {0},
-    .pwm_buffer_dirty         = false,
+    .pwm_buffer_dirty         = 0,
     .led_control_buffer       = {0},
     .led_control_buffer_dirty = false,
 }};
 
 void is31fl3736_write_register(uint8_t index, uint8_t reg, uint8_t data) {
-#if IS31FL3736_I2C_PERSISTENCE > 0
-    for (uint8_t i = 0; i < IS31FL3736_I2C_PERSISTENCE; i++) {
-        if (i2c_write_register(i2c_addresses[index] << 1, reg, &data, 1, IS31FL3736_I2C_TIMEOUT) == I2C_STATUS_SUCCESS) break;
-    }
-#else
-    i2c_write_register(i2c_addresses[index] << 1, reg, &data, 1, IS31FL3736_I2C_TIMEOUT);
-#endif
+    led_i2c_write_register(i2c_addresses[index] << 1, reg, data, IS31FL3736_I2C_TIMEOUT, IS31FL3736_I2C_PERSISTENCE);
 }
 
 void is31fl3736_select_page(uint8_t index, uint8_t page) {
@@ -97,18 +91,8 @@ void is31fl3736_select_page(uint8_t index, uint8_t page) {
 
 void is31fl3736_write_pwm_buffer(uint8_t index) {
     // Assumes page 1 is already selected.
-    // Transmit PWM registers in 12 transfers of 16 bytes.
-
-    // Iterate over the pwm_buffer contents at 16 byte intervals.
-    for (uint8_t i = 0; i < IS31FL3736_PWM_REGISTER_COUNT; i += 16) {
-#if IS31FL3736_I2C_PERSISTENCE > 0
-        for (uint8_t j = 0; j < IS31FL3736_I2C_PERSISTENCE; j++) {
-            if (i2c_write_register(i2c_addresses[index] << 1, i, driver_buffers[index].pwm_buffer + i, 16, IS31FL3736_I2C_TIMEOUT) == I2C_STATUS_SUCCESS) break;
-        }
-#else
-        i2c_write_register(i2c_addresses[index] << 1, i, driver_buffers[index].pwm_buffer + i, 16, IS31FL3736_I2C_TIMEOUT);
-#endif
-    }
+    // Transmit the changed PWM registers, in transfers of 16 bytes.
+    led_i2c_write_chunks(i2c_addresses[index] << 1, 0, driver_buffers[index].pwm_buffer, IS31FL3736_PWM_REGISTER_COUNT, IS31FL3736_PWM_TRANSFER_SIZE, driver_buffers[index].pwm_buffer_dirty, IS31FL3736_I2C_TIMEOUT, IS31FL3736_I2C_PERSISTENCE);
 }
 
 void is31fl3736_init_drivers(void) {
@@ -165,6 +149,7 @@ void is31fl3736_init(uint8_t index) {
     is31fl3736_write_register(index, IS31FL3736_FUNCTION_REG_CONFIGURATION, ((IS31FL3736_PWM_FREQUENCY & 0b111) << 3) | 0x01);
 
     // Wait 10ms to ensure the device has woken up.
+    led_i2c_flush_wait();
     wait_ms(10);
 }
 
@@ -179,7 +164,7 @@ void is31fl3736_set_value(int index, uint8_t value) {
         }
 
         driver_buffers[led.driver].pwm_buffer[led.v] = value;
-        driver_buffers[led.driver].pwm_buffer_dirty  = true;
+        driver_buffers[led.driver].pwm_buffer_dirty |= led_i2c_chunk_bit(led.v, IS31FL3736_PWM_TRANSFER_SIZE);
     }
 }
 
@@ -217,7 +202,7 @@ void is31fl3736_update_pwm_buffers(uint8_t index) {
 
         is31fl3736_write_pwm_buffer(index);
 
-        driver_buffers[index].pwm_buffer_dirty = false;
+        driver_buffers[index].pwm_buffer_dirty = 0;
     }
 }
 
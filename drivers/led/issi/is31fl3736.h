@@ -114,6 +114,12 @@
 #    define IS31FL3736_DRIVER_COUNT 1
 #endif
 
+#define IS31FL3736_PWM_REGISTER_COUNT 192 // actually 96
+#define IS31FL3736_PWM_TRANSFER_SIZE 16
+
+// Writes queued by a PWM update of every driver, used to size the LED_I2C_FLUSH_ASYNC queue
+#define IS31FL3736_I2C_FLUSH_WRITE_COUNT (IS31FL3736_DRIVER_COUNT * (2 + CEILING(IS31FL3736_PWM_REGISTER_COUNT, IS31FL3736_PWM_TRANSFER_SIZE)))
+
 typedef struct is31fl3736_led_t {
     uint8_t driver : 2;
     uint8_t r;
@@ -94,6 +94,14 @@
 #    define IS31FL3741_DRIVER_COUNT 1
 #endif
 
+#define IS31FL3741_PWM_0_REGISTER_COUNT 180
+#define IS31FL3741_PWM_1_REGISTER_COUNT 171
+#define IS31FL3741_PWM_0_TRANSFER_SIZE 30
+#define IS31FL3741_PWM_1_TRANSFER_SIZE 19
+
+// Writes queued by a PWM update of every driver, used to size the LED_I2C_FLUSH_ASYNC queue
+#define IS31FL3741_I2C_FLUSH_WRITE_COUNT (IS31FL3741_DRIVER_COUNT * (4 + CEILING(IS31FL3741_PWM_0_REGISTER_COUNT, IS31FL3741_PWM_0_TRANSFER_SIZE) + CEILING(IS31FL3741_PWM_1_REGISTER_COUNT, IS31FL3741_PWM_1_TRANSFER_SIZE)))
+
 typedef struct is31fl3741_led_t {
     uint8_t  driver : 2;
     uint16_t v : 9;
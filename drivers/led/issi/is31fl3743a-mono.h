@@ -74,6 +74,12 @@
 #    define IS31FL3743A_DRIVER_COUNT 1
 #endif
 
+#define IS31FL3743A_PWM_REGISTER_COUNT 198
+#define IS31FL3743A_PWM_TRANSFER_SIZE 18
+
+// Writes queued by a PWM update of every driver, used to size the LED_I2C_FLUSH_ASYNC queue
+#define IS31FL3743A_I2C_FLUSH_WRITE_COUNT (IS31FL3743A_DRIVER_COUNT * (2 + CEILING(IS31FL3743A_PWM_REGISTER_COUNT, IS31FL3743A_PWM_TRANSFER_SIZE)))
+
 typedef struct is31fl3743a_led_t {
     uint8_t driver : 2;
     uint8_t v;
@@ -20,10 +20,10 @@
 
 #include "is31fl3746a-mono.h"
 #include "i2c_master.h"
+#include "led_i2c_flush.h"
 #include "gpio.h"
 #include "wait.h"
 
-#define IS31FL3746A_PWM_REGISTER_COUNT 72
 #define IS31FL3746A_SCALING_REGISTER_COUNT 72
 
 #ifndef IS31FL3746A_I2C_TIMEOUT
@@ -68,27 +68,21 @@ const uint8_t i2c_addresses[IS31FL3746A_DRIVER_COUNT] = {
 };
 
 typedef struct is31fl3746a_driver_t {
-    uint8_t pwm_buffer[IS31FL3746A_PWM_REGISTER_COUNT];
-    bool    pwm_buffer_dirty;
-    uint8_t scaling_buffer[IS31FL3746A_SCALING_REGISTER_COUNT];
-    bool    scaling_buffer_dirty;
+    uint8_t         pwm_buffer[IS31FL3746A_PWM_REGISTER_COUNT];
+    led_i2c_dirty_t pwm_buffer_dirty;
+    uint8_t         scaling_buffer[IS31FL3746A_SCALING_REGISTER_COUNT];
+    bool            scaling_buffer_dirty;
 } PACKED is31fl3746a_driver_t;
 
 is31fl3746a_driver_t driver_buffers[IS31FL3746A_DRIVER_COUNT] = {{
     .pwm_buffer           = {0},
-    .pwm_buffer_dirty     = false,
+    .pwm_buffer_dirty     = 0,
     .scaling_buffer       = {0},
     .scaling_buffer_dirty = false,
 }};
 
 void is31fl3746a_write_register(uint8_t index, uint8_t reg, uint8_t data) {
-#if IS31FL3746A_I2C_PERSISTENCE > 0
-    for (uint8_t i = 0; i < IS31FL3746A_I2C_PERSISTENCE; i++) {
-        if (i2c_write_register(i2c_addresses[index] << 1, reg, &data, 1, IS31FL3746A_I2C_TIMEOUT) == I2C_STATUS_SUCCESS) break;
-    }
-#else
-    i2c_write_register(i2c_addresses[index] << 1, reg, &data, 1, IS31FL3746A_I2C_TIMEOUT);
-#endif
+    led_i2c_write_register(i2c_addresses[index] << 1, reg, data, IS31FL3746A_I2C_TIMEOUT, IS31FL3746A_I2C_PERSISTENCE);
 }
 
 void is31fl3746a_select_page(uint8_t index, uint8_t page) {
@@ -98,18 +92,8 @@ void is31fl3746a_select_page(uint8_t index, uint8_t page) {
 
 void is31fl3746a_write_pwm_buffer(uint8_t index) {
     // Assumes page 0 is already selected.
-    // Transmit PWM registers in 4 transfers of 18 bytes.
-
-    // Iterate over the pwm_buffer contents at 18 byte intervals.
-    for (uint8_t i = 0; i < IS31FL3746A_PWM_REGISTER_COUNT; i += 18) {
-#if IS31FL3746A_I2C_PERSISTENCE > 0
-        for (uint8_t j = 0; j < IS31FL3746A_I2C_PERSISTENCE; j++) {
-            if (i2c_write_register(i2c_addresses[index] << 1, i + 1, driver_buffers[index].pwm_buffer + i, 18, IS31FL3746A_I2C_TIMEOUT) == I2C_STATUS_SUCCESS) break;
-        }
-#else
-        i2c_write_register(i2c_addresses[index] << 1, i + 1, driver_buffers[index].pwm_buffer + i, 18, IS31FL3746A_I2C_TIMEOUT);
-#endif
-    }
+    // Transmit the changed PWM registers, in transfers of 18 bytes.
+    led_i2c_write_chunks(i2c_addresses[index] << 1, 1, driver_buffers[index].pwm_buffer, IS31FL3746A_PWM_REGISTER_COUNT, IS31FL3746A_PWM_TRANSFER_SIZE, driver_buffers[index].pwm_buffer_dirty, IS31FL3746A_I2C_TIMEOUT, IS31FL3746A_I2C_PERSISTENCE);
 }
 
 void is31fl3746a_init_drivers(void) {
@@ -161,6 +145,7 @@ void is31fl3746a_init(uint8_t index) {
     is31fl3746a_write_register(index, IS31FL3746A_FUNCTION_REG_CONFIGURATION, IS31FL3746A_CONFIGURATION);
 
     // Wait 10ms to ensure the device has woken up.
+    led_i2c_flush_wait();
     wait_ms(10);
 }
 
@@ -175,7 +160,7 @@ void is31fl3746a_set_value(int index, uint8_t value) {
         }
 
         driver_buffers[led.driver].pwm_buffer[led.v] = value;
-        driver_buffers[led.driver].pwm_buffer_dirty  = true;
+        driver_buffers[led.driver].pwm_buffer_dirty |= led_i2c_chunk_bit(led.v, IS31FL3746A_PWM_TRANSFER_SIZE);
     }
 }
 
@@ -199,7 +184,7 @@ void is31fl3746a_update_pwm_buffers(uint8_t index) {
 
         is31fl3746a_write_pwm_buffer(index);
 
-        driver_buffers[index].pwm_buffer_dirty = false;
+        driver_buffers[index].pwm_buffer_dirty = 0;
     }
 }
 
@@ -0,0 +1,69 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <stddef.h>
+
+#include "led_i2c_flush.h"
+#include "i2c_master.h"
+
+__attribute__((weak)) bool led_i2c_flush_queue(const led_i2c_write_t *write) {
+    return false;
+}
+
+__attribute__((weak)) void led_i2c_flush_queue_wait(void) {}
+
+void led_i2c_flush_perform(const led_i2c_write_t *write) {
+    const uint8_t *data   = write->data ? write->data : &write->value;
+    uint8_t        length = write->data ? write->length : 1;
+    uint8_t        i      = 0;
+
+    do {
+        if (i2c_write_register(write->address, write->reg, data, length, write->timeout) == I2C_STATUS_SUCCESS) break;
+    } while (++i < write->persistence);
+}
+
+static void submit(const led_i2c_write_t *write) {
+#ifdef LED_I2C_FLUSH_ASYNC
+    if (led_i2c_flush_queue(write)) {
+        return;
+    }
+#endif
+    led_i2c_flush_perform(write);
+}
+
+void led_i2c_write_register(uint8_t address, uint8_t reg, uint8_t data, uint16_t timeout, uint8_t persistence) {
+    led_i2c_write_t write = {
+        .data        = NULL,
+        .timeout     = timeout,
+        .address     = address,
+        .reg         = reg,
+        .value       = data,
+        .persistence = persistence,
+    };
+    submit(&write);
+}
+
+void led_i2c_write_chunks(uint8_t address, uint8_t first_register, const uint8_t *buffer, uint16_t length, uint8_t chunk_size, led_i2c_dirty_t dirty, uint16_t timeout, uint8_t persistence) {
+    led_i2c_write_t write = {
+        .timeout     = timeout,
+        .address     = address,
+        .persistence = persistence,
+    };
+
+    for (uint16_t offset = 0, chunk = 0; offset < length; offset += chunk_size, chunk++) {
+        if (!(dirty & ((led_i2c_dirty_t)1 << chunk))) {
+            continue;
+        }
+
+        write.data   = buffer + offset;
+        write.reg    = first_register + offset;
+        write.length = length - offset < chunk_size ? length - offset : chunk_size;
+        submit(&write);
+    }
+}
+
+void led_i2c_flush_wait(void) {
+#ifdef LED_I2C_FLUSH_ASYNC
+    led_i2c_flush_queue_wait();
+#endif
+}
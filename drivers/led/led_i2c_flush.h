@@ -0,0 +1,95 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * \file
+ *
+ * Register writes shared by the IS31FL37xx and SNLED27351 LED drivers.
+ *
+ * The PWM buffers are tracked in chunks matching the transfers made to the
+ * driver, so a flush only sends the chunks holding LEDs that changed.
+ *
+ * With `LED_I2C_FLUSH_ASYNC` defined, writes are queued and made by a
+ * background thread on platforms that support it, so flushing returns
+ * immediately. Writes are always made in the order they were issued, and
+ * `led_i2c_flush_wait()` waits until they are all done.
+ */
+
+// Above the main loop, which never sleeps. The thread sleeps while each transfer runs, so it barely takes any CPU time.
+#ifndef LED_I2C_FLUSH_THREAD_PRIORITY
+#    define LED_I2C_FLUSH_THREAD_PRIORITY (NORMALPRIO + 1)
+#endif
+
+#ifndef LED_I2C_FLUSH_THREAD_STACK_SIZE
+#    define LED_I2C_FLUSH_THREAD_STACK_SIZE 512
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// One bit per chunk of a register buffer, set if it has to be written
+typedef uint32_t led_i2c_dirty_t;
+
+typedef struct {
+    const uint8_t *data;        // NULL for single register writes, which use value
+    uint16_t       timeout;
+    uint8_t        address;     // 8-bit I2C address
+    uint8_t        reg;
+    uint8_t        length;
+    uint8_t        value;
+    uint8_t        persistence; // attempts made, 0 for a single attempt
+} led_i2c_write_t;
+
+// The bit of the chunk holding the register at index
+static inline led_i2c_dirty_t led_i2c_chunk_bit(uint16_t index, uint8_t chunk_size) {
+    return (led_i2c_dirty_t)1 << (index / chunk_size);
+}
+
+/**
+ * \brief Write a single register.
+ */
+void led_i2c_write_register(uint8_t address, uint8_t reg, uint8_t data, uint16_t timeout, uint8_t persistence);
+
+/**
+ * \brief Write the dirty chunks of a register buffer.
+ *
+ * The buffer is read when the write is made, so it has to stay valid until
+ * then. Changes made in the meantime are sent along as well.
+ *
+ * \param first_register Register that the start of the buffer is written to.
+ */
+void led_i2c_write_chunks(uint8_t address, uint8_t first_register, const uint8_t *buffer, uint16_t length, uint8_t chunk_size, led_i2c_dirty_t dirty, uint16_t timeout, uint8_t persistence);
+
+/**
+ * \brief Wait until all queued writes are done, e.g. before a delay that has
+ * to follow them.
+ */
+void led_i2c_flush_wait(void);
+
+/**
+ * \brief Make a write, called by the platform's flush thread.
+ */
+void led_i2c_flush_perform(const led_i2c_write_t *write);
+
+/**
+ * \brief Platform hook, queue a write for the flush thread.
+ *
+ * \return false if the platform has no flush thread support, so the write has
+ * to be made straight away
+ */
+bool led_i2c_flush_queue(const led_i2c_write_t *write);
+
+/**
+ * \brief Platform hook, wait for the flush thread to finish the queued writes.
+ */
+void led_i2c_flush_queue_wait(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -158,6 +158,12 @@
 #    define SNLED27351_DRIVER_COUNT 1
 #endif
 
+#define SNLED27351_PWM_REGISTER_COUNT 192
+#define SNLED27351_PWM_TRANSFER_SIZE 16
+
+// Writes queued by a PWM update of every driver, used to size the LED_I2C_FLUSH_ASYNC queue
+#define SNLED27351_I2C_FLUSH_WRITE_COUNT (SNLED27351_DRIVER_COUNT * (1 + CEILING(SNLED27351_PWM_REGISTER_COUNT, SNLED27351_PWM_TRANSFER_SIZE)))
+
 typedef struct snled27351_led_t {
     uint8_t driver : 2;
     uint8_t r;
@@ -9,6 +9,11 @@
 #    include "gpio.h"
 #    include "qp_internal.h"
 
+// Pixel data is sent in the background where the SPI driver supports it
+#    if QUANTUM_PAINTER_PIXDATA_ASYNC && defined(PROTOCOL_CHIBIOS)
+#        define QUANTUM_PAINTER_SPI_ASYNC_ENABLE
+#    endif
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Base SPI support
 
@@ -24,6 +29,10 @@ bool     qp_comms_spi_start(painter_device_t device);
 uint32_t qp_comms_spi_send_data(painter_device_t device, const void* data, uint32_t byte_count);
 void     qp_comms_spi_stop(painter_device_t device);
 
+#    ifdef QUANTUM_PAINTER_SPI_ASYNC_ENABLE
+uint32_t qp_comms_spi_send_data_async(painter_device_t device, const void* data, uint32_t byte_count);
+#    endif // QUANTUM_PAINTER_SPI_ASYNC_ENABLE
+
 extern const painter_comms_vtable_t spi_comms_vtable;
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -41,6 +50,9 @@ typedef struct qp_comms_spi_dc_reset_config_t {
 bool     qp_comms_spi_dc_reset_init(painter_device_t device);
 void     qp_comms_spi_dc_reset_send_command(painter_device_t device, uint8_t cmd);
 uint32_t qp_comms_spi_dc_reset_send_data(painter_device_t device, const void* data, uint32_t byte_count);
+#        ifdef QUANTUM_PAINTER_SPI_ASYNC_ENABLE
+uint32_t qp_comms_spi_dc_reset_send_data_async(painter_device_t device, const void* data, uint32_t byte_count);
+#        endif // QUANTUM_PAINTER_SPI_ASYNC_ENABLE
 void     qp_comms_spi_dc_reset_bulk_command_sequence(painter_device_t device, const uint8_t* sequence, size_t sequence_len);
 
 extern const painter_comms_with_command_vtable_t spi_comms_with_dc_vtable;
@@ -21,6 +21,23 @@
 #    define SURFACE_NUM_DEVICES 1
 #endif
 
+#ifndef SURFACE_DIRTY_RECT_COUNT
+/**
+ * @def This controls the maximum number of separate dirty regions each surface keeps track of. Drawing to areas far
+ *      apart, such as opposite corners of the display, then only transfers those areas instead of everything in
+ *      between. Each region requires 8 bytes of RAM per surface.
+ */
+#    define SURFACE_DIRTY_RECT_COUNT 4
+#endif
+
+#ifndef SURFACE_DIRTY_MERGE_COST
+/**
+ * @def This controls the number of pixels that transferring a separate dirty region is considered to cost, due to the
+ *      extra viewport setup. Dirty regions are merged whenever transferring them together costs less than separately.
+ */
+#    define SURFACE_DIRTY_MERGE_COST 64
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Forward declarations
 
@@ -53,7 +70,7 @@ painter_device_t qp_make_mono1bpp_surface(uint16_t panel_width, uint16_t panel_h
 /**
  * Helper method to draw the contents of the framebuffer to the target device.
  *
- * After successful completion, the dirty area is reset.
+ * Each dirty region is transferred with its own viewport. After successful completion, the dirty area is reset.
  *
  * @param surface[in] the surface to copy from
  * @param target[in] the target device to copy into
@@ -29,6 +29,54 @@ void qp_surface_increment_pixdata_location(surface_viewport_data_t *viewport) {
     }
 }
 
+static inline uint32_t qp_surface_rect_area(const surface_dirty_rect_t *rect) {
+    return (uint32_t)(rect->r - rect->l + 1) * (uint32_t)(rect->b - rect->t + 1);
+}
+
+static inline bool qp_surface_rect_contains(const surface_dirty_rect_t *rect, uint16_t x, uint16_t y) {
+    return x >= rect->l && x <= rect->r && y >= rect->t && y <= rect->b;
+}
+
+static inline void qp_surface_rect_union(surface_dirty_rect_t *rect, const surface_dirty_rect_t *other) {
+    if (rect->l > other->l) rect->l = other->l;
+    if (rect->t > other->t) rect->t = other->t;
+    if (rect->r < other->r) rect->r = other->r;
+    if (rect->b < other->b) rect->b = other->b;
+}
+
+// Merge other rects into the given one, for as long as transferring them together costs less than separately
+static void qp_surface_merge_dirty_rects(surface_dirty_data_t *dirty, uint8_t index) {
+    bool merged;
+    do {
+        merged = false;
+        for (uint8_t i = 0; i < dirty->rect_count; ++i) {
+            if (i == index) {
+                continue;
+            }
+
+            surface_dirty_rect_t combined = dirty->rects[index];
+            qp_surface_rect_union(&combined, &dirty->rects[i]);
+            if (qp_surface_rect_area(&combined) > qp_surface_rect_area(&dirty->rects[index]) + qp_surface_rect_area(&dirty->rects[i]) + SURFACE_DIRTY_MERGE_COST) {
+                continue;
+            }
+
+            // Keep the merged rect, and move the last rect into the freed-up slot
+            dirty->rects[index] = combined;
+            dirty->rect_count--;
+            if (i != dirty->rect_count) {
+                dirty->rects[i] = dirty->rects[dirty->rect_count];
+                if (index == dirty->rect_count) {
+                    index = i;
+                }
+            }
+            merged = true;
+            break;
+        }
+    } while (merged);
+
+    dirty->last_rect = index;
+}
+
 void qp_surface_update_dirty(surface_dirty_data_t *dirty, uint16_t x, uint16_t y) {
     // Maintain dirty region
     if (dirty->l > x) {
@@ -47,6 +95,41 @@ void qp_surface_update_dirty(surface_dirty_data_t *dirty, uint16_t x, uint16_t y
         dirty->b        = y;
         dirty->is_dirty = true;
     }
+
+    // Consecutive pixels usually land in the same rect
+    if (dirty->rect_count > 0 && qp_surface_rect_contains(&dirty->rects[dirty->last_rect], x, y)) {
+        return;
+    }
+
+    // Find the rect that grows the least by including this pixel
+    surface_dirty_rect_t pixel       = {x, y, x, y};
+    uint8_t              best_rect   = 0;
+    uint32_t             best_growth = UINT32_MAX;
+    for (uint8_t i = 0; i < dirty->rect_count; ++i) {
+        if (qp_surface_rect_contains(&dirty->rects[i], x, y)) {
+            dirty->last_rect = i;
+            return;
+        }
+
+        surface_dirty_rect_t grown = dirty->rects[i];
+        qp_surface_rect_union(&grown, &pixel);
+        uint32_t growth = qp_surface_rect_area(&grown) - qp_surface_rect_area(&dirty->rects[i]);
+        if (growth < best_growth) {
+            best_rect   = i;
+            best_growth = growth;
+        }
+    }
+
+    // Start a new rect if the pixel is too far away from the others, as long as there's space for it
+    if (best_growth > SURFACE_DIRTY_MERGE_COST && dirty->rect_count < SURFACE_DIRTY_RECT_COUNT) {
+        dirty->rects[dirty->rect_count] = pixel;
+        dirty->last_rect                = dirty->rect_count++;
+        return;
+    }
+
+    // Otherwise grow the closest one, which may now be worth merging with the others
+    qp_surface_rect_union(&dirty->rects[best_rect], &pixel);
+    qp_surface_merge_dirty_rects(dirty, best_rect);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -63,6 +146,10 @@ bool qp_surface_init(painter_device_t device, painter_rotation_t rotation) {
     surface->dirty.b        = surface->base.panel_height - 1;
     surface->dirty.is_dirty = true;
 
+    surface->dirty.rect_count = 1;
+    surface->dirty.last_rect  = 0;
+    surface->dirty.rects[0]   = (surface_dirty_rect_t){surface->dirty.l, surface->dirty.t, surface->dirty.r, surface->dirty.b};
+
     return true;
 }
 
@@ -83,6 +170,8 @@ bool qp_surface_flush(painter_device_t device) {
     surface->dirty.l = surface->dirty.t = UINT16_MAX;
     surface->dirty.r = surface->dirty.b = 0;
     surface->dirty.is_dirty             = false;
+    surface->dirty.rect_count           = 0;
+    surface->dirty.last_rect            = 0;
     return true;
 }
 
@@ -16,12 +16,25 @@ typedef struct surface_painter_driver_vtable_t {
     bool (*target_pixdata_transfer)(painter_driver_t *surface_driver, painter_driver_t *target_driver, uint16_t x, uint16_t y, bool entire_surface);
 } surface_painter_driver_vtable_t;
 
+typedef struct surface_dirty_rect_t {
+    uint16_t l;
+    uint16_t t;
+    uint16_t r;
+    uint16_t b;
+} surface_dirty_rect_t;
+
 typedef struct surface_dirty_data_t {
+    // Bounding box of everything that's dirty
     bool     is_dirty;
     uint16_t l;
     uint16_t t;
     uint16_t r;
     uint16_t b;
+
+    // Separate dirty regions within the bounding box, so that only those get transferred
+    uint8_t              rect_count;
+    uint8_t              last_rect;
+    surface_dirty_rect_t rects[SURFACE_DIRTY_RECT_COUNT];
 } surface_dirty_data_t;
 
 typedef struct surface_viewport_data_t {
@@ -7,6 +7,7 @@
 #    include "qp_draw.h"
 #    include "qp_surface_internal.h"
 #    include "qp_comms_dummy.h"
+#    include "qp_comms.h"
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Surface driver impl: rgb565
@@ -68,16 +69,16 @@ static bool qp_surface_append_pixels_rgb565(painter_device_t device, uint8_t *ta
     return true;
 }
 
-static bool rgb565_target_pixdata_transfer(painter_driver_t *surface_driver, painter_driver_t *target_driver, uint16_t x, uint16_t y, bool entire_surface) {
+static bool rgb565_target_pixdata_transfer_rect(painter_driver_t *surface_driver, painter_driver_t *target_driver, uint16_t x, uint16_t y, const surface_dirty_rect_t *rect) {
     surface_painter_device_t *surface_handle = (surface_painter_device_t *)surface_driver;
 
-    uint16_t l = entire_surface ? 0 : surface_handle->dirty.l;
-    uint16_t t = entire_surface ? 0 : surface_handle->dirty.t;
-    uint16_t r = entire_surface ? (surface_handle->base.panel_width - 1) : surface_handle->dirty.r;
-    uint16_t b = entire_surface ? (surface_handle->base.panel_height - 1) : surface_handle->dirty.b;
+    uint16_t l = rect->l;
+    uint16_t t = rect->t;
+    uint16_t r = rect->r;
+    uint16_t b = rect->b;
 
     // Set the target drawing area
-    bool ok = qp_viewport((painter_device_t)target_driver, x + l, y + t, x + r, y + b);
+    bool ok = target_driver->driver_vtable->viewport((painter_device_t)target_driver, x + l, y + t, x + r, y + b);
     if (!ok) {
         qp_dprintf("rgb565_target_pixdata_transfer: fail (could not set target viewport)\n");
         return false;
@@ -96,12 +97,14 @@ static bool rgb565_target_pixdata_transfer(painter_driver_t *surface_driver, pai
 
             // If we've accumulated enough data, send it
             if (pixel_counter == total_pixel_count) {
-                ok = qp_pixdata((painter_device_t)target_driver, qp_internal_global_pixdata_buffer, pixel_counter);
+                ok = target_driver->driver_vtable->pixdata((painter_device_t)target_driver, qp_internal_global_pixdata_buffer, pixel_counter);
                 if (!ok) {
                     qp_dprintf("rgb565_target_pixdata_transfer: fail (could not stream pixdata to target)\n");
                     return false;
                 }
-                // Reset the counter
+                // Fill the other buffer while this one is sent, and reset the counter
+                qp_internal_swap_pixdata_buffer();
+                target_buffer = (uint16_t *)qp_internal_global_pixdata_buffer;
                 pixel_counter = 0;
             }
         }
@@ -109,16 +112,41 @@ static bool rgb565_target_pixdata_transfer(painter_driver_t *surface_driver, pai
 
     // If there's any leftover data, send it
     if (pixel_counter > 0) {
-        ok = qp_pixdata((painter_device_t)target_driver, qp_internal_global_pixdata_buffer, pixel_counter);
+        ok = target_driver->driver_vtable->pixdata((painter_device_t)target_driver, qp_internal_global_pixdata_buffer, pixel_counter);
         if (!ok) {
             qp_dprintf("rgb565_target_pixdata_transfer: fail (could not stream pixdata to target)\n");
             return false;
         }
+        qp_internal_swap_pixdata_buffer();
     }
 
     return true;
 }
 
+static bool rgb565_target_pixdata_transfer(painter_driver_t *surface_driver, painter_driver_t *target_driver, uint16_t x, uint16_t y, bool entire_surface) {
+    surface_painter_device_t *surface_handle = (surface_painter_device_t *)surface_driver;
+
+    // Keep the target's comms running for the whole transfer, so pixel data can be sent in the background
+    if (!qp_comms_start((painter_device_t)target_driver)) {
+        qp_dprintf("rgb565_target_pixdata_transfer: fail (could not start comms)\n");
+        return false;
+    }
+
+    bool ok = true;
+    if (entire_surface) {
+        surface_dirty_rect_t rect = {0, 0, surface_handle->base.panel_width - 1, surface_handle->base.panel_height - 1};
+        ok                        = rgb565_target_pixdata_transfer_rect(surface_driver, target_driver, x, y, &rect);
+    } else {
+        // Transfer each dirty region separately, skipping everything in between
+        for (uint8_t i = 0; ok && i < surface_handle->dirty.rect_count; ++i) {
+            ok = rgb565_target_pixdata_transfer_rect(surface_driver, target_driver, x, y, &surface_handle->dirty.rects[i]);
+        }
+    }
+
+    qp_comms_stop((painter_device_t)target_driver);
+    return ok;
+}
+
 static bool qp_surface_append_pixdata_rgb565(painter_device_t device, uint8_t *target_buffer, uint32_t pixdata_offset, uint8_t pixdata_byte) {
     target_buffer[pixdata_offset] = pixdata_byte;
     return true;
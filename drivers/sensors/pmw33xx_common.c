@@ -180,29 +180,59 @@ bool pmw33xx_init(uint8_t sensor) {
     return true;
 }
 
-pmw33xx_report_t pmw33xx_read_burst(uint8_t sensor) {
-    pmw33xx_report_t report = {0};
+// The burst read waits out tSRAD_MOTBR against the realtime counter where
+// there is one, so the caller can get on with other work meanwhile
+#if defined(PROTOCOL_CHIBIOS) && (PORT_SUPPORTS_RT == TRUE)
+#    define PMW33XX_BURST_TIMESTAMP() chSysGetRealtimeCounterX()
+#    define PMW33XX_BURST_ELAPSED(start, us) ((rtcnt_t)(chSysGetRealtimeCounterX() - (start)) >= US2RTC(REALTIME_COUNTER_CLOCK, us))
+#endif
 
-    if (sensor >= pmw33xx_number_of_sensors) {
-        return report;
+typedef enum {
+    PMW33XX_BURST_IDLE,
+    PMW33XX_BURST_ADDRESS_SENT,
+    PMW33XX_BURST_RECEIVING,
+} pmw33xx_burst_state_t;
+
+static struct {
+    pmw33xx_burst_state_t    state;
+    uint8_t                  sensor;
+    pmw33xx_burst_callback_t callback;
+    pmw33xx_report_t         report;
+#ifdef PMW33XX_BURST_TIMESTAMP
+    uint32_t started;
+#endif
+} burst = {0};
+
+bool pmw33xx_read_burst_async(uint8_t sensor, pmw33xx_burst_callback_t callback) {
+    if (burst.state != PMW33XX_BURST_IDLE || sensor >= pmw33xx_number_of_sensors) {
+        return false;
     }
 
     if (!in_burst[sensor]) {
         pd_dprintf("PMW33XX (%d): burst\n", sensor);
         if (!pmw33xx_write(sensor, REG_Motion_Burst, 0x00)) {
-            return report;
+            return false;
         }
         in_burst[sensor] = true;
     }
 
     if (!pmw33xx_spi_start(sensor)) {
-        return report;
+        return false;
     }
 
     spi_write(REG_Motion_Burst);
-    wait_us(35); // waits for tSRAD_MOTBR
+#ifdef PMW33XX_BURST_TIMESTAMP
+    burst.started = PMW33XX_BURST_TIMESTAMP();
+#endif
+    burst.state    = PMW33XX_BURST_ADDRESS_SENT;
+    burst.sensor   = sensor;
+    burst.callback = callback;
+    return true;
+}
 
-    spi_receive((uint8_t *)&report, sizeof(report));
+static void pmw33xx_read_burst_complete(void) {
+    pmw33xx_report_t report = burst.report;
+    uint8_t          sensor = burst.sensor;
 
     // panic recovery, sometimes burst mode works weird.
     if (report.motion.w & 0b111) {
@@ -210,11 +240,65 @@ pmw33xx_report_t pmw33xx_read_burst(uint8_t sensor) {
     }
 
     spi_stop();
+    burst.state = PMW33XX_BURST_IDLE;
 
     pd_dprintf("PMW33XX (%d): motion: 0x%x dx: %i dy: %i\n", sensor, report.motion.w, report.delta_x, report.delta_y);
 
     report.delta_x *= -1;
     report.delta_y *= -1;
 
-    return report;
+    if (burst.callback) {
+        burst.callback(sensor, report);
+    }
+}
+
+bool pmw33xx_read_burst_task(void) {
+    if (burst.state == PMW33XX_BURST_ADDRESS_SENT) {
+#ifdef PMW33XX_BURST_TIMESTAMP
+        if (!PMW33XX_BURST_ELAPSED(burst.started, 35)) {
+            return true;
+        }
+#else
+        wait_us(35); // waits for tSRAD_MOTBR
+#endif
+
+#ifdef PROTOCOL_CHIBIOS
+        spi_receive_async((uint8_t *)&burst.report, sizeof(burst.report));
+        burst.state = PMW33XX_BURST_RECEIVING;
+        return true;
+#else
+        spi_receive((uint8_t *)&burst.report, sizeof(burst.report));
+        pmw33xx_read_burst_complete();
+#endif
+    }
+
+#ifdef PROTOCOL_CHIBIOS
+    if (burst.state == PMW33XX_BURST_RECEIVING) {
+        if (spi_async_busy()) {
+            return true;
+        }
+        pmw33xx_read_burst_complete();
+    }
+#endif
+
+    return burst.state != PMW33XX_BURST_IDLE;
+}
+
+static pmw33xx_report_t burst_result;
+
+static void pmw33xx_store_burst(uint8_t sensor, pmw33xx_report_t report) {
+    burst_result = report;
+}
+
+pmw33xx_report_t pmw33xx_read_burst(uint8_t sensor) {
+    // Finish any read still running, as they share the bus
+    while (pmw33xx_read_burst_task()) {
+    }
+
+    burst_result = (pmw33xx_report_t){0};
+    if (pmw33xx_read_burst_async(sensor, pmw33xx_store_burst)) {
+        while (pmw33xx_read_burst_task()) {
+        }
+    }
+    return burst_result;
 }
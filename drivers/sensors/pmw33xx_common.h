@@ -151,6 +151,36 @@ void pmw33xx_set_cpi_all_sensors(uint16_t cpi);
  */
 pmw33xx_report_t pmw33xx_read_burst(uint8_t sensor);
 
+/**
+ * @brief Called with the values read by pmw33xx_read_burst_async(), they are
+ * the same as pmw33xx_read_burst() returns
+ */
+typedef void (*pmw33xx_burst_callback_t)(uint8_t sensor, pmw33xx_report_t report);
+
+/**
+ * @brief Starts reading the current delta and motion register values on the
+ * given sensor, and returns without waiting for the sensor. The sensor stays
+ * selected and the SPI bus claimed until the read is done, so no other SPI
+ * transfer can be made until then.
+ *
+ * @param sensor Index of the sensors chip select pin
+ * @param callback Called from pmw33xx_read_burst_task() once the read is done
+ * @return true The read was started
+ * @return false A read is already running or starting it failed, the callback
+ * will not be called
+ */
+bool pmw33xx_read_burst_async(uint8_t sensor, pmw33xx_burst_callback_t callback);
+
+/**
+ * @brief Moves a read started by pmw33xx_read_burst_async() along, without
+ * waiting where the platform allows it. Has to be called until it returns
+ * false.
+ *
+ * @return true The read is still running
+ * @return false No read is running, any callback has been called
+ */
+bool pmw33xx_read_burst_task(void);
+
 /**
  * @brief Read one byte of data from the given register on the sensor
  *
@@ -28,6 +28,13 @@ void soft_serial_target_init(void);
 
 bool soft_serial_transaction(int sstd_index);
 
+#ifdef SPLIT_MATRIX_PUSH
+// target pushes a transaction buffer without being asked for it
+bool soft_serial_push(int sstd_index);
+// initiator checks for, and consumes, a pushed transaction buffer
+bool soft_serial_pushed(int sstd_index);
+#endif
+
 #ifdef SERIAL_DEBUG
 #    include <debug.h>
 #    include <print.h>
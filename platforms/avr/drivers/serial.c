@@ -19,6 +19,15 @@
 #include "gpio.h"
 #include "serial.h"
 
+#ifdef SPLIT_TRANSACTION_BATCHING
+// The target sends its reply before receiving the request, so a batch reply would always be one exchange behind
+#    error "SPLIT_TRANSACTION_BATCHING is not supported by the AVR bitbang serial driver, use I2C instead"
+#endif
+
+#ifdef SPLIT_MATRIX_PUSH
+#    error "SPLIT_MATRIX_PUSH requires a full-duplex serial connection, which the AVR bitbang serial driver doesn't support"
+#endif
+
 #ifdef SOFT_SERIAL_PIN
 
 #    if !(defined(__AVR_AT90USB646__) || defined(__AVR_AT90USB647__) || defined(__AVR_AT90USB1286__) || defined(__AVR_AT90USB1287__) || defined(__AVR_AT90USB162__) || defined(__AVR_ATmega16U2__) || defined(__AVR_ATmega32U2__) || defined(__AVR_ATmega16U4__) || defined(__AVR_ATmega32U4__))
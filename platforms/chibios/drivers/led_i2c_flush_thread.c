@@ -0,0 +1,104 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <ch.h>
+
+#include "led_i2c_flush.h"
+#ifdef LED_MATRIX_ENABLE
+#    include "led_matrix_drivers.h"
+#endif
+#ifdef RGB_MATRIX_ENABLE
+#    include "rgb_matrix_drivers.h"
+#endif
+
+// Room for a whole frame from every driver, so the main loop only blocks if it redraws before the previous frame is sent
+#ifndef LED_I2C_FLUSH_QUEUE_SIZE
+#    ifndef IS31FL3729_I2C_FLUSH_WRITE_COUNT
+#        define IS31FL3729_I2C_FLUSH_WRITE_COUNT 0
+#    endif
+#    ifndef IS31FL3731_I2C_FLUSH_WRITE_COUNT
+#        define IS31FL3731_I2C_FLUSH_WRITE_COUNT 0
+#    endif
+#    ifndef IS31FL3733_I2C_FLUSH_WRITE_COUNT
+#        define IS31FL3733_I2C_FLUSH_WRITE_COUNT 0
+#    endif
+#    ifndef IS31FL3736_I2C_FLUSH_WRITE_COUNT
+#        define IS31FL3736_I2C_FLUSH_WRITE_COUNT 0
+#    endif
+#    ifndef IS31FL3737_I2C_FLUSH_WRITE_COUNT
+#        define IS31FL3737_I2C_FLUSH_WRITE_COUNT 0
+#    endif
+#    ifndef IS31FL3741_I2C_FLUSH_WRITE_COUNT
+#        define IS31FL3741_I2C_FLUSH_WRITE_COUNT 0
+#    endif
+#    ifndef IS31FL3742A_I2C_FLUSH_WRITE_COUNT
+#        define IS31FL3742A_I2C_FLUSH_WRITE_COUNT 0
+#    endif
+#    ifndef IS31FL3743A_I2C_FLUSH_WRITE_COUNT
+#        define IS31FL3743A_I2C_FLUSH_WRITE_COUNT 0
+#    endif
+#    ifndef IS31FL3745_I2C_FLUSH_WRITE_COUNT
+#        define IS31FL3745_I2C_FLUSH_WRITE_COUNT 0
+#    endif
+#    ifndef IS31FL3746A_I2C_FLUSH_WRITE_COUNT
+#        define IS31FL3746A_I2C_FLUSH_WRITE_COUNT 0
+#    endif
+#    ifndef SNLED27351_I2C_FLUSH_WRITE_COUNT
+#        define SNLED27351_I2C_FLUSH_WRITE_COUNT 0
+#    endif
+#    define LED_I2C_FLUSH_FRAME_WRITE_COUNT (IS31FL3729_I2C_FLUSH_WRITE_COUNT + IS31FL3731_I2C_FLUSH_WRITE_COUNT + IS31FL3733_I2C_FLUSH_WRITE_COUNT + IS31FL3736_I2C_FLUSH_WRITE_COUNT + IS31FL3737_I2C_FLUSH_WRITE_COUNT + IS31FL3741_I2C_FLUSH_WRITE_COUNT + IS31FL3742A_I2C_FLUSH_WRITE_COUNT + IS31FL3743A_I2C_FLUSH_WRITE_COUNT + IS31FL3745_I2C_FLUSH_WRITE_COUNT + IS31FL3746A_I2C_FLUSH_WRITE_COUNT + SNLED27351_I2C_FLUSH_WRITE_COUNT)
+#    if LED_I2C_FLUSH_FRAME_WRITE_COUNT > 0
+#        define LED_I2C_FLUSH_QUEUE_SIZE LED_I2C_FLUSH_FRAME_WRITE_COUNT
+#    else
+#        define LED_I2C_FLUSH_QUEUE_SIZE 64
+#    endif
+#endif
+
+_Static_assert(LED_I2C_FLUSH_QUEUE_SIZE > 0 && LED_I2C_FLUSH_QUEUE_SIZE <= UINT16_MAX, "LED_I2C_FLUSH_QUEUE_SIZE must be between 1 and 65535");
+
+static led_i2c_write_t queue[LED_I2C_FLUSH_QUEUE_SIZE];
+static uint16_t        queue_head = 0;
+static uint16_t        queue_tail = 0;
+
+// Counts the free and used slots of the queue
+static SEMAPHORE_DECL(free_slots, LED_I2C_FLUSH_QUEUE_SIZE);
+static SEMAPHORE_DECL(used_slots, 0);
+
+static THD_WORKING_AREA(waLedI2cFlushThread, LED_I2C_FLUSH_THREAD_STACK_SIZE);
+static THD_FUNCTION(LedI2cFlushThread, arg) {
+    (void)arg;
+    chRegSetThreadName("led_i2c_flush");
+
+    while (true) {
+        chSemWait(&used_slots);
+        // The ChibiOS I2C driver sleeps while the transfer runs, letting the main loop carry on
+        led_i2c_flush_perform(&queue[queue_tail]);
+        queue_tail = (queue_tail + 1) % LED_I2C_FLUSH_QUEUE_SIZE;
+        chSemSignal(&free_slots);
+    }
+}
+
+bool led_i2c_flush_queue(const led_i2c_write_t *write) {
+    static bool started = false;
+    if (!started) {
+        started = true;
+        chThdCreateStatic(waLedI2cFlushThread, sizeof(waLedI2cFlushThread), LED_I2C_FLUSH_THREAD_PRIORITY, LedI2cFlushThread, NULL);
+    }
+
+    // Blocks only when the queue is full
+    chSemWait(&free_slots);
+    queue[queue_head] = *write;
+    queue_head        = (queue_head + 1) % LED_I2C_FLUSH_QUEUE_SIZE;
+    chSemSignal(&used_slots);
+    return true;
+}
+
+void led_i2c_flush_queue_wait(void) {
+    // Every slot is free once the thread is done with the last write
+    for (uint16_t i = 0; i < LED_I2C_FLUSH_QUEUE_SIZE; i++) {
+        chSemWait(&free_slots);
+    }
+    for (uint16_t i = 0; i < LED_I2C_FLUSH_QUEUE_SIZE; i++) {
+        chSemSignal(&free_slots);
+    }
+}
@@ -7,9 +7,63 @@
 #include "serial_protocol.h"
 #include "synchronization_util.h"
 
+#ifdef SPLIT_MATRIX_PUSH
+#    include <string.h>
+#    include "crc.h"
+
+#    if !defined(SERIAL_USART_FULL_DUPLEX)
+#        error "SPLIT_MATRIX_PUSH requires a full-duplex serial connection, define SERIAL_USART_FULL_DUPLEX"
+#    endif
+
+/* Frames pushed by the slave are [marker][transaction id][target2initiator buffer][crc8].
+ * Handshake bytes are always below 64, so the marker can't be mistaken for one. */
+#    define PUSH_MARKER 0xA5
+
+// The NUM_TOTAL_TRANSACTIONS <= 32 assert in transaction_id_define.h keeps handshakes below 64 and fits pushed_transactions
+
+#    ifndef SERIAL_PUSH_BUFFER_SIZE
+#        define SERIAL_PUSH_BUFFER_SIZE 32
+#    endif
+
+static uint32_t pushed_transactions = 0;
+
+static void receive_pushed_frames(void);
+static bool receive_push(void);
+#endif // SPLIT_MATRIX_PUSH
+
 static inline bool initiate_transaction(uint8_t transaction_id);
 static inline bool react_to_transaction(void);
 
+/**
+ * @brief Send a transaction buffer. Framed buffers are variable length, so
+ * only the used part of them is sent.
+ */
+static inline bool send_transaction_buffer(split_transaction_desc_t* transaction, const void* buffer, size_t size) {
+    if (transaction->framed) {
+        size = split_frame_size(buffer, size);
+    }
+    return serial_transport_send((const uint8_t*)buffer, size);
+}
+
+/**
+ * @brief Receive a transaction buffer, reading the length of framed buffers
+ * from their header first.
+ */
+static inline bool receive_transaction_buffer(split_transaction_desc_t* transaction, void* buffer, size_t size) {
+    if (transaction->framed) {
+        split_frame_t* frame = buffer;
+        if (unlikely(!serial_transport_receive((uint8_t*)frame, SPLIT_FRAME_HEADER_SIZE) || frame->length > size - SPLIT_FRAME_HEADER_SIZE)) {
+            return false;
+        }
+        if (frame->length == 0) {
+            return true;
+        }
+        buffer = frame->data;
+        size   = frame->length;
+    }
+    return serial_transport_receive((uint8_t*)buffer, size);
+}
+
 /**
  * @brief This thread runs on the slave and responds to transactions initiated
  * by the master.
@@ -73,7 +127,7 @@ static inline bool react_to_transaction(void) {
 
     /* Receive transaction buffer from the master. If this transaction requires it.*/
     if (transaction->initiator2target_buffer_size) {
-        if (unlikely(!serial_transport_receive(split_trans_initiator2target_buffer(transaction), transaction->initiator2target_buffer_size))) {
+        if (unlikely(!receive_transaction_buffer(transaction, split_trans_initiator2target_buffer(transaction), transaction->initiator2target_buffer_size))) {
             return false;
         }
     }
@@ -85,7 +139,7 @@ static inline bool react_to_transaction(void) {
 
     /* Send transaction buffer to the master. If this transaction requires it. */
     if (transaction->target2initiator_buffer_size) {
-        if (unlikely(!serial_transport_send(split_trans_target2initiator_buffer(transaction), transaction->target2initiator_buffer_size))) {
+        if (unlikely(!send_transaction_buffer(transaction, split_trans_target2initiator_buffer(transaction), transaction->target2initiator_buffer_size))) {
             return false;
         }
     }
@@ -100,9 +154,11 @@ static inline bool react_to_transaction(void) {
  * @return bool Indicates success of transaction.
  */
 bool soft_serial_transaction(int index) {
+#ifndef SPLIT_MATRIX_PUSH
     /* Clear the receive queue, to start with a clean slate.
      * Parts of failed transactions or spurious bytes could still be in it. */
     serial_transport_driver_clear();
+#endif // SPLIT_MATRIX_PUSH
 
     return initiate_transaction((uint8_t)index);
 }
@@ -119,6 +175,12 @@ static inline bool initiate_transaction(uint8_t transaction_id) {
 
     split_shared_memory_lock_autounlock();
 
+#ifdef SPLIT_MATRIX_PUSH
+    /* The receive queue can hold frames pushed by the slave, so drain it
+     * instead of clearing it. Anything else in it is dropped. */
+    receive_pushed_frames();
+#endif // SPLIT_MATRIX_PUSH
+
     split_transaction_desc_t* transaction = &split_transaction_table[transaction_id];
 
     /* Send transaction table index to the slave, which doubles as basic handshake token. */
@@ -133,14 +195,22 @@ static inline bool initiate_transaction(uint8_t transaction_id) {
      *   - due to the half duplex limitations on return codes, we always have to read *something*.
      *   - without the read, write only transactions *always* succeed, even during the boot process where the slave is not ready.
      */
-    if (unlikely(!serial_transport_receive(&transaction_id_shake, sizeof(transaction_id_shake)) || (transaction_id_shake != (transaction_id ^ NUM_TOTAL_TRANSACTIONS)))) {
+    bool shake_received = serial_transport_receive(&transaction_id_shake, sizeof(transaction_id_shake));
+#ifdef SPLIT_MATRIX_PUSH
+    /* The slave may have pushed a frame right before the handshake. */
+    while (shake_received && transaction_id_shake == PUSH_MARKER) {
+        receive_push();
+        shake_received = serial_transport_receive(&transaction_id_shake, sizeof(transaction_id_shake));
+    }
+#endif // SPLIT_MATRIX_PUSH
+    if (unlikely(!shake_received || (transaction_id_shake != (transaction_id ^ NUM_TOTAL_TRANSACTIONS)))) {
         serial_dprintf("SPLIT: receiving handshake failed\n");
         return false;
     }
 
     /* Send transaction buffer to the slave. If this transaction requires it. */
     if (transaction->initiator2target_buffer_size) {
-        if (unlikely(!serial_transport_send(split_trans_initiator2target_buffer(transaction), transaction->initiator2target_buffer_size))) {
+        if (unlikely(!send_transaction_buffer(transaction, split_trans_initiator2target_buffer(transaction), transaction->initiator2target_buffer_size))) {
             serial_dprintf("SPLIT: sending buffer failed\n");
             return false;
         }
@@ -148,7 +218,7 @@ static inline bool initiate_transaction(uint8_t transaction_id) {
 
     /* Receive transaction buffer from the slave. If this transaction requires it. */
     if (transaction->target2initiator_buffer_size) {
-        if (unlikely(!serial_transport_receive(split_trans_target2initiator_buffer(transaction), transaction->target2initiator_buffer_size))) {
+        if (unlikely(!receive_transaction_buffer(transaction, split_trans_target2initiator_buffer(transaction), transaction->target2initiator_buffer_size))) {
             serial_dprintf("SPLIT: receiving buffer failed\n");
             return false;
         }
@@ -156,3 +226,89 @@ static inline bool initiate_transaction(uint8_t transaction_id) {
 
     return true;
 }
+
+#ifdef SPLIT_MATRIX_PUSH
+
+/**
+ * @brief Push a transaction buffer from the slave to the master, without
+ * waiting for the master to ask for it. Has to be called with the split shared
+ * memory locked, so that it can't interleave with the reply to a transaction.
+ *
+ * @param index Transaction Table index of the transaction to push.
+ * @return bool Indicates success of sending the frame.
+ */
+bool soft_serial_push(int index) {
+    if (unlikely(index >= NUM_TOTAL_TRANSACTIONS)) {
+        return false;
+    }
+
+    split_transaction_desc_t* transaction = &split_transaction_table[index];
+    if (unlikely(transaction->target2initiator_buffer_size == 0 || transaction->target2initiator_buffer_size > SERIAL_PUSH_BUFFER_SIZE)) {
+        return false;
+    }
+
+    uint8_t header[2] = {PUSH_MARKER, (uint8_t)index};
+    uint8_t checksum  = crc8(split_trans_target2initiator_buffer(transaction), transaction->target2initiator_buffer_size);
+    return serial_transport_send(header, sizeof(header)) && serial_transport_send(split_trans_target2initiator_buffer(transaction), transaction->target2initiator_buffer_size) && serial_transport_send(&checksum, sizeof(checksum));
+}
+
+/**
+ * @brief Check whether the slave pushed the buffer of a transaction since the
+ * last call. If so, it has been copied to the split shared memory.
+ *
+ * @param index Transaction Table index of the transaction to check.
+ * @return bool Indicates that a new buffer was received.
+ */
+bool soft_serial_pushed(int index) {
+    split_shared_memory_lock_autounlock();
+
+    receive_pushed_frames();
+
+    bool pushed = pushed_transactions & (1UL << index);
+    pushed_transactions &= ~(1UL << index);
+    return pushed;
+}
+
+/**
+ * @brief Receive a pushed frame, after its marker has been read.
+ */
+static bool receive_push(void) {
+    uint8_t transaction_id = 0;
+    if (unlikely(!serial_transport_receive(&transaction_id, sizeof(transaction_id)) || transaction_id >= NUM_TOTAL_TRANSACTIONS)) {
+        return false;
+    }
+
+    split_transaction_desc_t* transaction = &split_transaction_table[transaction_id];
+    if (unlikely(transaction->target2initiator_buffer_size == 0 || transaction->target2initiator_buffer_size > SERIAL_PUSH_BUFFER_SIZE)) {
+        return false;
+    }
+
+    uint8_t buffer[SERIAL_PUSH_BUFFER_SIZE];
+    uint8_t checksum = 0;
+    if (unlikely(!serial_transport_receive(buffer, transaction->target2initiator_buffer_size) || !serial_transport_receive(&checksum, sizeof(checksum)))) {
+        return false;
+    }
+    if (unlikely(checksum != crc8(buffer, transaction->target2initiator_buffer_size))) {
+        serial_dprintf("SPLIT: pushed frame checksum mismatch\n");
+        return false;
+    }
+
+    memcpy(split_trans_target2initiator_buffer(transaction), buffer, transaction->target2initiator_buffer_size);
+    pushed_transactions |= 1UL << transaction_id;
+    return true;
+}
+
+/**
+ * @brief Receive all frames pushed by the slave that are waiting in the
+ * receive queue, dropping any other bytes.
+ */
+static void receive_pushed_frames(void) {
+    uint8_t marker = 0;
+    while (serial_transport_receive_nonblocking(&marker, sizeof(marker))) {
+        if (marker == PUSH_MARKER) {
+            receive_push();
+        }
+    }
+}
+
+#endif // SPLIT_MATRIX_PUSH
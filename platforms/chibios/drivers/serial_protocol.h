@@ -40,6 +40,15 @@ bool __attribute__((nonnull, hot)) serial_transport_receive(uint8_t* destination
  */
 bool __attribute__((nonnull, hot)) serial_transport_receive_blocking(uint8_t* destination, const size_t size);
 
+/**
+ * @brief Non-blocking receive of size * bytes, only succeeds if they are
+ * already available.
+ *
+ * @return true Receive success.
+ * @return false Not enough data available, or receive failed.
+ */
+bool __attribute__((nonnull, hot)) serial_transport_receive_nonblocking(uint8_t* destination, const size_t size);
+
 /**
  * @brief Blocking send of buffer with timeout.
  *
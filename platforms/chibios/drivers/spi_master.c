@@ -20,6 +20,9 @@
 
 static bool spiStarted = false;
 
+// Set while a transfer started by spi_transmit_async() or spi_receive_async() may still be running
+static bool spiAsyncPending = false;
+
 #if SPI_SELECT_MODE == SPI_SELECT_MODE_NONE
 static pin_t currentSlavePin;
 #endif
@@ -296,7 +299,28 @@ bool spi_start(pin_t slavePin, bool lsbFirst, uint8_t mode, uint16_t divisor) {
     return true;
 }
 
+bool spi_async_busy(void) {
+    if (!spiAsyncPending) {
+        return false;
+    }
+
+    osalSysLock();
+    bool active = SPI_DRIVER.state == SPI_ACTIVE;
+    osalSysUnlock();
+    if (!active) {
+        spiAsyncPending = false;
+    }
+    return active;
+}
+
+void spi_transmit_wait(void) {
+    while (spi_async_busy()) {
+    }
+}
+
 spi_status_t spi_write(uint8_t data) {
+    spi_transmit_wait();
+
     uint8_t rxData;
     spiExchange(&SPI_DRIVER, 1, &data, &rxData);
 
@@ -304,6 +328,8 @@ spi_status_t spi_write(uint8_t data) {
 }
 
 spi_status_t spi_read(void) {
+    spi_transmit_wait();
+
     uint8_t data = 0;
     spiReceive(&SPI_DRIVER, 1, &data);
 
@@ -311,16 +337,38 @@ spi_status_t spi_read(void) {
 }
 
 spi_status_t spi_transmit(const uint8_t *data, uint16_t length) {
+    spi_transmit_wait();
+
     spiSend(&SPI_DRIVER, length, data);
     return SPI_STATUS_SUCCESS;
 }
 
+spi_status_t spi_transmit_async(const uint8_t *data, uint16_t length) {
+    spi_transmit_wait();
+
+    spiStartSend(&SPI_DRIVER, length, data);
+    spiAsyncPending = true;
+    return SPI_STATUS_SUCCESS;
+}
+
 spi_status_t spi_receive(uint8_t *data, uint16_t length) {
+    spi_transmit_wait();
+
     spiReceive(&SPI_DRIVER, length, data);
     return SPI_STATUS_SUCCESS;
 }
 
+spi_status_t spi_receive_async(uint8_t *data, uint16_t length) {
+    spi_transmit_wait();
+
+    spiStartReceive(&SPI_DRIVER, length, data);
+    spiAsyncPending = true;
+    return SPI_STATUS_SUCCESS;
+}
+
 void spi_stop(void) {
+    spi_transmit_wait();
+
     if (spiStarted) {
 #if SPI_SELECT_MODE == SPI_SELECT_MODE_NONE
         if (currentSlavePin != NO_PIN) {
@@ -85,8 +85,25 @@ spi_status_t spi_read(void);
 
 spi_status_t spi_transmit(const uint8_t *data, uint16_t length);
 
+// Starts transmitting in the background, after waiting for any earlier
+// transfer. The data has to stay unchanged until spi_transmit_wait() or the
+// next SPI call, which all wait for the transfer to finish first.
+spi_status_t spi_transmit_async(const uint8_t *data, uint16_t length);
+
+// Waits for a transfer started by spi_transmit_async() or spi_receive_async()
+void spi_transmit_wait(void);
+
+// Whether a transfer started by spi_transmit_async() or spi_receive_async() is
+// still running
+bool spi_async_busy(void);
+
 spi_status_t spi_receive(uint8_t *data, uint16_t length);
 
+// Starts receiving in the background, after waiting for any earlier transfer.
+// The data can't be used until spi_async_busy() returns false, or after
+// spi_transmit_wait() or the next SPI call.
+spi_status_t spi_receive_async(uint8_t *data, uint16_t length);
+
 void spi_stop(void);
 #ifdef __cplusplus
 }
@@ -0,0 +1,49 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <ch.h>
+
+#include "matrix_scan_thread.h"
+
+#ifndef MATRIX_SCAN_THREAD_PRIORITY
+#    define MATRIX_SCAN_THREAD_PRIORITY HIGHPRIO
+#endif
+
+// Custom matrix scanning code, such as matrix_scan_custom(), runs on this thread too
+#ifndef MATRIX_SCAN_THREAD_STACK_SIZE
+#    define MATRIX_SCAN_THREAD_STACK_SIZE 1024
+#endif
+
+static MUTEX_DECL(matrix_scan_mutex);
+
+static THD_WORKING_AREA(waMatrixScanThread, MATRIX_SCAN_THREAD_STACK_SIZE);
+static THD_FUNCTION(MatrixScanThread, arg) {
+    (void)arg;
+    chRegSetThreadName("matrix_scan");
+
+    systime_t next = chVTGetSystemTimeX();
+    while (true) {
+        systime_t previous = next;
+        next               = chTimeAddX(previous, TIME_US2I(MATRIX_SCAN_THREAD_INTERVAL));
+
+        chMtxLock(&matrix_scan_mutex);
+        matrix_scan_queue_events();
+        chMtxUnlock(&matrix_scan_mutex);
+
+        // Keeps a steady scan rate, and returns immediately if the scan overran
+        chThdSleepUntilWindowed(previous, next);
+    }
+}
+
+bool matrix_scan_thread_start(void) {
+    chThdCreateStatic(waMatrixScanThread, sizeof(waMatrixScanThread), MATRIX_SCAN_THREAD_PRIORITY, MatrixScanThread, NULL);
+    return true;
+}
+
+void matrix_scan_thread_lock(void) {
+    chMtxLock(&matrix_scan_mutex);
+}
+
+void matrix_scan_thread_unlock(void) {
+    chMtxUnlock(&matrix_scan_mutex);
+}
@@ -0,0 +1,63 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <ch.h>
+#include <hal.h>
+
+#include "gpio.h"
+#include "matrix_wakeup.h"
+
+#if !defined(PAL_USE_CALLBACKS) || (PAL_USE_CALLBACKS != TRUE)
+#    error "MATRIX_WAKEUP_ENABLE requires PAL_USE_CALLBACKS to be set to TRUE in halconf.h"
+#endif
+
+static BSEMAPHORE_DECL(wakeup_sem, true);
+
+static void matrix_wakeup_pal_callback(void *arg) {
+    matrix_wakeup_trigger();
+
+    chSysLockFromISR();
+    chBSemSignalI(&wakeup_sem);
+    chSysUnlockFromISR();
+}
+
+#ifdef MCU_STM32
+// On STM32, pins with the same number on different ports (A1, B1, ...) share
+// an EXTI line, so only one of them can raise the wakeup interrupt
+static uint32_t claimed_lines = 0;
+static pin_t    line_owners[PAL_IOPORTS_WIDTH];
+#endif
+
+bool matrix_wakeup_pin_enable(pin_t pin) {
+#ifdef MCU_STM32
+    uint32_t pad = PAL_PAD(pin);
+    if (claimed_lines & (1UL << pad)) {
+        return line_owners[pad] == pin;
+    }
+    claimed_lines |= 1UL << pad;
+    line_owners[pad] = pin;
+#endif
+
+    palEnableLineEvent(pin, PAL_EVENT_MODE_BOTH_EDGES);
+    palSetLineCallback(pin, matrix_wakeup_pal_callback, NULL);
+    return true;
+}
+
+void matrix_wakeup_pin_disable(pin_t pin) {
+#ifdef MCU_STM32
+    uint32_t pad = PAL_PAD(pin);
+    // Leave the line alone if another pin owns it
+    if (!(claimed_lines & (1UL << pad)) || line_owners[pad] != pin) {
+        return;
+    }
+    claimed_lines &= ~(1UL << pad);
+#endif
+
+    palDisableLineEvent(pin);
+}
+
+void matrix_wakeup_idle(void) {
+    // Block the main loop until a matrix interrupt arrives, but keep running
+    // the rest of the keyboard task at 1kHz so that timers still progress
+    chBSemWaitTimeout(&wakeup_sem, TIME_MS2I(1));
+}
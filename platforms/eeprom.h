@@ -70,7 +70,10 @@ void     eeprom_update_block(const void *__src, void *__dst, size_t __n);
 #elif defined(EEPROM_TEST_HARNESS)
 #    ifndef LEGACY_FLASH_OPS_MOCKED
 // Normal tests
-#        define TOTAL_EEPROM_BYTE_COUNT 32
+#        ifndef EEPROM_SIZE
+#            define EEPROM_SIZE 32
+#        endif
+#        define TOTAL_EEPROM_BYTE_COUNT (EEPROM_SIZE)
 #    else
 // Flash wear-leveling testing
 #        include "eeprom_legacy_emulated_flash_tests.h"
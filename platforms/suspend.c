@@ -3,6 +3,9 @@
 
 #include "suspend.h"
 #include "matrix.h"
+#ifdef MATRIX_SCAN_THREAD_ENABLE
+#    include "matrix_scan_thread.h"
+#endif
 
 // TODO: Move to more correct location
 __attribute__((weak)) void matrix_power_up(void) {}
@@ -41,9 +44,15 @@ __attribute__((weak)) void suspend_wakeup_init_kb(void) {
  * FIXME: needs doc
  */
 bool suspend_wakeup_condition(void) {
+#ifdef MATRIX_SCAN_THREAD_ENABLE
+    matrix_scan_thread_lock();
+#endif
     matrix_power_up();
     matrix_scan();
     matrix_power_down();
+#ifdef MATRIX_SCAN_THREAD_ENABLE
+    matrix_scan_thread_unlock();
+#endif
     for (uint8_t r = 0; r < MATRIX_ROWS; r++) {
         if (matrix_get_row(r)) return true;
     }
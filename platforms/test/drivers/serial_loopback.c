@@ -0,0 +1,244 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+
+#include "serial.h"
+#include "serial_loopback.h"
+#include "transactions.h"
+#include "transport.h"
+
+#ifdef SPLIT_MATRIX_PUSH
+#    include "crc.h"
+
+// Same framing as the ChibiOS serial protocol
+#    define PUSH_MARKER 0xA5
+#    define PUSH_QUEUE_SIZE 256
+
+static uint8_t  push_queue[PUSH_QUEUE_SIZE];
+static uint16_t push_queue_length   = 0;
+static uint32_t pushed_transactions = 0;
+#endif // SPLIT_MATRIX_PUSH
+
+#define WIRE_BUFFER_SIZE (sizeof(split_shared_memory_t) + 2)
+
+static serial_loopback_link_t  link_config;
+static serial_loopback_stats_t stats;
+static uint32_t                random_state;
+
+// The shared memory of the half that isn't running
+static split_shared_memory_t other_memory;
+static bool                  slave_running = false;
+
+static uint32_t next_random(void) {
+    // xorshift32
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 17;
+    random_state ^= random_state << 5;
+    return random_state;
+}
+
+static void swap_memory(void) {
+    static split_shared_memory_t temp;
+    memcpy(&temp, split_shmem, sizeof(temp));
+    memcpy(split_shmem, &other_memory, sizeof(temp));
+    memcpy(&other_memory, &temp, sizeof(temp));
+}
+
+static void turn_around(void) {
+    stats.busy_us += link_config.latency_us;
+}
+
+// Sends the bytes over the link, flipping bits at the configured error rate
+static void transfer(uint8_t *data, size_t length) {
+    stats.bytes += length;
+    if (link_config.baud_rate) {
+        stats.busy_us += (uint64_t)length * 10 * 1000000 / link_config.baud_rate;
+    }
+    if (link_config.bit_error_rate <= 0) {
+        return;
+    }
+    for (size_t i = 0; i < length * 8; i++) {
+        if (next_random() < link_config.bit_error_rate * UINT32_MAX) {
+            data[i / 8] ^= 1 << (i % 8);
+            stats.bit_errors++;
+        }
+    }
+}
+
+// Sends a transaction buffer, framed buffers only send their used part
+static bool transfer_buffer(const split_transaction_desc_t *trans, uint8_t *data, uint8_t size) {
+    uint8_t length = trans->framed ? split_frame_size(data, size) : size;
+    transfer(data, length);
+    // The receiver reads the header of framed buffers to know how much follows
+    return !trans->framed || split_frame_size(data, size) == length;
+}
+
+void serial_loopback_init(const serial_loopback_link_t *link, uint32_t seed) {
+    if (slave_running) {
+        serial_loopback_leave_slave();
+    }
+    memset(split_shmem, 0, sizeof(split_shared_memory_t));
+    memset(&other_memory, 0, sizeof(other_memory));
+#ifdef SPLIT_MATRIX_PUSH
+    push_queue_length   = 0;
+    pushed_transactions = 0;
+#endif // SPLIT_MATRIX_PUSH
+    random_state = seed ? seed : 1;
+    serial_loopback_set_link(link);
+    serial_loopback_reset_stats();
+}
+
+void serial_loopback_set_link(const serial_loopback_link_t *link) {
+    link_config = *link;
+}
+
+const serial_loopback_stats_t *serial_loopback_stats(void) {
+    return &stats;
+}
+
+void serial_loopback_reset_stats(void) {
+    memset(&stats, 0, sizeof(stats));
+}
+
+void serial_loopback_enter_slave(void) {
+    if (!slave_running) {
+        swap_memory();
+        slave_running = true;
+    }
+}
+
+void serial_loopback_leave_slave(void) {
+    if (slave_running) {
+        swap_memory();
+        slave_running = false;
+    }
+}
+
+void soft_serial_initiator_init(void) {}
+
+void soft_serial_target_init(void) {}
+
+static void slave_react(split_transaction_desc_t *trans, uint8_t *wire) {
+    serial_loopback_enter_slave();
+    if (trans->initiator2target_buffer_size) {
+        memcpy(split_trans_initiator2target_buffer(trans), wire, trans->initiator2target_buffer_size);
+    }
+    if (trans->slave_callback) {
+        trans->slave_callback(trans->initiator2target_buffer_size, split_trans_initiator2target_buffer(trans), trans->initiator2target_buffer_size, split_trans_target2initiator_buffer(trans));
+    }
+    if (trans->target2initiator_buffer_size) {
+        memcpy(wire, split_trans_target2initiator_buffer(trans), trans->target2initiator_buffer_size);
+    }
+    serial_loopback_leave_slave();
+}
+
+static bool initiate_transaction(uint8_t transaction_id) {
+    split_transaction_desc_t *trans = &split_transaction_table[transaction_id];
+    uint8_t                   wire[WIRE_BUFFER_SIZE];
+
+    // Handshake, the slave replies with the id XORed as a simple checksum
+    uint8_t handshake = transaction_id;
+    transfer(&handshake, sizeof(handshake));
+    turn_around();
+    if (handshake >= NUM_TOTAL_TRANSACTIONS) {
+        // The slave ignores it, and the master times out
+        return false;
+    }
+    handshake ^= NUM_TOTAL_TRANSACTIONS;
+    transfer(&handshake, sizeof(handshake));
+    turn_around();
+    if (handshake != (transaction_id ^ NUM_TOTAL_TRANSACTIONS)) {
+        return false;
+    }
+
+    if (trans->initiator2target_buffer_size) {
+        memcpy(wire, split_trans_initiator2target_buffer(trans), trans->initiator2target_buffer_size);
+        if (!transfer_buffer(trans, wire, trans->initiator2target_buffer_size)) {
+            return false;
+        }
+    }
+
+    slave_react(trans, wire);
+
+    if (trans->target2initiator_buffer_size) {
+        turn_around();
+        if (!transfer_buffer(trans, wire, trans->target2initiator_buffer_size)) {
+            return false;
+        }
+        memcpy(split_trans_target2initiator_buffer(trans), wire, trans->target2initiator_buffer_size);
+    }
+    return true;
+}
+
+bool soft_serial_transaction(int index) {
+    if (index >= NUM_TOTAL_TRANSACTIONS) {
+        return false;
+    }
+
+    stats.transactions++;
+    if (!initiate_transaction((uint8_t)index)) {
+        stats.failed_transactions++;
+        return false;
+    }
+    return true;
+}
+
+#ifdef SPLIT_MATRIX_PUSH
+
+bool soft_serial_push(int index) {
+    if (index >= NUM_TOTAL_TRANSACTIONS) {
+        return false;
+    }
+
+    split_transaction_desc_t *trans  = &split_transaction_table[index];
+    uint8_t                   length = trans->target2initiator_buffer_size;
+    if (length == 0 || push_queue_length + length + 3 > PUSH_QUEUE_SIZE) {
+        return false;
+    }
+
+    uint8_t *frame = &push_queue[push_queue_length];
+    frame[0]       = PUSH_MARKER;
+    frame[1]       = index;
+    memcpy(&frame[2], split_trans_target2initiator_buffer(trans), length);
+    frame[2 + length] = crc8(&frame[2], length);
+    transfer(frame, length + 3);
+    push_queue_length += length + 3;
+    stats.pushes++;
+    return true;
+}
+
+// Receives the pushed frames like the master does, dropping anything that doesn't check out
+static void receive_pushed_frames(void) {
+    uint16_t position = 0;
+    while (position < push_queue_length) {
+        if (push_queue[position++] != PUSH_MARKER || position >= push_queue_length) {
+            continue;
+        }
+        uint8_t id = push_queue[position++];
+        if (id >= NUM_TOTAL_TRANSACTIONS) {
+            continue;
+        }
+        split_transaction_desc_t *trans  = &split_transaction_table[id];
+        uint8_t                   length = trans->target2initiator_buffer_size;
+        if (length == 0 || position + length + 1 > push_queue_length) {
+            continue;
+        }
+        if (crc8(&push_queue[position], length) == push_queue[position + length]) {
+            memcpy(split_trans_target2initiator_buffer(trans), &push_queue[position], length);
+            pushed_transactions |= 1UL << id;
+        }
+        position += length + 1;
+    }
+    push_queue_length = 0;
+}
+
+bool soft_serial_pushed(int index) {
+    receive_pushed_frames();
+
+    bool pushed = pushed_transactions & (1UL << index);
+    pushed_transactions &= ~(1UL << index);
+    return pushed;
+}
+
+#endif // SPLIT_MATRIX_PUSH
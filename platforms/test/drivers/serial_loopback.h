@@ -0,0 +1,65 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * \file
+ *
+ * Split serial transport for the test platform, connecting the master and
+ * slave halves in the same process through a simulated link.
+ *
+ * Both halves share the same split_shmem, so the backend keeps the slave's
+ * copy of the shared memory aside and swaps it in whenever slave code runs,
+ * both for the transaction callbacks and between
+ * serial_loopback_enter_slave() and serial_loopback_leave_slave().
+ *
+ * Like the ChibiOS serial protocol, transactions start with a handshake and
+ * the buffers carry no checksum of their own, so bit errors on the link are
+ * only caught by the checksums of the transactions themselves.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    uint32_t baud_rate;      // 10 bits are sent per byte, 0 for a link without transfer time
+    uint32_t latency_us;     // added every time the line changes direction
+    double   bit_error_rate; // probability of any bit on the link being flipped
+} serial_loopback_link_t;
+
+typedef struct {
+    uint32_t transactions;
+    uint32_t failed_transactions;
+    uint32_t pushes;
+    uint32_t bytes;      // bytes sent in both directions
+    uint32_t bit_errors; // bits flipped by the link
+    uint64_t busy_us;    // time spent on the link
+} serial_loopback_stats_t;
+
+/**
+ * \brief Reset both halves' shared memory and the statistics, and set up the link.
+ *
+ * \param seed Seed of the bit error generator, runs with the same seed see the same errors.
+ */
+void serial_loopback_init(const serial_loopback_link_t *link, uint32_t seed);
+
+// Changes the link without resetting the halves
+void serial_loopback_set_link(const serial_loopback_link_t *link);
+
+const serial_loopback_stats_t *serial_loopback_stats(void);
+
+void serial_loopback_reset_stats(void);
+
+// Swap in the slave's shared memory, to run the slave half
+void serial_loopback_enter_slave(void);
+
+void serial_loopback_leave_slave(void);
+
+#ifdef __cplusplus
+}
+#endif
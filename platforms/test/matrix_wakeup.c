@@ -0,0 +1,31 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "matrix_wakeup.h"
+
+static uint32_t idle_count            = 0;
+static bool     interrupt_during_idle = false;
+
+void matrix_wakeup_idle(void) {
+    idle_count++;
+    if (interrupt_during_idle) {
+        interrupt_during_idle = false;
+        matrix_wakeup_trigger();
+    }
+}
+
+uint32_t matrix_wakeup_idle_count(void) {
+    return idle_count;
+}
+
+void reset_matrix_wakeup_idle_count(void) {
+    idle_count = 0;
+}
+
+void simulate_matrix_wakeup_interrupt(void) {
+    matrix_wakeup_trigger();
+}
+
+void simulate_matrix_wakeup_interrupt_during_idle(void) {
+    interrupt_during_idle = true;
+}
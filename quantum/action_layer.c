@@ -1,5 +1,6 @@
 #include <limits.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "keyboard.h"
 #include "action.h"
@@ -316,16 +317,15 @@ action_t store_or_get_action(bool pressed, keypos_t key) {
 #endif
 }
 
-/** \brief Layer switch get layer
+#ifndef NO_ACTION_LAYER
+/** \brief Layer switch find layer
  *
- * Gets the layer based on key info
+ * Scans the active layers from the top for the first non-transparent action
  */
-uint8_t layer_switch_get_layer(keypos_t key) {
-#ifndef NO_ACTION_LAYER
+static uint8_t layer_switch_find_layer(keypos_t key, layer_state_t layers) {
     action_t action;
     action.code = ACTION_TRANSPARENT;
 
-    layer_state_t layers = layer_state | default_layer_state;
     /* check top layer first */
     for (int8_t i = MAX_LAYER - 1; i >= 0; i--) {
         if (layers & ((layer_state_t)1 << i)) {
@@ -337,6 +337,70 @@ uint8_t layer_switch_get_layer(keypos_t key) {
     }
     /* fall back to layer 0 */
     return 0;
+}
+#endif
+
+#if !defined(NO_ACTION_LAYER) && defined(LAYER_LOOKUP_CACHE_ENABLE)
+/** \brief layer lookup cache
+ *
+ * Result of layer_switch_find_layer() per key, stored as layer + 1 so that zero marks an entry to be rescanned
+ */
+static uint8_t       layer_lookup_cache[MATRIX_ROWS][MATRIX_COLS];
+static layer_state_t layer_lookup_cache_state = 0;
+
+/** \brief Layer lookup cache invalidate
+ *
+ * Discards all cached lookups, needs to be called whenever the keymap is modified
+ */
+void layer_lookup_cache_invalidate(void) {
+    memset(layer_lookup_cache, 0, sizeof(layer_lookup_cache));
+}
+
+/** \brief Layer lookup cache sync
+ *
+ * Discards the cached lookups affected by a layer state change since the last lookup.
+ * A lookup resolved to layer L remains valid while L is active and no layer above L was
+ * turned on, as any other active layers above L were already found to be transparent.
+ */
+static void layer_lookup_cache_sync(layer_state_t layers) {
+    if (layers == layer_lookup_cache_state) {
+        return;
+    }
+
+    layer_state_t enabled = layers & ~layer_lookup_cache_state;
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            uint8_t entry = layer_lookup_cache[row][col];
+            if (entry == 0) {
+                continue;
+            }
+            uint8_t layer = entry - 1;
+            if (!(layers & ((layer_state_t)1 << layer)) || (enabled >> layer) > 1) {
+                layer_lookup_cache[row][col] = 0;
+            }
+        }
+    }
+    layer_lookup_cache_state = layers;
+}
+#endif
+
+/** \brief Layer switch get layer
+ *
+ * Gets the layer based on key info
+ */
+uint8_t layer_switch_get_layer(keypos_t key) {
+#ifndef NO_ACTION_LAYER
+    layer_state_t layers = layer_state | default_layer_state;
+#    ifdef LAYER_LOOKUP_CACHE_ENABLE
+    if (key.row < MATRIX_ROWS && key.col < MATRIX_COLS) {
+        layer_lookup_cache_sync(layers);
+        if (layer_lookup_cache[key.row][key.col] == 0) {
+            layer_lookup_cache[key.row][key.col] = layer_switch_find_layer(key, layers) + 1;
+        }
+        return layer_lookup_cache[key.row][key.col] - 1;
+    }
+#    endif
+    return layer_switch_find_layer(key, layers);
 #else
     return get_highest_layer(default_layer_state);
 #endif
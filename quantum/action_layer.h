@@ -166,5 +166,12 @@ action_t store_or_get_action(bool pressed, keypos_t key);
 /* return the topmost non-transparent layer currently associated with key */
 uint8_t layer_switch_get_layer(keypos_t key);
 
+/* discard the cached results of layer_switch_get_layer() after modifying the keymap */
+#if !defined(NO_ACTION_LAYER) && defined(LAYER_LOOKUP_CACHE_ENABLE)
+void layer_lookup_cache_invalidate(void);
+#else
+#    define layer_lookup_cache_invalidate()
+#endif
+
 /* return action depending on current layer status */
 action_t layer_switch_get_action(keypos_t key);
@@ -25,13 +25,7 @@ releasing a key, that state is pushed after no changes occur for DEBOUNCE millis
 
 #include "debounce.h"
 #include "timer.h"
-#include <stdlib.h>
-
-#ifdef PROTOCOL_CHIBIOS
-#    if CH_CFG_USE_MEMCORE == FALSE
-#        error ChibiOS is configured without a memory allocator. Your keyboard may have set `#define CH_CFG_USE_MEMCORE FALSE`, which is incompatible with this debounce algorithm.
-#    endif
-#endif
+#include <string.h>
 
 #ifndef DEBOUNCE
 #    define DEBOUNCE 5
@@ -45,17 +39,19 @@ releasing a key, that state is pushed after no changes occur for DEBOUNCE millis
 
 #define ROW_SHIFTER ((matrix_row_t)1)
 
-typedef struct {
-    bool    pressed : 1;
-    uint8_t time : 7;
-} debounce_counter_t;
+// Counters hold the remaining time, with the top bit set for key-down changes
+#define DEBOUNCE_COUNTER_MAX (DEBOUNCE * 2 + 1)
+#include "debounce_counters.h"
+
+#define COUNTER_PRESSED (1 << (DEBOUNCE_COUNTER_WIDTH - 1))
+#define COUNTER_TIME(counter) ((counter) & (COUNTER_PRESSED - 1))
 
 #if DEBOUNCE > 0
-static debounce_counter_t *debounce_counters;
-static fast_timer_t        last_time;
-static bool                counters_need_update;
-static bool                matrix_need_update;
-static bool                cooked_changed;
+static uint8_t      debounce_counters[DEBOUNCE_COUNTERS_SIZE(DEBOUNCE_ROWS * MATRIX_COLS)];
+static fast_timer_t debounce_last_time;
+static bool         debounce_counters_need_update;
+static bool         debounce_matrix_need_update;
+static bool         debounce_cooked_changed;
 
 #    define DEBOUNCE_ELAPSED 0
 
@@ -64,30 +60,23 @@ static void transfer_matrix_values(matrix_row_t raw[], matrix_row_t cooked[], ui
 
 // we use num_rows rather than MATRIX_ROWS to support split keyboards
 void debounce_init(uint8_t num_rows) {
-    debounce_counters = malloc(num_rows * MATRIX_COLS * sizeof(debounce_counter_t));
-    int i             = 0;
-    for (uint8_t r = 0; r < num_rows; r++) {
-        for (uint8_t c = 0; c < MATRIX_COLS; c++) {
-            debounce_counters[i++].time = DEBOUNCE_ELAPSED;
-        }
-    }
+    memset(debounce_counters, DEBOUNCE_ELAPSED, sizeof(debounce_counters));
 }
 
-void debounce_free(void) {
-    free(debounce_counters);
-    debounce_counters = NULL;
-}
+void debounce_free(void) {}
 
 bool debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) {
-    bool updated_last = false;
-    cooked_changed    = false;
+    num_rows = debounce_clamp_rows(num_rows);
+
+    bool updated_last       = false;
+    debounce_cooked_changed = false;
 
-    if (counters_need_update) {
+    if (debounce_counters_need_update) {
         fast_timer_t now          = timer_read_fast();
-        fast_timer_t elapsed_time = TIMER_DIFF_FAST(now, last_time);
+        fast_timer_t elapsed_time = TIMER_DIFF_FAST(now, debounce_last_time);
 
-        last_time    = now;
-        updated_last = true;
+        debounce_last_time = now;
+        updated_last       = true;
         if (elapsed_time > UINT8_MAX) {
             elapsed_time = UINT8_MAX;
         }
@@ -97,79 +86,79 @@ bool debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool
         }
     }
 
-    if (changed || matrix_need_update) {
+    if (changed || debounce_matrix_need_update) {
         if (!updated_last) {
-            last_time = timer_read_fast();
+            debounce_last_time = timer_read_fast();
         }
 
         transfer_matrix_values(raw, cooked, num_rows);
     }
 
-    return cooked_changed;
+    return debounce_cooked_changed;
 }
 
 static void update_debounce_counters_and_transfer_if_expired(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, uint8_t elapsed_time) {
-    debounce_counter_t *debounce_pointer = debounce_counters;
+    uint16_t index = 0;
 
-    counters_need_update = false;
-    matrix_need_update   = false;
+    debounce_counters_need_update = false;
+    debounce_matrix_need_update   = false;
 
     for (uint8_t row = 0; row < num_rows; row++) {
-        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++, index++) {
             matrix_row_t col_mask = (ROW_SHIFTER << col);
+            uint8_t      counter  = debounce_counter_get(debounce_counters, index);
 
-            if (debounce_pointer->time != DEBOUNCE_ELAPSED) {
-                if (debounce_pointer->time <= elapsed_time) {
-                    debounce_pointer->time = DEBOUNCE_ELAPSED;
+            if (COUNTER_TIME(counter) != DEBOUNCE_ELAPSED) {
+                if (COUNTER_TIME(counter) <= elapsed_time) {
+                    debounce_counter_set(debounce_counters, index, (counter & COUNTER_PRESSED) | DEBOUNCE_ELAPSED);
 
-                    if (debounce_pointer->pressed) {
+                    if (counter & COUNTER_PRESSED) {
                         // key-down: eager
-                        matrix_need_update = true;
+                        debounce_matrix_need_update = true;
                     } else {
                         // key-up: defer
                         matrix_row_t cooked_next = (cooked[row] & ~col_mask) | (raw[row] & col_mask);
-                        cooked_changed |= cooked_next ^ cooked[row];
+                        debounce_cooked_changed |= cooked_next ^ cooked[row];
                         cooked[row] = cooked_next;
                     }
                 } else {
-                    debounce_pointer->time -= elapsed_time;
-                    counters_need_update = true;
+                    debounce_counter_set(debounce_counters, index, counter - elapsed_time);
+                    debounce_counters_need_update = true;
                 }
             }
-            debounce_pointer++;
         }
     }
 }
 
 static void transfer_matrix_values(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows) {
-    debounce_counter_t *debounce_pointer = debounce_counters;
+    uint16_t index = 0;
 
-    matrix_need_update = false;
+    debounce_matrix_need_update = false;
 
     for (uint8_t row = 0; row < num_rows; row++) {
         matrix_row_t delta = raw[row] ^ cooked[row];
-        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++, index++) {
             matrix_row_t col_mask = (ROW_SHIFTER << col);
+            uint8_t      counter  = debounce_counter_get(debounce_counters, index);
 
             if (delta & col_mask) {
-                if (debounce_pointer->time == DEBOUNCE_ELAPSED) {
-                    debounce_pointer->pressed = (raw[row] & col_mask);
-                    debounce_pointer->time    = DEBOUNCE;
-                    counters_need_update      = true;
+                if (COUNTER_TIME(counter) == DEBOUNCE_ELAPSED) {
+                    bool pressed = (raw[row] & col_mask);
+                    debounce_counter_set(debounce_counters, index, (pressed ? COUNTER_PRESSED : 0) | DEBOUNCE);
+                    debounce_counters_need_update = true;
 
-                    if (debounce_pointer->pressed) {
+                    if (pressed) {
                         // key-down: eager
                         cooked[row] ^= col_mask;
-                        cooked_changed = true;
+                        debounce_cooked_changed = true;
                     }
                 }
-            } else if (debounce_pointer->time != DEBOUNCE_ELAPSED) {
-                if (!debounce_pointer->pressed) {
+            } else if (COUNTER_TIME(counter) != DEBOUNCE_ELAPSED) {
+                if (!(counter & COUNTER_PRESSED)) {
                     // key-up: defer
-                    debounce_pointer->time = DEBOUNCE_ELAPSED;
+                    debounce_counter_set(debounce_counters, index, DEBOUNCE_ELAPSED);
                 }
             }
-            debounce_pointer++;
         }
     }
 }
@@ -0,0 +1,66 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+Statically allocated counter storage shared by the debounce algorithms.
+
+Define DEBOUNCE_COUNTER_MAX to the largest value a counter has to hold before
+including this file. Counters are packed two to a byte when that fits in a
+nibble, otherwise they take a byte each.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include "matrix.h"
+
+#ifndef DEBOUNCE_COUNTER_MAX
+#    error "DEBOUNCE_COUNTER_MAX has to be defined before including debounce_counters.h"
+#endif
+
+// Split keyboards only debounce the rows of their own half
+#ifndef DEBOUNCE_ROWS
+#    ifdef SPLIT_KEYBOARD
+#        define DEBOUNCE_ROWS (MATRIX_ROWS / 2)
+#    else
+#        define DEBOUNCE_ROWS (MATRIX_ROWS)
+#    endif
+#endif
+
+// Can be set to 8 to trade RAM for slightly faster counter access
+#ifndef DEBOUNCE_COUNTER_WIDTH
+#    if DEBOUNCE_COUNTER_MAX < 16
+#        define DEBOUNCE_COUNTER_WIDTH 4
+#    else
+#        define DEBOUNCE_COUNTER_WIDTH 8
+#    endif
+#endif
+
+#if DEBOUNCE_COUNTER_WIDTH == 4 && DEBOUNCE_COUNTER_MAX >= 16
+#    error "DEBOUNCE_COUNTER_MAX does not fit in 4-bit counters, set DEBOUNCE_COUNTER_WIDTH to 8"
+#endif
+
+// The state only covers DEBOUNCE_ROWS rows, so any rows past those are left alone
+static inline uint8_t debounce_clamp_rows(uint8_t num_rows) {
+    return num_rows < DEBOUNCE_ROWS ? num_rows : DEBOUNCE_ROWS;
+}
+
+// Bytes of storage needed for the given number of counters
+#define DEBOUNCE_COUNTERS_SIZE(count) (((count) * DEBOUNCE_COUNTER_WIDTH + 7) / 8)
+
+static inline uint8_t debounce_counter_get(const uint8_t *counters, uint16_t index) {
+#if DEBOUNCE_COUNTER_WIDTH == 4
+    return (counters[index / 2] >> ((index & 1) * 4)) & 0x0F;
+#else
+    return counters[index];
+#endif
+}
+
+static inline void debounce_counter_set(uint8_t *counters, uint16_t index, uint8_t value) {
+#if DEBOUNCE_COUNTER_WIDTH == 4
+    uint8_t shift       = (index & 1) * 4;
+    counters[index / 2] = (counters[index / 2] & ~(0x0F << shift)) | (value << shift);
+#else
+    counters[index] = value;
+#endif
+}
@@ -31,8 +31,8 @@ When no state changes have occured for DEBOUNCE milliseconds, we push the state.
 #endif
 
 #if DEBOUNCE > 0
-static bool         debouncing = false;
-static fast_timer_t debouncing_time;
+static bool         debounce_pending = false;
+static fast_timer_t debounce_time;
 
 void debounce_init(uint8_t num_rows) {}
 
@@ -40,15 +40,15 @@ bool debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool
     bool cooked_changed = false;
 
     if (changed) {
-        debouncing      = true;
-        debouncing_time = timer_read_fast();
-    } else if (debouncing && timer_elapsed_fast(debouncing_time) >= DEBOUNCE) {
+        debounce_pending = true;
+        debounce_time    = timer_read_fast();
+    } else if (debounce_pending && timer_elapsed_fast(debounce_time) >= DEBOUNCE) {
         size_t matrix_size = num_rows * sizeof(matrix_row_t);
         if (memcmp(cooked, raw, matrix_size) != 0) {
             memcpy(cooked, raw, matrix_size);
             cooked_changed = true;
         }
-        debouncing = false;
+        debounce_pending = false;
     }
 
     return cooked_changed;
@@ -15,19 +15,13 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
 /*
-Basic symmetric per-key algorithm. Uses an 8-bit counter per key.
+Basic symmetric per-key algorithm. Uses an 8-bit counter per key, or a 4-bit one if DEBOUNCE < 16.
 When no state changes have occured for DEBOUNCE milliseconds, we push the state.
 */
 
 #include "debounce.h"
 #include "timer.h"
-#include <stdlib.h>
-
-#ifdef PROTOCOL_CHIBIOS
-#    if CH_CFG_USE_MEMCORE == FALSE
-#        error ChibiOS is configured without a memory allocator. Your keyboard may have set `#define CH_CFG_USE_MEMCORE FALSE`, which is incompatible with this debounce algorithm.
-#    endif
-#endif
+#include <string.h>
 
 #ifndef DEBOUNCE
 #    define DEBOUNCE 5
@@ -41,13 +35,14 @@ When no state changes have occured for DEBOUNCE milliseconds, we push the state.
 
 #define ROW_SHIFTER ((matrix_row_t)1)
 
-typedef uint8_t debounce_counter_t;
+#define DEBOUNCE_COUNTER_MAX DEBOUNCE
+#include "debounce_counters.h"
 
 #if DEBOUNCE > 0
-static debounce_counter_t *debounce_counters;
-static fast_timer_t        last_time;
-static bool                counters_need_update;
-static bool                cooked_changed;
+static uint8_t      debounce_counters[DEBOUNCE_COUNTERS_SIZE(DEBOUNCE_ROWS * MATRIX_COLS)];
+static fast_timer_t debounce_last_time;
+static bool         debounce_counters_need_update;
+static bool         debounce_cooked_changed;
 
 #    define DEBOUNCE_ELAPSED 0
 
@@ -56,30 +51,23 @@ static void start_debounce_counters(matrix_row_t raw[], matrix_row_t cooked[], u
 
 // we use num_rows rather than MATRIX_ROWS to support split keyboards
 void debounce_init(uint8_t num_rows) {
-    debounce_counters = (debounce_counter_t *)malloc(num_rows * MATRIX_COLS * sizeof(debounce_counter_t));
-    int i             = 0;
-    for (uint8_t r = 0; r < num_rows; r++) {
-        for (uint8_t c = 0; c < MATRIX_COLS; c++) {
-            debounce_counters[i++] = DEBOUNCE_ELAPSED;
-        }
-    }
+    memset(debounce_counters, DEBOUNCE_ELAPSED, sizeof(debounce_counters));
 }
 
-void debounce_free(void) {
-    free(debounce_counters);
-    debounce_counters = NULL;
-}
+void debounce_free(void) {}
 
 bool debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) {
-    bool updated_last = false;
-    cooked_changed    = false;
+    num_rows = debounce_clamp_rows(num_rows);
+
+    bool updated_last       = false;
+    debounce_cooked_changed = false;
 
-    if (counters_need_update) {
+    if (debounce_counters_need_update) {
         fast_timer_t now          = timer_read_fast();
-        fast_timer_t elapsed_time = TIMER_DIFF_FAST(now, last_time);
+        fast_timer_t elapsed_time = TIMER_DIFF_FAST(now, debounce_last_time);
 
-        last_time    = now;
-        updated_last = true;
+        debounce_last_time = now;
+        updated_last       = true;
         if (elapsed_time > UINT8_MAX) {
             elapsed_time = UINT8_MAX;
         }
@@ -91,50 +79,49 @@ bool debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool
 
     if (changed) {
         if (!updated_last) {
-            last_time = timer_read_fast();
+            debounce_last_time = timer_read_fast();
         }
 
         start_debounce_counters(raw, cooked, num_rows);
     }
 
-    return cooked_changed;
+    return debounce_cooked_changed;
 }
 
 static void update_debounce_counters_and_transfer_if_expired(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, uint8_t elapsed_time) {
-    counters_need_update                 = false;
-    debounce_counter_t *debounce_pointer = debounce_counters;
+    debounce_counters_need_update = false;
+    uint16_t index       = 0;
     for (uint8_t row = 0; row < num_rows; row++) {
-        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
-            if (*debounce_pointer != DEBOUNCE_ELAPSED) {
-                if (*debounce_pointer <= elapsed_time) {
-                    *debounce_pointer        = DEBOUNCE_ELAPSED;
+        for (uint8_t col = 0; col < MATRIX_COLS; col++, index++) {
+            uint8_t counter = debounce_counter_get(debounce_counters, index);
+            if (counter != DEBOUNCE_ELAPSED) {
+                if (counter <= elapsed_time) {
+                    debounce_counter_set(debounce_counters, index, DEBOUNCE_ELAPSED);
                     matrix_row_t cooked_next = (cooked[row] & ~(ROW_SHIFTER << col)) | (raw[row] & (ROW_SHIFTER << col));
-                    cooked_changed |= cooked[row] ^ cooked_next;
+                    debounce_cooked_changed |= cooked[row] ^ cooked_next;
                     cooked[row] = cooked_next;
                 } else {
-                    *debounce_pointer -= elapsed_time;
-                    counters_need_update = true;
+                    debounce_counter_set(debounce_counters, index, counter - elapsed_time);
+                    debounce_counters_need_update = true;
                 }
             }
-            debounce_pointer++;
         }
     }
 }
 
 static void start_debounce_counters(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows) {
-    debounce_counter_t *debounce_pointer = debounce_counters;
+    uint16_t index = 0;
     for (uint8_t row = 0; row < num_rows; row++) {
         matrix_row_t delta = raw[row] ^ cooked[row];
-        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++, index++) {
             if (delta & (ROW_SHIFTER << col)) {
-                if (*debounce_pointer == DEBOUNCE_ELAPSED) {
-                    *debounce_pointer    = DEBOUNCE;
-                    counters_need_update = true;
+                if (debounce_counter_get(debounce_counters, index) == DEBOUNCE_ELAPSED) {
+                    debounce_counter_set(debounce_counters, index, DEBOUNCE);
+                    debounce_counters_need_update = true;
                 }
             } else {
-                *debounce_pointer = DEBOUNCE_ELAPSED;
+                debounce_counter_set(debounce_counters, index, DEBOUNCE_ELAPSED);
             }
-            debounce_pointer++;
         }
     }
 }
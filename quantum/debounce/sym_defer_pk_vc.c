@@ -0,0 +1,178 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+Basic symmetric per-key algorithm, with the same behaviour as sym_defer_pk.
+When no state changes have occured for DEBOUNCE milliseconds, we push the state.
+
+Rather than keeping a byte per key, the per-key counters are bit-sliced into
+vertical counters: bit n of every counter in a row is stored in one
+matrix_row_t, so a whole row of counters is updated with a handful of
+word-wide operations instead of a loop over the columns.
+*/
+
+#include "debounce.h"
+#include "timer.h"
+#include <string.h>
+
+#ifndef DEBOUNCE
+#    define DEBOUNCE 5
+#endif
+
+// Maximum debounce: 255ms
+#if DEBOUNCE > UINT8_MAX
+#    undef DEBOUNCE
+#    define DEBOUNCE UINT8_MAX
+#endif
+
+// Number of bits needed to hold a counter value of DEBOUNCE
+#if DEBOUNCE > 127
+#    define DEBOUNCE_COUNTER_BITS 8
+#elif DEBOUNCE > 63
+#    define DEBOUNCE_COUNTER_BITS 7
+#elif DEBOUNCE > 31
+#    define DEBOUNCE_COUNTER_BITS 6
+#elif DEBOUNCE > 15
+#    define DEBOUNCE_COUNTER_BITS 5
+#elif DEBOUNCE > 7
+#    define DEBOUNCE_COUNTER_BITS 4
+#elif DEBOUNCE > 3
+#    define DEBOUNCE_COUNTER_BITS 3
+#elif DEBOUNCE > 1
+#    define DEBOUNCE_COUNTER_BITS 2
+#else
+#    define DEBOUNCE_COUNTER_BITS 1
+#endif
+
+// Only used for DEBOUNCE_ROWS, the counters are bit-sliced instead
+#define DEBOUNCE_COUNTER_MAX DEBOUNCE
+#include "debounce_counters.h"
+
+typedef struct {
+    matrix_row_t bits[DEBOUNCE_COUNTER_BITS];
+} debounce_counter_row_t;
+
+#if DEBOUNCE > 0
+static debounce_counter_row_t debounce_counters[DEBOUNCE_ROWS];
+static fast_timer_t           debounce_last_time;
+static bool                   debounce_counters_need_update;
+static bool                   debounce_cooked_changed;
+
+static void update_debounce_counters_and_transfer_if_expired(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, uint8_t elapsed_time);
+static void start_debounce_counters(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows);
+
+// we use num_rows rather than MATRIX_ROWS to support split keyboards
+void debounce_init(uint8_t num_rows) {
+    memset(debounce_counters, 0, sizeof(debounce_counters));
+}
+
+void debounce_free(void) {}
+
+bool debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) {
+    num_rows = debounce_clamp_rows(num_rows);
+
+    bool updated_last       = false;
+    debounce_cooked_changed = false;
+
+    if (debounce_counters_need_update) {
+        fast_timer_t now          = timer_read_fast();
+        fast_timer_t elapsed_time = TIMER_DIFF_FAST(now, debounce_last_time);
+
+        debounce_last_time = now;
+        updated_last       = true;
+        if (elapsed_time > UINT8_MAX) {
+            elapsed_time = UINT8_MAX;
+        }
+
+        if (elapsed_time > 0) {
+            update_debounce_counters_and_transfer_if_expired(raw, cooked, num_rows, elapsed_time);
+        }
+    }
+
+    if (changed) {
+        if (!updated_last) {
+            debounce_last_time = timer_read_fast();
+        }
+
+        start_debounce_counters(raw, cooked, num_rows);
+    }
+
+    return debounce_cooked_changed;
+}
+
+static void update_debounce_counters_and_transfer_if_expired(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, uint8_t elapsed_time) {
+    debounce_counters_need_update = false;
+
+    // Every running counter is at most DEBOUNCE, so anything longer expires all of them
+    if (elapsed_time > DEBOUNCE) {
+        elapsed_time = DEBOUNCE;
+    }
+
+    for (uint8_t row = 0; row < num_rows; row++) {
+        debounce_counter_row_t *counter = &debounce_counters[row];
+
+        matrix_row_t running = 0;
+        for (uint8_t bit = 0; bit < DEBOUNCE_COUNTER_BITS; bit++) {
+            running |= counter->bits[bit];
+        }
+        if (!running) {
+            continue;
+        }
+
+        // Ripple-borrow subtraction of elapsed_time from every counter in the row at once
+        matrix_row_t borrow    = 0;
+        matrix_row_t remaining = 0;
+        for (uint8_t bit = 0; bit < DEBOUNCE_COUNTER_BITS; bit++) {
+            matrix_row_t value    = counter->bits[bit];
+            matrix_row_t subtract = (elapsed_time & (1 << bit)) ? ~(matrix_row_t)0 : 0;
+
+            counter->bits[bit] = value ^ subtract ^ borrow;
+            borrow             = (~value & (subtract | borrow)) | (value & subtract & borrow);
+            remaining |= counter->bits[bit];
+        }
+
+        // Counters that reached or went past zero have expired, and idle
+        // counters wrapped around so have to be cleared again
+        matrix_row_t expired = running & (borrow | ~remaining);
+        for (uint8_t bit = 0; bit < DEBOUNCE_COUNTER_BITS; bit++) {
+            counter->bits[bit] &= running & ~expired;
+        }
+
+        if (expired) {
+            matrix_row_t cooked_next = (cooked[row] & ~expired) | (raw[row] & expired);
+            debounce_cooked_changed |= cooked[row] ^ cooked_next;
+            cooked[row] = cooked_next;
+        }
+        if (running & ~expired) {
+            debounce_counters_need_update = true;
+        }
+    }
+}
+
+static void start_debounce_counters(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows) {
+    for (uint8_t row = 0; row < num_rows; row++) {
+        debounce_counter_row_t *counter = &debounce_counters[row];
+        matrix_row_t            delta   = raw[row] ^ cooked[row];
+
+        matrix_row_t running = 0;
+        for (uint8_t bit = 0; bit < DEBOUNCE_COUNTER_BITS; bit++) {
+            running |= counter->bits[bit];
+        }
+
+        // Keys that changed start counting down from DEBOUNCE, all others are reset
+        matrix_row_t start = delta & ~running;
+        for (uint8_t bit = 0; bit < DEBOUNCE_COUNTER_BITS; bit++) {
+            counter->bits[bit] &= delta;
+            if (DEBOUNCE & (1 << bit)) {
+                counter->bits[bit] |= start;
+            }
+        }
+        if (start) {
+            debounce_counters_need_update = true;
+        }
+    }
+}
+
+#else
+#    include "none.c"
+#endif
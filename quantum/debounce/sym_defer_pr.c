@@ -19,53 +19,58 @@ DEBOUNCE milliseconds have elapsed since the last change.
 
 #include "debounce.h"
 #include "timer.h"
-#include <stdlib.h>
+#include <string.h>
 
 #ifndef DEBOUNCE
 #    define DEBOUNCE 5
 #endif
 
-static uint16_t last_time;
+// Maximum debounce: 255ms
+#if DEBOUNCE > UINT8_MAX
+#    undef DEBOUNCE
+#    define DEBOUNCE UINT8_MAX
+#endif
+
+#define DEBOUNCE_COUNTER_MAX DEBOUNCE
+#include "debounce_counters.h"
+
+static uint16_t debounce_last_time;
 // [row] milliseconds until key's state is considered debounced.
-static uint8_t* countdowns;
+static uint8_t debounce_countdowns[DEBOUNCE_COUNTERS_SIZE(DEBOUNCE_ROWS)];
 // [row]
-static matrix_row_t* last_raw;
+static matrix_row_t debounce_last_raw[DEBOUNCE_ROWS];
 
 void debounce_init(uint8_t num_rows) {
-    countdowns = (uint8_t*)calloc(num_rows, sizeof(uint8_t));
-    last_raw   = (matrix_row_t*)calloc(num_rows, sizeof(matrix_row_t));
+    memset(debounce_countdowns, 0, sizeof(debounce_countdowns));
+    memset(debounce_last_raw, 0, sizeof(debounce_last_raw));
 
-    last_time = timer_read();
+    debounce_last_time = timer_read();
 }
 
-void debounce_free(void) {
-    free(countdowns);
-    countdowns = NULL;
-    free(last_raw);
-    last_raw = NULL;
-}
+void debounce_free(void) {}
 
 bool debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) {
+    num_rows = debounce_clamp_rows(num_rows);
+
     uint16_t now           = timer_read();
-    uint16_t elapsed16     = TIMER_DIFF_16(now, last_time);
-    last_time              = now;
+    uint16_t elapsed16     = TIMER_DIFF_16(now, debounce_last_time);
+    debounce_last_time     = now;
     uint8_t elapsed        = (elapsed16 > 255) ? 255 : elapsed16;
     bool    cooked_changed = false;
 
-    uint8_t* countdown = countdowns;
-
-    for (uint8_t row = 0; row < num_rows; ++row, ++countdown) {
-        matrix_row_t raw_row = raw[row];
+    for (uint8_t row = 0; row < num_rows; ++row) {
+        matrix_row_t raw_row   = raw[row];
+        uint8_t      countdown = debounce_counter_get(debounce_countdowns, row);
 
-        if (raw_row != last_raw[row]) {
-            *countdown    = DEBOUNCE;
-            last_raw[row] = raw_row;
-        } else if (*countdown > elapsed) {
-            *countdown -= elapsed;
-        } else if (*countdown) {
+        if (raw_row != debounce_last_raw[row]) {
+            debounce_counter_set(debounce_countdowns, row, DEBOUNCE);
+            debounce_last_raw[row] = raw_row;
+        } else if (countdown > elapsed) {
+            debounce_counter_set(debounce_countdowns, row, countdown - elapsed);
+        } else if (countdown) {
             cooked_changed |= cooked[row] ^ raw_row;
             cooked[row] = raw_row;
-            *countdown  = 0;
+            debounce_counter_set(debounce_countdowns, row, 0);
         }
     }
 
@@ -14,20 +14,14 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
 /*
-Basic per-key algorithm. Uses an 8-bit counter per key.
+Basic per-key algorithm. Uses an 8-bit counter per key, or a 4-bit one if DEBOUNCE < 16.
 After pressing a key, it immediately changes state, and sets a counter.
 No further inputs are accepted until DEBOUNCE milliseconds have occurred.
 */
 
 #include "debounce.h"
 #include "timer.h"
-#include <stdlib.h>
-
-#ifdef PROTOCOL_CHIBIOS
-#    if CH_CFG_USE_MEMCORE == FALSE
-#        error ChibiOS is configured without a memory allocator. Your keyboard may have set `#define CH_CFG_USE_MEMCORE FALSE`, which is incompatible with this debounce algorithm.
-#    endif
-#endif
+#include <string.h>
 
 #ifndef DEBOUNCE
 #    define DEBOUNCE 5
@@ -41,14 +35,15 @@ No further inputs are accepted until DEBOUNCE milliseconds have occurred.
 
 #define ROW_SHIFTER ((matrix_row_t)1)
 
-typedef uint8_t debounce_counter_t;
+#define DEBOUNCE_COUNTER_MAX DEBOUNCE
+#include "debounce_counters.h"
 
 #if DEBOUNCE > 0
-static debounce_counter_t *debounce_counters;
-static fast_timer_t        last_time;
-static bool                counters_need_update;
-static bool                matrix_need_update;
-static bool                cooked_changed;
+static uint8_t      debounce_counters[DEBOUNCE_COUNTERS_SIZE(DEBOUNCE_ROWS * MATRIX_COLS)];
+static fast_timer_t debounce_last_time;
+static bool         debounce_counters_need_update;
+static bool         debounce_matrix_need_update;
+static bool         debounce_cooked_changed;
 
 #    define DEBOUNCE_ELAPSED 0
 
@@ -57,30 +52,23 @@ static void transfer_matrix_values(matrix_row_t raw[], matrix_row_t cooked[], ui
 
 // we use num_rows rather than MATRIX_ROWS to support split keyboards
 void debounce_init(uint8_t num_rows) {
-    debounce_counters = (debounce_counter_t *)malloc(num_rows * MATRIX_COLS * sizeof(debounce_counter_t));
-    int i             = 0;
-    for (uint8_t r = 0; r < num_rows; r++) {
-        for (uint8_t c = 0; c < MATRIX_COLS; c++) {
-            debounce_counters[i++] = DEBOUNCE_ELAPSED;
-        }
-    }
+    memset(debounce_counters, DEBOUNCE_ELAPSED, sizeof(debounce_counters));
 }
 
-void debounce_free(void) {
-    free(debounce_counters);
-    debounce_counters = NULL;
-}
+void debounce_free(void) {}
 
 bool debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) {
-    bool updated_last = false;
-    cooked_changed    = false;
+    num_rows = debounce_clamp_rows(num_rows);
+
+    bool updated_last       = false;
+    debounce_cooked_changed = false;
 
-    if (counters_need_update) {
+    if (debounce_counters_need_update) {
         fast_timer_t now          = timer_read_fast();
-        fast_timer_t elapsed_time = TIMER_DIFF_FAST(now, last_time);
+        fast_timer_t elapsed_time = TIMER_DIFF_FAST(now, debounce_last_time);
 
-        last_time    = now;
-        updated_last = true;
+        debounce_last_time = now;
+        updated_last       = true;
         if (elapsed_time > UINT8_MAX) {
             elapsed_time = UINT8_MAX;
         }
@@ -90,56 +78,55 @@ bool debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool
         }
     }
 
-    if (changed || matrix_need_update) {
+    if (changed || debounce_matrix_need_update) {
         if (!updated_last) {
-            last_time = timer_read_fast();
+            debounce_last_time = timer_read_fast();
         }
 
         transfer_matrix_values(raw, cooked, num_rows);
     }
 
-    return cooked_changed;
+    return debounce_cooked_changed;
 }
 
 // If the current time is > debounce counter, set the counter to enable input.
 static void update_debounce_counters(uint8_t num_rows, uint8_t elapsed_time) {
-    counters_need_update                 = false;
-    matrix_need_update                   = false;
-    debounce_counter_t *debounce_pointer = debounce_counters;
+    debounce_counters_need_update = false;
+    debounce_matrix_need_update   = false;
+    uint16_t index       = 0;
     for (uint8_t row = 0; row < num_rows; row++) {
-        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
-            if (*debounce_pointer != DEBOUNCE_ELAPSED) {
-                if (*debounce_pointer <= elapsed_time) {
-                    *debounce_pointer  = DEBOUNCE_ELAPSED;
-                    matrix_need_update = true;
+        for (uint8_t col = 0; col < MATRIX_COLS; col++, index++) {
+            uint8_t counter = debounce_counter_get(debounce_counters, index);
+            if (counter != DEBOUNCE_ELAPSED) {
+                if (counter <= elapsed_time) {
+                    debounce_counter_set(debounce_counters, index, DEBOUNCE_ELAPSED);
+                    debounce_matrix_need_update = true;
                 } else {
-                    *debounce_pointer -= elapsed_time;
-                    counters_need_update = true;
+                    debounce_counter_set(debounce_counters, index, counter - elapsed_time);
+                    debounce_counters_need_update = true;
                 }
             }
-            debounce_pointer++;
         }
     }
 }
 
 // upload from raw_matrix to final matrix;
 static void transfer_matrix_values(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows) {
-    matrix_need_update                   = false;
-    debounce_counter_t *debounce_pointer = debounce_counters;
+    debounce_matrix_need_update = false;
+    uint16_t index     = 0;
     for (uint8_t row = 0; row < num_rows; row++) {
         matrix_row_t delta        = raw[row] ^ cooked[row];
         matrix_row_t existing_row = cooked[row];
-        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++, index++) {
             matrix_row_t col_mask = (ROW_SHIFTER << col);
             if (delta & col_mask) {
-                if (*debounce_pointer == DEBOUNCE_ELAPSED) {
-                    *debounce_pointer    = DEBOUNCE;
-                    counters_need_update = true;
+                if (debounce_counter_get(debounce_counters, index) == DEBOUNCE_ELAPSED) {
+                    debounce_counter_set(debounce_counters, index, DEBOUNCE);
+                    debounce_counters_need_update = true;
                     existing_row ^= col_mask; // flip the bit.
-                    cooked_changed = true;
+                    debounce_cooked_changed = true;
                 }
             }
-            debounce_pointer++;
         }
         cooked[row] = existing_row;
     }
@@ -17,6 +17,7 @@
 #include "dynamic_keymap.h"
 #include "keymap_introspection.h"
 #include "action.h"
+#include "action_layer.h"
 #include "eeprom.h"
 #include "progmem.h"
 #include "send_string.h"
@@ -101,6 +102,75 @@ _Static_assert((DYNAMIC_KEYMAP_EEPROM_MAX_ADDR) - (DYNAMIC_KEYMAP_MACRO_EEPROM_A
 #    define DYNAMIC_KEYMAP_MACRO_DELAY TAP_CODE_DELAY
 #endif
 
+#ifdef DYNAMIC_KEYMAP_CACHE_ENABLE
+#    ifndef DYNAMIC_KEYMAP_CACHE_LAYER_COUNT
+#        define DYNAMIC_KEYMAP_CACHE_LAYER_COUNT DYNAMIC_KEYMAP_LAYER_COUNT
+#    endif
+
+#    if DYNAMIC_KEYMAP_CACHE_LAYER_COUNT > DYNAMIC_KEYMAP_LAYER_COUNT
+#        error DYNAMIC_KEYMAP_CACHE_LAYER_COUNT cannot exceed DYNAMIC_KEYMAP_LAYER_COUNT
+#    endif
+
+// RAM mirrors of the EEPROM contents, kept in the same big endian layout.
+// All EEPROM access in this file goes through dynamic_keymap_read_byte()
+// and dynamic_keymap_update_byte() below, which keeps them coherent.
+static uint8_t keymap_cache[DYNAMIC_KEYMAP_CACHE_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2];
+#    ifdef ENCODER_MAP_ENABLE
+static uint8_t encoder_cache[DYNAMIC_KEYMAP_CACHE_LAYER_COUNT * NUM_ENCODERS * 2 * 2];
+#    endif
+#    ifdef DYNAMIC_KEYMAP_CACHE_MACROS
+static uint8_t macro_cache[DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE];
+#    endif
+
+static uint8_t *dynamic_keymap_cache_lookup(const void *address) {
+    uintptr_t offset = (uintptr_t)address - DYNAMIC_KEYMAP_EEPROM_ADDR;
+    if (offset < sizeof(keymap_cache)) {
+        return &keymap_cache[offset];
+    }
+#    ifdef ENCODER_MAP_ENABLE
+    offset = (uintptr_t)address - DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR;
+    if (offset < sizeof(encoder_cache)) {
+        return &encoder_cache[offset];
+    }
+#    endif
+#    ifdef DYNAMIC_KEYMAP_CACHE_MACROS
+    offset = (uintptr_t)address - DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR;
+    if (offset < sizeof(macro_cache)) {
+        return &macro_cache[offset];
+    }
+#    endif
+    return NULL;
+}
+
+static uint8_t dynamic_keymap_read_byte(const void *address) {
+    const uint8_t *cached = dynamic_keymap_cache_lookup(address);
+    return cached ? *cached : eeprom_read_byte(address);
+}
+
+static void dynamic_keymap_update_byte(void *address, uint8_t value) {
+    uint8_t *cached = dynamic_keymap_cache_lookup(address);
+    if (cached) {
+        *cached = value;
+    }
+    eeprom_update_byte(address, value);
+}
+#else
+#    define dynamic_keymap_read_byte(address) eeprom_read_byte(address)
+#    define dynamic_keymap_update_byte(address, value) eeprom_update_byte(address, value)
+#endif
+
+void dynamic_keymap_init(void) {
+#ifdef DYNAMIC_KEYMAP_CACHE_ENABLE
+    eeprom_read_block(keymap_cache, (void *)DYNAMIC_KEYMAP_EEPROM_ADDR, sizeof(keymap_cache));
+#    ifdef ENCODER_MAP_ENABLE
+    eeprom_read_block(encoder_cache, (void *)DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR, sizeof(encoder_cache));
+#    endif
+#    ifdef DYNAMIC_KEYMAP_CACHE_MACROS
+    eeprom_read_block(macro_cache, (void *)DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR, sizeof(macro_cache));
+#    endif
+#endif
+}
+
 uint8_t dynamic_keymap_get_layer_count(void) {
     return DYNAMIC_KEYMAP_LAYER_COUNT;
 }
@@ -114,8 +184,8 @@ uint16_t dynamic_keymap_get_keycode(uint8_t layer, uint8_t row, uint8_t column)
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return KC_NO;
     void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
     // Big endian, so we can read/write EEPROM directly from host if we want
-    uint16_t keycode = eeprom_read_byte(address) << 8;
-    keycode |= eeprom_read_byte(address + 1);
+    uint16_t keycode = dynamic_keymap_read_byte(address) << 8;
+    keycode |= dynamic_keymap_read_byte(address + 1);
     return keycode;
 }
 
@@ -123,8 +193,9 @@ void dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return;
     void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
     // Big endian, so we can read/write EEPROM directly from host if we want
-    eeprom_update_byte(address, (uint8_t)(keycode >> 8));
-    eeprom_update_byte(address + 1, (uint8_t)(keycode & 0xFF));
+    dynamic_keymap_update_byte(address, (uint8_t)(keycode >> 8));
+    dynamic_keymap_update_byte(address + 1, (uint8_t)(keycode & 0xFF));
+    layer_lookup_cache_invalidate();
 }
 
 #ifdef ENCODER_MAP_ENABLE
@@ -136,8 +207,8 @@ uint16_t dynamic_keymap_get_encoder(uint8_t layer, uint8_t encoder_id, bool cloc
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || encoder_id >= NUM_ENCODERS) return KC_NO;
     void *address = dynamic_keymap_encoder_to_eeprom_address(layer, encoder_id);
     // Big endian, so we can read/write EEPROM directly from host if we want
-    uint16_t keycode = ((uint16_t)eeprom_read_byte(address + (clockwise ? 0 : 2))) << 8;
-    keycode |= eeprom_read_byte(address + (clockwise ? 0 : 2) + 1);
+    uint16_t keycode = ((uint16_t)dynamic_keymap_read_byte(address + (clockwise ? 0 : 2))) << 8;
+    keycode |= dynamic_keymap_read_byte(address + (clockwise ? 0 : 2) + 1);
     return keycode;
 }
 
@@ -145,8 +216,8 @@ void dynamic_keymap_set_encoder(uint8_t layer, uint8_t encoder_id, bool clockwis
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || encoder_id >= NUM_ENCODERS) return;
     void *address = dynamic_keymap_encoder_to_eeprom_address(layer, encoder_id);
     // Big endian, so we can read/write EEPROM directly from host if we want
-    eeprom_update_byte(address + (clockwise ? 0 : 2), (uint8_t)(keycode >> 8));
-    eeprom_update_byte(address + (clockwise ? 0 : 2) + 1, (uint8_t)(keycode & 0xFF));
+    dynamic_keymap_update_byte(address + (clockwise ? 0 : 2), (uint8_t)(keycode >> 8));
+    dynamic_keymap_update_byte(address + (clockwise ? 0 : 2) + 1, (uint8_t)(keycode & 0xFF));
 }
 #endif // ENCODER_MAP_ENABLE
 
@@ -169,11 +240,11 @@ void dynamic_keymap_reset(void) {
 
 void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
     uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   source                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
+    void *   source                     = ((void *)DYNAMIC_KEYMAP_EEPROM_ADDR) + offset;
     uint8_t *target                     = data;
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < dynamic_keymap_eeprom_size) {
-            *target = eeprom_read_byte(source);
+            *target = dynamic_keymap_read_byte(source);
         } else {
             *target = 0x00;
         }
@@ -184,15 +255,16 @@ void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
 
 void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
     uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   target                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
+    void *   target                     = ((void *)DYNAMIC_KEYMAP_EEPROM_ADDR) + offset;
     uint8_t *source                     = data;
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < dynamic_keymap_eeprom_size) {
-            eeprom_update_byte(target, *source);
+            dynamic_keymap_update_byte(target, *source);
         }
         source++;
         target++;
     }
+    layer_lookup_cache_invalidate();
 }
 
 uint16_t keycode_at_keymap_location(uint8_t layer_num, uint8_t row, uint8_t column) {
@@ -220,11 +292,11 @@ uint16_t dynamic_keymap_macro_get_buffer_size(void) {
 }
 
 void dynamic_keymap_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   source = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
+    void *   source = ((void *)DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR) + offset;
     uint8_t *target = data;
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
-            *target = eeprom_read_byte(source);
+            *target = dynamic_keymap_read_byte(source);
         } else {
             *target = 0x00;
         }
@@ -234,11 +306,11 @@ void dynamic_keymap_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t *da
 }
 
 void dynamic_keymap_macro_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   target = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
+    void *   target = ((void *)DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR) + offset;
     uint8_t *source = data;
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
-            eeprom_update_byte(target, *source);
+            dynamic_keymap_update_byte(target, *source);
         }
         source++;
         target++;
@@ -249,11 +321,17 @@ void dynamic_keymap_macro_reset(void) {
     void *p   = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR);
     void *end = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE);
     while (p != end) {
-        eeprom_update_byte(p, 0);
+        dynamic_keymap_update_byte(p, 0);
         ++p;
     }
 }
 
+#ifdef SEND_STRING_ASYNC_ENABLE
+static char dynamic_keymap_macro_read_char(const char *position) {
+    return dynamic_keymap_read_byte((const void *)position);
+}
+#endif
+
 void dynamic_keymap_macro_send(uint8_t id) {
     if (id >= DYNAMIC_KEYMAP_MACRO_COUNT) {
         return;
@@ -264,7 +342,7 @@ void dynamic_keymap_macro_send(uint8_t id) {
     // of buffer writing, possibly an aborted buffer
     // write. So do nothing.
     void *p = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - 1);
-    if (eeprom_read_byte(p) != 0) {
+    if (dynamic_keymap_read_byte(p) != 0) {
         return;
     }
 
@@ -278,18 +356,23 @@ void dynamic_keymap_macro_send(uint8_t id) {
         if (p == end) {
             return;
         }
-        if (eeprom_read_byte(p) == 0) {
+        if (dynamic_keymap_read_byte(p) == 0) {
             --id;
         }
         ++p;
     }
 
+#ifdef SEND_STRING_ASYNC_ENABLE
+    // Type the macro straight from EEPROM as the queue gets to it. The
+    // terminator checked above keeps it from going past the end.
+    send_string_with_reader_async((const char *)p, DYNAMIC_KEYMAP_MACRO_DELAY, dynamic_keymap_macro_read_char);
+#else
     // Send the macro string by making a temporary string.
     char data[8] = {0};
     // We already checked there was a null at the end of
     // the buffer, so this cannot go past the end
     while (1) {
-        data[0] = eeprom_read_byte(p++);
+        data[0] = dynamic_keymap_read_byte(p++);
         data[1] = 0;
         // Stop at the null terminator of this macro string
         if (data[0] == 0) {
@@ -297,14 +380,14 @@ void dynamic_keymap_macro_send(uint8_t id) {
         }
         if (data[0] == SS_QMK_PREFIX) {
             // Get the code
-            data[1] = eeprom_read_byte(p++);
+            data[1] = dynamic_keymap_read_byte(p++);
             // Unexpected null, abort.
             if (data[1] == 0) {
                 return;
             }
             if (data[1] == SS_TAP_CODE || data[1] == SS_DOWN_CODE || data[1] == SS_UP_CODE) {
                 // Get the keycode
-                data[2] = eeprom_read_byte(p++);
+                data[2] = dynamic_keymap_read_byte(p++);
                 // Unexpected null, abort.
                 if (data[2] == 0) {
                     return;
@@ -316,7 +399,7 @@ void dynamic_keymap_macro_send(uint8_t id) {
                 // At most this is 4 digits plus '|'
                 uint8_t i = 2;
                 while (1) {
-                    data[i] = eeprom_read_byte(p++);
+                    data[i] = dynamic_keymap_read_byte(p++);
                     // Unexpected null, abort
                     if (data[i] == 0) {
                         return;
@@ -337,4 +420,5 @@ void dynamic_keymap_macro_send(uint8_t id) {
         }
         send_string_with_delay(data, DYNAMIC_KEYMAP_MACRO_DELAY);
     }
+#endif
 }
@@ -104,6 +104,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef VIA_ENABLE
 #    include "via.h"
 #endif
+#ifdef DYNAMIC_KEYMAP_ENABLE
+#    include "dynamic_keymap.h"
+#endif
 #ifdef DIP_SWITCH_ENABLE
 #    include "dip_switch.h"
 #endif
@@ -121,6 +124,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #endif
 #ifdef SPLIT_KEYBOARD
 #    include "split_util.h"
+#    include "transactions.h"
 #endif
 #ifdef BLUETOOTH_ENABLE
 #    include "bluetooth.h"
@@ -140,6 +144,23 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef OS_DETECTION_ENABLE
 #    include "os_detection.h"
 #endif
+#ifdef MATRIX_WAKEUP_ENABLE
+#    include "matrix_wakeup.h"
+#endif
+#ifdef LATENCY_TRACE_ENABLE
+#    include "latency_trace.h"
+#endif
+#ifdef SEND_STRING_ASYNC_ENABLE
+#    include "send_string.h"
+#endif
+#if defined(WEAR_LEVELING_ENABLE) && defined(WEAR_LEVELING_WRITE_BACK_ENABLE)
+#    include "wear_leveling.h"
+#endif
+#ifdef MATRIX_SCAN_THREAD_ENABLE
+#    include "matrix_scan_thread.h"
+
+static bool matrix_scan_threaded = false;
+#endif
 
 static uint32_t last_input_modification_time = 0;
 uint32_t        last_input_activity_time(void) {
@@ -419,6 +440,9 @@ void keyboard_init(void) {
 #endif
     matrix_init();
     quantum_init();
+#ifdef DYNAMIC_KEYMAP_ENABLE
+    dynamic_keymap_init();
+#endif
     led_init_ports();
 #ifdef BACKLIGHT_ENABLE
     backlight_init_ports();
@@ -490,6 +514,9 @@ void keyboard_init(void) {
     debug_enable = true;
 #endif
 
+#ifdef MATRIX_SCAN_THREAD_ENABLE
+    matrix_scan_threaded = matrix_scan_thread_start();
+#endif
     keyboard_post_init_kb(); /* Always keep this last */
 }
 
@@ -520,6 +547,39 @@ static inline void generate_tick_event(void) {
     }
 }
 
+/**
+ * @brief Timestamp for key changes in the given row, taken when the matrix
+ * was scanned rather than when the change is processed. Rows belonging to the
+ * slave half of a split keyboard use the time at which the slave saw the change.
+ *
+ * Timestamps never run backwards or ahead of the local timer, as the halves'
+ * clocks may be skewed slightly against each other.
+ */
+static uint16_t matrix_event_time(uint8_t row, uint16_t scan_time) {
+    static uint16_t last_time = 0;
+    uint16_t        time      = scan_time;
+
+#ifdef SPLIT_KEYBOARD
+    if (is_keyboard_master() && (row < (MATRIX_ROWS / 2)) != isLeftHand) {
+        time = split_slave_matrix_time();
+    }
+#endif
+
+    const uint16_t now  = timer_read();
+    uint16_t       age  = TIMER_DIFF_16(now, time);
+    uint16_t       last = TIMER_DIFF_16(now, last_time);
+    if (age > UINT16_MAX / 2) {
+        age = 0;
+    }
+    if (age > last) {
+        age = last;
+    }
+
+    last_time = now - age;
+    return last_time;
+}
+
+#ifndef MATRIX_SCAN_THREAD_ENABLE
 /**
  * @brief This task scans the keyboards matrix and processes any key presses
  * that occur.
@@ -533,8 +593,16 @@ static bool matrix_task(void) {
         return false;
     }
 
+#ifdef MATRIX_WAKEUP_ENABLE
+    if (!matrix_wakeup_task()) {
+        generate_tick_event();
+        return false;
+    }
+#endif
+
     static matrix_row_t matrix_previous[MATRIX_ROWS];
 
+    const uint16_t scan_time = timer_read();
     matrix_scan();
     bool matrix_changed = false;
     for (uint8_t row = 0; row < MATRIX_ROWS && !matrix_changed; row++) {
@@ -543,6 +611,10 @@ static bool matrix_task(void) {
 
     matrix_scan_perf_task();
 
+#ifdef MATRIX_WAKEUP_ENABLE
+    matrix_wakeup_scan_complete(matrix_changed);
+#endif
+
     // Short-circuit the complete matrix processing if it is not necessary
     if (!matrix_changed) {
         generate_tick_event();
@@ -569,7 +641,11 @@ static bool matrix_task(void) {
                 const bool key_pressed = current_row & col_mask;
 
                 if (process_keypress) {
-                    action_exec(MAKE_KEYEVENT(row, col, key_pressed));
+                    const keyevent_t event = MAKE_TIMED_KEYEVENT(row, col, key_pressed, matrix_event_time(row, scan_time));
+#ifdef LATENCY_TRACE_ENABLE
+                    latency_trace_mark(LATENCY_STAGE_MATRIX, event);
+#endif
+                    action_exec(event);
                 }
 
                 switch_events(row, col, key_pressed);
@@ -581,6 +657,90 @@ static bool matrix_task(void) {
 
     return matrix_changed;
 }
+#else
+/**
+ * @brief Scans the keyboards matrix and queues an event, timestamped at scan
+ * time, for every key that changed. Runs on the scan thread when the platform
+ * provides one.
+ *
+ * @return true Events were queued
+ * @return false Matrix didn't change
+ */
+bool matrix_scan_queue_events(void) {
+    if (!matrix_can_read()) {
+        return false;
+    }
+
+    static matrix_row_t matrix_previous[MATRIX_ROWS];
+
+    const uint16_t scan_time = timer_read();
+    matrix_scan();
+    bool events_queued = false;
+
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        const matrix_row_t current_row = matrix_get_row(row);
+        const matrix_row_t row_changes = current_row ^ matrix_previous[row];
+
+        if (!row_changes || has_ghost_in_row(row, current_row)) {
+            continue;
+        }
+
+        matrix_row_t col_mask = 1;
+        for (uint8_t col = 0; col < MATRIX_COLS; col++, col_mask <<= 1) {
+            if (row_changes & col_mask) {
+                // A full queue leaves the key as changed, so it is retried on the next scan
+                if (!key_event_queue_push(MAKE_TIMED_KEYEVENT(row, col, current_row & col_mask, matrix_event_time(row, scan_time)))) {
+                    return events_queued;
+                }
+                matrix_previous[row] ^= col_mask;
+                events_queued = true;
+            }
+        }
+    }
+
+    return events_queued;
+}
+
+/**
+ * @brief This task processes the key events queued by matrix scanning, which
+ * happens inline first if the platform has no scan thread, then runs the
+ * matrix_scan_kb() hook.
+ *
+ * @return true Matrix did change
+ * @return false Matrix didn't change
+ */
+static bool matrix_task(void) {
+    if (!matrix_scan_threaded) {
+        matrix_scan_queue_events();
+    }
+    matrix_scan_perf_task();
+
+    const bool process_keypress = should_process_keypress();
+    bool       matrix_changed   = false;
+    keyevent_t event;
+
+    while (key_event_queue_pop(&event)) {
+        matrix_changed = true;
+
+        if (process_keypress) {
+            action_exec(event);
+        }
+
+        switch_events(event.key.row, event.key.col, event.pressed);
+    }
+
+    // Left out of matrix_scan(), so the hooks run on the main loop rather than the scan thread
+    matrix_scan_kb();
+
+    if (!matrix_changed) {
+        generate_tick_event();
+    } else if (debug_config.matrix) {
+        matrix_print();
+    }
+
+    return matrix_changed;
+}
+#endif
 
 /** \brief Tasks previously located in matrix_scan_quantum
  *
@@ -624,6 +784,10 @@ void quantum_task(void) {
     sequencer_task();
 #endif
 
+#ifdef SEND_STRING_ASYNC_ENABLE
+    send_string_async_task();
+#endif
+
 #ifdef TAP_DANCE_ENABLE
     tap_dance_task();
 #endif
@@ -748,4 +912,12 @@ void keyboard_task(void) {
 #ifdef OS_DETECTION_ENABLE
     os_detection_task();
 #endif
+
+#ifdef LATENCY_TRACE_ENABLE
+    latency_trace_task();
+#endif
+
+#if defined(WEAR_LEVELING_ENABLE) && defined(WEAR_LEVELING_WRITE_BACK_ENABLE)
+    wear_leveling_task();
+#endif
 }
@@ -0,0 +1,271 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "latency_trace.h"
+#include "timer.h"
+#include "print.h"
+
+#if defined(PROTOCOL_CHIBIOS)
+#    include <ch.h>
+
+typedef systime_t latency_time_t;
+
+static inline latency_time_t latency_trace_now(void) {
+    return chVTGetSystemTimeX();
+}
+
+static inline uint32_t latency_trace_elapsed_us(latency_time_t start, latency_time_t end) {
+    return TIME_I2US(chTimeDiffX(start, end));
+}
+#else
+// Millisecond resolution fallback for platforms without a finer grained timer
+typedef uint32_t latency_time_t;
+
+static inline latency_time_t latency_trace_now(void) {
+    return timer_read32();
+}
+
+static inline uint32_t latency_trace_elapsed_us(latency_time_t start, latency_time_t end) {
+    return TIMER_DIFF_32(end, start) * 1000;
+}
+#endif
+
+#ifndef LATENCY_TRACE_TIMEOUT
+#    define LATENCY_TRACE_TIMEOUT 5000
+#endif
+
+#if defined(CONSOLE_ENABLE) && !defined(LATENCY_TRACE_PRINT_INTERVAL)
+#    define LATENCY_TRACE_PRINT_INTERVAL 10000
+#endif
+
+typedef struct {
+    keypos_t       key;
+    bool           pressed;
+    uint8_t        stages; // bitmask of latency_stage_t recorded so far
+    uint32_t       started;
+    latency_time_t time[LATENCY_STAGE_COUNT];
+} latency_trace_slot_t;
+
+typedef struct {
+    uint32_t count;
+    uint32_t min_us;
+    uint32_t max_us;
+    uint64_t sum_us;
+    uint16_t buckets[LATENCY_TRACE_HISTOGRAM_BUCKETS];
+} latency_histogram_t;
+
+static latency_trace_slot_t slots[LATENCY_TRACE_SLOTS];
+static latency_histogram_t  histograms[LATENCY_SPAN_COUNT];
+
+#define STAGE_BIT(stage) (1 << (stage))
+
+/* Buckets are spaced at half octaves: 0, 1, 2, 3, 4-5, 6-7, 8-11, 12-15, 16-23, ... */
+static uint8_t latency_bucket_index(uint32_t us) {
+    if (us < 4) {
+        return us;
+    }
+    uint8_t msb   = 31 - __builtin_clz(us);
+    uint8_t index = msb * 2 + ((us >> (msb - 1)) & 1);
+    return index < LATENCY_TRACE_HISTOGRAM_BUCKETS ? index : LATENCY_TRACE_HISTOGRAM_BUCKETS - 1;
+}
+
+static uint32_t latency_bucket_upper_bound(uint8_t index) {
+    if (index < 4) {
+        return index;
+    }
+    uint8_t msb = index / 2;
+    return (1UL << msb) + ((uint32_t)((index & 1) + 1) << (msb - 1)) - 1;
+}
+
+static void latency_histogram_add(latency_histogram_t *histogram, uint32_t us) {
+    if (histogram->count == 0 || us < histogram->min_us) {
+        histogram->min_us = us;
+    }
+    if (us > histogram->max_us) {
+        histogram->max_us = us;
+    }
+    histogram->count++;
+    histogram->sum_us += us;
+
+    uint8_t index = latency_bucket_index(us);
+    if (histogram->buckets[index] == UINT16_MAX) {
+        // Decay the distribution rather than saturating a single bucket
+        for (uint8_t i = 0; i < LATENCY_TRACE_HISTOGRAM_BUCKETS; i++) {
+            histogram->buckets[i] /= 2;
+        }
+    }
+    histogram->buckets[index]++;
+}
+
+static void latency_trace_complete(latency_trace_slot_t *slot) {
+    static const latency_stage_t span_start[] = {
+        [LATENCY_SPAN_MATRIX_TO_ACTION]  = LATENCY_STAGE_MATRIX,
+        [LATENCY_SPAN_ACTION_TO_PROCESS] = LATENCY_STAGE_ACTION,
+        [LATENCY_SPAN_PROCESS_TO_REPORT] = LATENCY_STAGE_PROCESS,
+        [LATENCY_SPAN_TOTAL]             = LATENCY_STAGE_MATRIX,
+    };
+    static const latency_stage_t span_end[] = {
+        [LATENCY_SPAN_MATRIX_TO_ACTION]  = LATENCY_STAGE_ACTION,
+        [LATENCY_SPAN_ACTION_TO_PROCESS] = LATENCY_STAGE_PROCESS,
+        [LATENCY_SPAN_PROCESS_TO_REPORT] = LATENCY_STAGE_REPORT,
+        [LATENCY_SPAN_TOTAL]             = LATENCY_STAGE_REPORT,
+    };
+
+    for (uint8_t span = 0; span < LATENCY_SPAN_COUNT; span++) {
+        latency_histogram_add(&histograms[span], latency_trace_elapsed_us(slot->time[span_start[span]], slot->time[span_end[span]]));
+    }
+    slot->stages = 0;
+}
+
+static uint32_t latency_trace_age_us(const latency_trace_slot_t *slot, latency_time_t now) {
+    return latency_trace_elapsed_us(slot->time[LATENCY_STAGE_MATRIX], now);
+}
+
+static latency_trace_slot_t *latency_trace_start(latency_time_t now) {
+    latency_trace_slot_t *oldest = &slots[0];
+    for (uint8_t i = 0; i < LATENCY_TRACE_SLOTS; i++) {
+        if (slots[i].stages == 0) {
+            return &slots[i];
+        }
+        if (latency_trace_age_us(&slots[i], now) > latency_trace_age_us(oldest, now)) {
+            oldest = &slots[i];
+        }
+    }
+    // All slots in use, evict the oldest trace
+    return oldest;
+}
+
+uint32_t latency_trace_timestamp(void) {
+    return latency_trace_now();
+}
+
+void latency_trace_mark(latency_stage_t stage, keyevent_t event) {
+    latency_trace_mark_at(stage, event, latency_trace_now());
+}
+
+void latency_trace_mark_at(latency_stage_t stage, keyevent_t event, uint32_t timestamp) {
+    if (!IS_KEYEVENT(event)) {
+        return;
+    }
+
+    latency_time_t now = timestamp;
+
+    if (stage == LATENCY_STAGE_MATRIX) {
+        latency_trace_slot_t *slot = latency_trace_start(now);
+        slot->key                  = event.key;
+        slot->pressed              = event.pressed;
+        slot->stages               = STAGE_BIT(LATENCY_STAGE_MATRIX);
+        slot->started              = timer_read32();
+        slot->time[stage]          = now;
+        return;
+    }
+
+    if (stage == LATENCY_STAGE_PROCESS) {
+        // Reports are sent synchronously while an event is processed, so any
+        // earlier event still waiting on one did not produce a report at all
+        for (uint8_t i = 0; i < LATENCY_TRACE_SLOTS; i++) {
+            if (slots[i].stages & STAGE_BIT(LATENCY_STAGE_PROCESS)) {
+                slots[i].stages = 0;
+            }
+        }
+    }
+
+    // Events for the same key are processed in order, so take the oldest match
+    latency_trace_slot_t *match = NULL;
+    for (uint8_t i = 0; i < LATENCY_TRACE_SLOTS; i++) {
+        latency_trace_slot_t *slot = &slots[i];
+        if (slot->stages != STAGE_BIT(stage) - 1 || slot->pressed != event.pressed || !KEYEQ(slot->key, event.key)) {
+            continue;
+        }
+        if (match == NULL || latency_trace_age_us(slot, now) > latency_trace_age_us(match, now)) {
+            match = slot;
+        }
+    }
+
+    if (match) {
+        match->stages |= STAGE_BIT(stage);
+        match->time[stage] = now;
+    }
+}
+
+void latency_trace_report(void) {
+    latency_time_t now = latency_trace_now();
+    for (uint8_t i = 0; i < LATENCY_TRACE_SLOTS; i++) {
+        if (slots[i].stages & STAGE_BIT(LATENCY_STAGE_PROCESS)) {
+            slots[i].stages |= STAGE_BIT(LATENCY_STAGE_REPORT);
+            slots[i].time[LATENCY_STAGE_REPORT] = now;
+            latency_trace_complete(&slots[i]);
+        }
+    }
+}
+
+void latency_trace_task(void) {
+    for (uint8_t i = 0; i < LATENCY_TRACE_SLOTS; i++) {
+        if (slots[i].stages && timer_elapsed32(slots[i].started) > LATENCY_TRACE_TIMEOUT) {
+            slots[i].stages = 0;
+        }
+    }
+
+#if defined(LATENCY_TRACE_PRINT_INTERVAL) && LATENCY_TRACE_PRINT_INTERVAL > 0
+    static uint32_t last_print = 0;
+    if (timer_elapsed32(last_print) >= LATENCY_TRACE_PRINT_INTERVAL) {
+        last_print = timer_read32();
+        latency_trace_print();
+    }
+#endif
+}
+
+void latency_trace_get_stats(latency_span_t span, latency_stats_t *stats) {
+    const latency_histogram_t *histogram = &histograms[span];
+
+    stats->count  = histogram->count;
+    stats->min_us = histogram->min_us;
+    stats->max_us = histogram->max_us;
+    stats->avg_us = histogram->count ? (uint32_t)(histogram->sum_us / histogram->count) : 0;
+    stats->p99_us = 0;
+
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < LATENCY_TRACE_HISTOGRAM_BUCKETS; i++) {
+        total += histogram->buckets[i];
+    }
+
+    // The p99 figure is the upper bound of the bucket the 99th percentile falls into
+    uint32_t threshold  = total - total / 100;
+    uint32_t cumulative = 0;
+    for (uint8_t i = 0; i < LATENCY_TRACE_HISTOGRAM_BUCKETS && total; i++) {
+        cumulative += histogram->buckets[i];
+        if (cumulative >= threshold) {
+            stats->p99_us = latency_bucket_upper_bound(i);
+            break;
+        }
+    }
+    if (stats->p99_us > stats->max_us) {
+        stats->p99_us = stats->max_us;
+    }
+}
+
+void latency_trace_reset(void) {
+    for (uint8_t i = 0; i < LATENCY_SPAN_COUNT; i++) {
+        histograms[i] = (latency_histogram_t){0};
+    }
+    for (uint8_t i = 0; i < LATENCY_TRACE_SLOTS; i++) {
+        slots[i].stages = 0;
+    }
+}
+
+void latency_trace_print(void) {
+#ifdef CONSOLE_ENABLE
+    static const char *const span_names[] = {
+        [LATENCY_SPAN_MATRIX_TO_ACTION]  = "matrix->action",
+        [LATENCY_SPAN_ACTION_TO_PROCESS] = "action->process",
+        [LATENCY_SPAN_PROCESS_TO_REPORT] = "process->report",
+        [LATENCY_SPAN_TOTAL]             = "total",
+    };
+
+    for (uint8_t span = 0; span < LATENCY_SPAN_COUNT; span++) {
+        latency_stats_t stats;
+        latency_trace_get_stats(span, &stats);
+        uprintf("latency %s: n=%lu min=%luus avg=%luus p99=%luus max=%luus\n", span_names[span], (unsigned long)stats.count, (unsigned long)stats.min_us, (unsigned long)stats.avg_us, (unsigned long)stats.p99_us, (unsigned long)stats.max_us);
+    }
+#endif
+}
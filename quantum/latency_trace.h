@@ -0,0 +1,96 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "keyboard.h"
+
+/**
+ * \file
+ *
+ * Per-stage key event latency tracing.
+ *
+ * Each key event is timestamped as it passes through the processing
+ * pipeline, and the time spent between consecutive stages is accumulated
+ * into a histogram so that min/avg/p99/max figures can be reported.
+ */
+
+#ifndef LATENCY_TRACE_SLOTS
+#    define LATENCY_TRACE_SLOTS 8
+#endif
+
+#ifndef LATENCY_TRACE_HISTOGRAM_BUCKETS
+#    define LATENCY_TRACE_HISTOGRAM_BUCKETS 40
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Points in the pipeline at which a key event is timestamped. */
+typedef enum {
+    LATENCY_STAGE_MATRIX,  // the matrix scan detected the change
+    LATENCY_STAGE_ACTION,  // action_exec() received the event
+    LATENCY_STAGE_PROCESS, // process_record_quantum() returned
+    LATENCY_STAGE_REPORT,  // host_keyboard_send() was called
+    LATENCY_STAGE_COUNT,
+} latency_stage_t;
+
+/** Intervals between stages for which statistics are kept. */
+typedef enum {
+    LATENCY_SPAN_MATRIX_TO_ACTION,
+    LATENCY_SPAN_ACTION_TO_PROCESS,
+    LATENCY_SPAN_PROCESS_TO_REPORT,
+    LATENCY_SPAN_TOTAL,
+    LATENCY_SPAN_COUNT,
+} latency_span_t;
+
+typedef struct {
+    uint32_t count;
+    uint32_t min_us;
+    uint32_t avg_us;
+    uint32_t p99_us;
+    uint32_t max_us;
+} latency_stats_t;
+
+/**
+ * \brief Timestamp a key event at the given stage.
+ *
+ * `LATENCY_STAGE_MATRIX` starts a new trace for the event, later stages
+ * are matched against in-flight traces by key position and press state.
+ */
+void latency_trace_mark(latency_stage_t stage, keyevent_t event);
+
+/**
+ * \brief Take a timestamp for `latency_trace_mark_at()`. Safe to call from
+ * any thread.
+ */
+uint32_t latency_trace_timestamp(void);
+
+/**
+ * \brief Timestamp a key event at the given stage, at a time taken earlier
+ * with `latency_trace_timestamp()`, e.g. on the matrix scan thread.
+ */
+void latency_trace_mark_at(latency_stage_t stage, keyevent_t event, uint32_t timestamp);
+
+/**
+ * \brief Complete all traces that are waiting on a report.
+ *
+ * Called when a keyboard report is sent to the host.
+ */
+void latency_trace_report(void);
+
+/**
+ * \brief Periodic task, drops stale traces and prints statistics over console.
+ */
+void latency_trace_task(void);
+
+void latency_trace_get_stats(latency_span_t span, latency_stats_t *stats);
+void latency_trace_reset(void);
+void latency_trace_print(void);
+
+#ifdef __cplusplus
+}
+#endif
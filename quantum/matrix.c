@@ -21,6 +21,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "matrix.h"
 #include "debounce.h"
 #include "atomic_util.h"
+#ifdef MATRIX_WAKEUP_ENABLE
+#    include "matrix_wakeup.h"
+#endif
 
 #ifdef SPLIT_KEYBOARD
 #    include "split_common/split_util.h"
@@ -76,6 +79,14 @@ __attribute__((weak)) void matrix_init_pins(void);
 __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[], uint8_t current_row);
 __attribute__((weak)) void matrix_read_rows_on_col(matrix_row_t current_matrix[], uint8_t current_col, matrix_row_t row_shifter);
 
+#ifdef MATRIX_WAKEUP_ENABLE
+// platform-provided pin change interrupt control
+__attribute__((weak)) bool matrix_wakeup_pin_enable(pin_t pin) {
+    return false;
+}
+__attribute__((weak)) void matrix_wakeup_pin_disable(pin_t pin) {}
+#endif
+
 static inline void gpio_atomic_set_pin_output_low(pin_t pin) {
     ATOMIC_BLOCK_FORCEON {
         gpio_set_pin_output(pin);
@@ -133,6 +144,31 @@ __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[]
     current_matrix[current_row] = current_row_value;
 }
 
+#    ifdef MATRIX_WAKEUP_ENABLE
+void matrix_wakeup_disarm(void) {
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            if (direct_pins[row][col] != NO_PIN) {
+                matrix_wakeup_pin_disable(direct_pins[row][col]);
+            }
+        }
+    }
+}
+
+bool matrix_wakeup_arm(void) {
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            pin_t pin = direct_pins[row][col];
+            if (pin != NO_PIN && (!readMatrixPin(pin) || !matrix_wakeup_pin_enable(pin))) {
+                matrix_wakeup_disarm();
+                return false;
+            }
+        }
+    }
+    return true;
+}
+#    endif
+
 #elif defined(DIODE_DIRECTION)
 #    if defined(MATRIX_ROW_PINS) && defined(MATRIX_COL_PINS)
 #        if (DIODE_DIRECTION == COL2ROW)
@@ -198,6 +234,35 @@ __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[]
     current_matrix[current_row] = current_row_value;
 }
 
+#            ifdef MATRIX_WAKEUP_ENABLE
+void matrix_wakeup_disarm(void) {
+    for (uint8_t x = 0; x < MATRIX_COLS; x++) {
+        if (col_pins[x] != NO_PIN) {
+            matrix_wakeup_pin_disable(col_pins[x]);
+        }
+    }
+    unselect_rows();
+    matrix_output_unselect_delay(0, true);
+}
+
+bool matrix_wakeup_arm(void) {
+    // Select every row at once, so that any keypress drives its col pin to the pressed state
+    for (uint8_t x = 0; x < ROWS_PER_HAND; x++) {
+        select_row(x);
+    }
+    matrix_output_select_delay();
+
+    for (uint8_t x = 0; x < MATRIX_COLS; x++) {
+        pin_t pin = col_pins[x];
+        if (pin != NO_PIN && (!readMatrixPin(pin) || !matrix_wakeup_pin_enable(pin))) {
+            matrix_wakeup_disarm();
+            return false;
+        }
+    }
+    return true;
+}
+#            endif
+
 #        elif (DIODE_DIRECTION == ROW2COL)
 
 static bool select_col(uint8_t col) {
@@ -262,6 +327,35 @@ __attribute__((weak)) void matrix_read_rows_on_col(matrix_row_t current_matrix[]
     matrix_output_unselect_delay(current_col, key_pressed); // wait for all Row signals to go HIGH
 }
 
+#            ifdef MATRIX_WAKEUP_ENABLE
+void matrix_wakeup_disarm(void) {
+    for (uint8_t x = 0; x < ROWS_PER_HAND; x++) {
+        if (row_pins[x] != NO_PIN) {
+            matrix_wakeup_pin_disable(row_pins[x]);
+        }
+    }
+    unselect_cols();
+    matrix_output_unselect_delay(0, true);
+}
+
+bool matrix_wakeup_arm(void) {
+    // Select every col at once, so that any keypress drives its row pin to the pressed state
+    for (uint8_t x = 0; x < MATRIX_COLS; x++) {
+        select_col(x);
+    }
+    matrix_output_select_delay();
+
+    for (uint8_t x = 0; x < ROWS_PER_HAND; x++) {
+        pin_t pin = row_pins[x];
+        if (pin != NO_PIN && (!readMatrixPin(pin) || !matrix_wakeup_pin_enable(pin))) {
+            matrix_wakeup_disarm();
+            return false;
+        }
+    }
+    return true;
+}
+#            endif
+
 #        else
 #            error DIODE_DIRECTION must be one of COL2ROW or ROW2COL!
 #        endif
@@ -343,7 +437,9 @@ uint8_t matrix_scan(void) {
     changed = debounce(raw_matrix, matrix + thisHand, ROWS_PER_HAND, changed) | matrix_post_scan();
 #else
     changed = debounce(raw_matrix, matrix, ROWS_PER_HAND, changed);
+#    ifndef MATRIX_SCAN_THREAD_ENABLE
     matrix_scan_kb();
+#    endif
 #endif
     return (uint8_t)changed;
 }
@@ -172,7 +172,9 @@ __attribute__((weak)) uint8_t matrix_scan(void) {
     changed = debounce(raw_matrix, matrix + thisHand, ROWS_PER_HAND, changed) | matrix_post_scan();
 #else
     changed = debounce(raw_matrix, matrix, ROWS_PER_HAND, changed);
+#    ifndef MATRIX_SCAN_THREAD_ENABLE
     matrix_scan_kb();
+#    endif
 #endif
 
     return changed;
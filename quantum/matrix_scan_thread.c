@@ -0,0 +1,70 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "matrix_scan_thread.h"
+#ifdef LATENCY_TRACE_ENABLE
+#    include "latency_trace.h"
+#endif
+
+#ifdef SPLIT_KEYBOARD
+#    error "MATRIX_SCAN_THREAD_ENABLE is not supported on split keyboards"
+#endif
+
+#ifdef MATRIX_WAKEUP_ENABLE
+#    error "MATRIX_SCAN_THREAD_ENABLE and MATRIX_WAKEUP_ENABLE cannot be used together"
+#endif
+
+_Static_assert(MATRIX_SCAN_THREAD_QUEUE_SIZE <= UINT8_MAX, "MATRIX_SCAN_THREAD_QUEUE_SIZE must fit in a byte");
+
+typedef struct {
+    keyevent_t event;
+#ifdef LATENCY_TRACE_ENABLE
+    uint32_t pushed; // latency trace timestamp, so the time spent queued counts towards the matrix stage
+#endif
+} key_event_queue_entry_t;
+
+/* Each index is only ever written by one side, so the queue needs no locking,
+ * just ordering between filling a slot and publishing the new head. */
+static key_event_queue_entry_t queue[MATRIX_SCAN_THREAD_QUEUE_SIZE];
+static uint8_t                 queue_head = 0; // written by the producer
+static uint8_t                 queue_tail = 0; // written by the consumer
+
+__attribute__((weak)) bool matrix_scan_thread_start(void) {
+    return false;
+}
+
+__attribute__((weak)) void matrix_scan_thread_lock(void) {}
+
+__attribute__((weak)) void matrix_scan_thread_unlock(void) {}
+
+bool key_event_queue_push(keyevent_t event) {
+    uint8_t head = queue_head;
+    uint8_t next = (head + 1) % MATRIX_SCAN_THREAD_QUEUE_SIZE;
+
+    if (next == __atomic_load_n(&queue_tail, __ATOMIC_ACQUIRE)) {
+        return false;
+    }
+
+    queue[head].event = event;
+#ifdef LATENCY_TRACE_ENABLE
+    queue[head].pushed = latency_trace_timestamp();
+#endif
+    __atomic_store_n(&queue_head, next, __ATOMIC_RELEASE);
+    return true;
+}
+
+bool key_event_queue_pop(keyevent_t *event) {
+    uint8_t tail = queue_tail;
+
+    if (tail == __atomic_load_n(&queue_head, __ATOMIC_ACQUIRE)) {
+        return false;
+    }
+
+    *event = queue[tail].event;
+#ifdef LATENCY_TRACE_ENABLE
+    // The trace is kept by the consumer, so it's only started now
+    latency_trace_mark_at(LATENCY_STAGE_MATRIX, *event, queue[tail].pushed);
+#endif
+    __atomic_store_n(&queue_tail, (tail + 1) % MATRIX_SCAN_THREAD_QUEUE_SIZE, __ATOMIC_RELEASE);
+    return true;
+}
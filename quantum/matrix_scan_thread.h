@@ -0,0 +1,81 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "keyboard.h"
+
+/**
+ * \file
+ *
+ * Matrix scanning decoupled from key event processing.
+ *
+ * The matrix is scanned by a dedicated high priority thread on platforms that
+ * support it, which timestamps every key change as it is detected and pushes
+ * it into a lock-free single producer, single consumer queue. `keyboard_task()`
+ * consumes the queue, so slow processing no longer delays the next scan or
+ * skews the event times used for tap-hold decisions.
+ *
+ * On platforms without a scan thread, `keyboard_task()` fills the queue itself
+ * before consuming it.
+ */
+
+#ifndef MATRIX_SCAN_THREAD_QUEUE_SIZE
+#    define MATRIX_SCAN_THREAD_QUEUE_SIZE 32
+#endif
+
+#ifndef MATRIX_SCAN_THREAD_INTERVAL
+// Microseconds between matrix scans
+#    define MATRIX_SCAN_THREAD_INTERVAL 1000
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Queue up a key event, only to be called from the producer side.
+ *
+ * \return false if the queue is full
+ */
+bool key_event_queue_push(keyevent_t event);
+
+/**
+ * \brief Take the oldest key event from the queue, only to be called from the consumer side.
+ *
+ * With `LATENCY_TRACE_ENABLE`, this starts the event's trace from the time it
+ * was queued.
+ *
+ * \return false if the queue is empty
+ */
+bool key_event_queue_pop(keyevent_t *event);
+
+/**
+ * \brief Scan the matrix and queue an event for every key that changed.
+ *
+ * Implemented in keyboard.c, called from the scan thread.
+ *
+ * \return true if any event was queued
+ */
+bool matrix_scan_queue_events(void);
+
+/**
+ * \brief Platform hook, start a thread calling `matrix_scan_queue_events()`
+ * every `MATRIX_SCAN_THREAD_INTERVAL` microseconds.
+ *
+ * \return false if the platform has no scan thread support
+ */
+bool matrix_scan_thread_start(void);
+
+/**
+ * \brief Platform hooks, keep the scan thread from running while the matrix
+ * is scanned from elsewhere, e.g. to check for wakeup during suspend.
+ */
+void matrix_scan_thread_lock(void);
+void matrix_scan_thread_unlock(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,87 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "matrix_wakeup.h"
+#include "matrix.h"
+#include "timer.h"
+
+#ifdef SPLIT_KEYBOARD
+#    error "MATRIX_WAKEUP_ENABLE is not supported on split keyboards"
+#endif
+
+static matrix_wakeup_state_t wakeup_state       = MATRIX_WAKEUP_SCANNING;
+static volatile bool         wakeup_pending     = false;
+static uint32_t              last_scan_activity = 0;
+
+__attribute__((weak)) bool matrix_wakeup_arm(void) {
+    return false;
+}
+
+__attribute__((weak)) void matrix_wakeup_disarm(void) {}
+
+__attribute__((weak)) void matrix_wakeup_idle(void) {}
+
+void matrix_wakeup_trigger(void) {
+    wakeup_pending = true;
+}
+
+matrix_wakeup_state_t matrix_wakeup_get_state(void) {
+    return wakeup_state;
+}
+
+static void matrix_wakeup_resume(void) {
+    matrix_wakeup_disarm();
+    wakeup_state       = MATRIX_WAKEUP_SCANNING;
+    last_scan_activity = timer_read32();
+}
+
+bool matrix_wakeup_task(void) {
+    if (wakeup_state == MATRIX_WAKEUP_SCANNING) {
+        return true;
+    }
+
+    if (!wakeup_pending) {
+        matrix_wakeup_idle();
+    }
+
+    // Check again, as the idle hook may have been woken by the matrix interrupt
+    if (wakeup_pending) {
+        matrix_wakeup_resume();
+        return true;
+    }
+
+    return false;
+}
+
+static bool matrix_wakeup_keys_held(void) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        if (matrix_get_row(row)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void matrix_wakeup_scan_complete(bool changed) {
+    if (wakeup_state != MATRIX_WAKEUP_SCANNING) {
+        return;
+    }
+
+    if (changed || matrix_wakeup_keys_held()) {
+        last_scan_activity = timer_read32();
+        return;
+    }
+
+    if (timer_elapsed32(last_scan_activity) < MATRIX_WAKEUP_TIMEOUT) {
+        return;
+    }
+
+    // Clear before arming, so an interrupt firing straight away is not lost
+    wakeup_pending = false;
+    if (matrix_wakeup_arm()) {
+        wakeup_state = MATRIX_WAKEUP_ASLEEP;
+    } else {
+        // Keys still bouncing or arming unsupported, try again after another timeout
+        last_scan_activity = timer_read32();
+    }
+}
@@ -0,0 +1,84 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * \file
+ *
+ * Interrupt driven matrix wakeup.
+ *
+ * While keys are held, or shortly after the matrix last changed, the matrix is
+ * scanned on every keyboard task iteration as usual. Once the matrix has been
+ * idle for MATRIX_WAKEUP_TIMEOUT milliseconds, the matrix pins are armed to
+ * raise an interrupt on any keypress and scanning stops until that interrupt
+ * fires.
+ */
+
+#ifndef MATRIX_WAKEUP_TIMEOUT
+#    define MATRIX_WAKEUP_TIMEOUT 50
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    MATRIX_WAKEUP_SCANNING,
+    MATRIX_WAKEUP_ASLEEP,
+} matrix_wakeup_state_t;
+
+/**
+ * \brief Decide whether the matrix should be scanned this iteration.
+ *
+ * If the matrix is asleep, this will call `matrix_wakeup_idle()` and
+ * return false unless a wakeup interrupt has been received since.
+ *
+ * \return true if `matrix_scan()` should be called
+ */
+bool matrix_wakeup_task(void);
+
+/**
+ * \brief Report the result of a matrix scan to the wakeup state machine.
+ *
+ * \param changed true if the debounced matrix changed during the scan
+ */
+void matrix_wakeup_scan_complete(bool changed);
+
+/**
+ * \brief Signal a matrix wakeup. Safe to call from interrupt context.
+ */
+void matrix_wakeup_trigger(void);
+
+matrix_wakeup_state_t matrix_wakeup_get_state(void);
+
+/**
+ * \brief Configure the matrix pins to raise a wakeup interrupt on keypress.
+ *
+ * Implemented by the default matrix scanning code. Custom matrix
+ * implementations may provide their own.
+ *
+ * \return false if the interrupts could not be armed, or a key is already
+ * pressed, in which case scanning continues as normal
+ */
+bool matrix_wakeup_arm(void);
+
+/**
+ * \brief Restore the matrix pins for scanning after a wakeup.
+ */
+void matrix_wakeup_disarm(void);
+
+/**
+ * \brief Platform hook, called on every keyboard task iteration while asleep.
+ *
+ * Expected to put the core to sleep until the next interrupt, or for at most
+ * a millisecond, whichever comes first.
+ */
+void matrix_wakeup_idle(void);
+
+#ifdef __cplusplus
+}
+#endif
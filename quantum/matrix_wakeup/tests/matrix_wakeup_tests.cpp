@@ -0,0 +1,165 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "matrix.h"
+#include "matrix_wakeup.h"
+#include "timer.h"
+
+void     advance_time(uint32_t ms);
+uint32_t matrix_wakeup_idle_count(void);
+void     reset_matrix_wakeup_idle_count(void);
+void     simulate_matrix_wakeup_interrupt(void);
+void     simulate_matrix_wakeup_interrupt_during_idle(void);
+}
+
+static matrix_row_t test_matrix[MATRIX_ROWS];
+static bool         arm_result;
+static uint32_t     arm_count;
+static uint32_t     disarm_count;
+
+extern "C" {
+matrix_row_t matrix_get_row(uint8_t row) {
+    return test_matrix[row];
+}
+
+bool matrix_wakeup_arm(void) {
+    arm_count++;
+    return arm_result;
+}
+
+void matrix_wakeup_disarm(void) {
+    disarm_count++;
+}
+}
+
+class MatrixWakeupTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        // Make sure every test starts out scanning
+        if (matrix_wakeup_get_state() == MATRIX_WAKEUP_ASLEEP) {
+            simulate_matrix_wakeup_interrupt();
+            matrix_wakeup_task();
+        }
+        memset(test_matrix, 0, sizeof(test_matrix));
+        arm_result   = true;
+        arm_count    = 0;
+        disarm_count = 0;
+        reset_matrix_wakeup_idle_count();
+        timer_clear();
+        // Reset the idle timer
+        matrix_wakeup_scan_complete(true);
+    }
+
+    // Runs the same sequence as matrix_task() for the given number of milliseconds
+    void run_for(uint32_t ms, bool changed = false) {
+        for (uint32_t i = 0; i < ms; i++) {
+            if (matrix_wakeup_task()) {
+                matrix_wakeup_scan_complete(changed);
+            }
+            advance_time(1);
+        }
+    }
+};
+
+TEST_F(MatrixWakeupTest, StaysAwakeWithinTimeout) {
+    run_for(MATRIX_WAKEUP_TIMEOUT - 1);
+    EXPECT_EQ(matrix_wakeup_get_state(), MATRIX_WAKEUP_SCANNING);
+    EXPECT_EQ(arm_count, 0);
+}
+
+TEST_F(MatrixWakeupTest, SleepsAfterTimeout) {
+    run_for(MATRIX_WAKEUP_TIMEOUT + 1);
+    EXPECT_EQ(matrix_wakeup_get_state(), MATRIX_WAKEUP_ASLEEP);
+    EXPECT_EQ(arm_count, 1);
+    EXPECT_EQ(disarm_count, 0);
+}
+
+TEST_F(MatrixWakeupTest, SkipsScanWhileAsleep) {
+    run_for(MATRIX_WAKEUP_TIMEOUT + 1);
+    ASSERT_EQ(matrix_wakeup_get_state(), MATRIX_WAKEUP_ASLEEP);
+    reset_matrix_wakeup_idle_count();
+
+    for (int i = 0; i < 100; i++) {
+        EXPECT_FALSE(matrix_wakeup_task());
+        advance_time(1);
+    }
+    EXPECT_EQ(matrix_wakeup_idle_count(), 100);
+    EXPECT_EQ(arm_count, 1);
+}
+
+TEST_F(MatrixWakeupTest, StaysAwakeWhileKeyHeld) {
+    test_matrix[1] = 0b0100;
+    run_for(MATRIX_WAKEUP_TIMEOUT * 10);
+    EXPECT_EQ(matrix_wakeup_get_state(), MATRIX_WAKEUP_SCANNING);
+    EXPECT_EQ(arm_count, 0);
+
+    test_matrix[1] = 0;
+    run_for(1, true);
+    run_for(MATRIX_WAKEUP_TIMEOUT - 1);
+    EXPECT_EQ(matrix_wakeup_get_state(), MATRIX_WAKEUP_SCANNING);
+    run_for(2);
+    EXPECT_EQ(matrix_wakeup_get_state(), MATRIX_WAKEUP_ASLEEP);
+}
+
+TEST_F(MatrixWakeupTest, StaysAwakeWhileMatrixChanging) {
+    run_for(MATRIX_WAKEUP_TIMEOUT * 10, true);
+    EXPECT_EQ(matrix_wakeup_get_state(), MATRIX_WAKEUP_SCANNING);
+    EXPECT_EQ(arm_count, 0);
+}
+
+TEST_F(MatrixWakeupTest, InterruptWakesImmediately) {
+    run_for(MATRIX_WAKEUP_TIMEOUT + 1);
+    ASSERT_EQ(matrix_wakeup_get_state(), MATRIX_WAKEUP_ASLEEP);
+    run_for(10);
+
+    simulate_matrix_wakeup_interrupt();
+    EXPECT_TRUE(matrix_wakeup_task());
+    EXPECT_EQ(matrix_wakeup_get_state(), MATRIX_WAKEUP_SCANNING);
+    EXPECT_EQ(disarm_count, 1);
+}
+
+TEST_F(MatrixWakeupTest, InterruptDuringIdleWakesSameIteration) {
+    run_for(MATRIX_WAKEUP_TIMEOUT + 1);
+    ASSERT_EQ(matrix_wakeup_get_state(), MATRIX_WAKEUP_ASLEEP);
+    reset_matrix_wakeup_idle_count();
+
+    simulate_matrix_wakeup_interrupt_during_idle();
+    EXPECT_TRUE(matrix_wakeup_task());
+    EXPECT_EQ(matrix_wakeup_idle_count(), 1);
+    EXPECT_EQ(matrix_wakeup_get_state(), MATRIX_WAKEUP_SCANNING);
+}
+
+TEST_F(MatrixWakeupTest, ScansThroughDebounceAfterWakeup) {
+    run_for(MATRIX_WAKEUP_TIMEOUT + 1);
+    ASSERT_EQ(matrix_wakeup_get_state(), MATRIX_WAKEUP_ASLEEP);
+
+    // The wakeup is a bounce that never makes it through debounce
+    simulate_matrix_wakeup_interrupt();
+    run_for(MATRIX_WAKEUP_TIMEOUT - 1);
+    EXPECT_EQ(matrix_wakeup_get_state(), MATRIX_WAKEUP_SCANNING);
+    run_for(2);
+    EXPECT_EQ(matrix_wakeup_get_state(), MATRIX_WAKEUP_ASLEEP);
+    EXPECT_EQ(arm_count, 2);
+}
+
+TEST_F(MatrixWakeupTest, InterruptBeforeArmingIsIgnored) {
+    // A stale interrupt while scanning must not cut the next sleep short
+    simulate_matrix_wakeup_interrupt();
+    run_for(MATRIX_WAKEUP_TIMEOUT + 1);
+    ASSERT_EQ(matrix_wakeup_get_state(), MATRIX_WAKEUP_ASLEEP);
+    EXPECT_FALSE(matrix_wakeup_task());
+}
+
+TEST_F(MatrixWakeupTest, FailedArmKeepsScanning) {
+    arm_result = false;
+    run_for(MATRIX_WAKEUP_TIMEOUT + 1);
+    EXPECT_EQ(matrix_wakeup_get_state(), MATRIX_WAKEUP_SCANNING);
+    EXPECT_EQ(arm_count, 1);
+
+    // Retried once per timeout period
+    run_for(MATRIX_WAKEUP_TIMEOUT);
+    EXPECT_EQ(arm_count, 2);
+}
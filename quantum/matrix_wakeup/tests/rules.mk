@@ -0,0 +1,9 @@
+matrix_wakeup_DEFS := -DMATRIX_WAKEUP_ENABLE
+matrix_wakeup_DEFS += -DMATRIX_ROWS=2 -DMATRIX_COLS=4
+matrix_wakeup_DEFS += -DMATRIX_WAKEUP_TIMEOUT=20
+
+matrix_wakeup_SRC := \
+    $(QUANTUM_PATH)/matrix_wakeup/tests/matrix_wakeup_tests.cpp \
+    $(QUANTUM_PATH)/matrix_wakeup.c \
+    $(PLATFORM_PATH)/$(PLATFORM_KEY)/matrix_wakeup.c \
+    $(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
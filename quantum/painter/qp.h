@@ -56,6 +56,32 @@
 #    define QUANTUM_PAINTER_LOAD_FONTS_TO_RAM FALSE
 #endif
 
+#ifndef QUANTUM_PAINTER_FONT_GLYPH_INDEX
+/**
+ * @def This controls whether the unicode glyph table of each font is copied to RAM when it's loaded, so that glyphs
+ *      can be looked up without reading the font's stream. Requires 6 bytes of RAM per unicode glyph. Defaults to
+ *      "off", in which case (or if the RAM could not be allocated) the table is binary searched in place.
+ */
+#    define QUANTUM_PAINTER_FONT_GLYPH_INDEX FALSE
+#endif
+
+#ifndef QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES
+/**
+ * @def This controls the number of decoded glyphs that are kept in the display's native pixel format, so that
+ *      redrawing the same text doesn't decode it again. The least recently drawn glyph is replaced when the cache is
+ *      full. Each entry requires \ref QUANTUM_PAINTER_GLYPH_CACHE_ENTRY_SIZE bytes of RAM. Defaults to "off".
+ */
+#    define QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES 0
+#endif
+
+#ifndef QUANTUM_PAINTER_GLYPH_CACHE_ENTRY_SIZE
+/**
+ * @def This controls the size of each glyph cache entry. Glyphs needing more bytes than this in the display's native
+ *      pixel format are not cached.
+ */
+#    define QUANTUM_PAINTER_GLYPH_CACHE_ENTRY_SIZE 512
+#endif
+
 #ifndef QUANTUM_PAINTER_CONCURRENT_ANIMATIONS
 /**
  * @def This controls the maximum number of animations that Quantum Painter can play simultaneously. Increasing this
@@ -64,6 +90,22 @@
 #    define QUANTUM_PAINTER_CONCURRENT_ANIMATIONS 4
 #endif // QUANTUM_PAINTER_CONCURRENT_ANIMATIONS
 
+#ifndef QUANTUM_PAINTER_IMAGE_CACHE_SIZE
+/**
+ * @def This controls the amount of RAM, in bytes, used to keep decoded image and animation frames in the display's
+ *      native pixel format, so that drawing them again only needs to copy them to the display. When the cache is full,
+ *      the least recently drawn frames are replaced. Frames larger than the cache are always decoded. Defaults to "off".
+ */
+#    define QUANTUM_PAINTER_IMAGE_CACHE_SIZE 0
+#endif
+
+#ifndef QUANTUM_PAINTER_IMAGE_CACHE_ENTRIES
+/**
+ * @def This controls the maximum number of frames held in the image cache at any one time.
+ */
+#    define QUANTUM_PAINTER_IMAGE_CACHE_ENTRIES 16
+#endif
+
 #ifndef QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE
 /**
  * @def This controls the maximum size of the pixel data buffer used for single blocks of transmission. Larger buffers
@@ -72,6 +114,15 @@
 #    define QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE 1024
 #endif
 
+#ifndef QUANTUM_PAINTER_PIXDATA_ASYNC
+/**
+ * @def This controls whether pixel data is transmitted in the background where the display's comms support it, which
+ *      is currently SPI on ChibiOS. The next block of pixel data is decoded into a second pixel data buffer while the
+ *      previous one is sent, at the cost of another QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE bytes of RAM.
+ */
+#    define QUANTUM_PAINTER_PIXDATA_ASYNC FALSE
+#endif
+
 #ifndef QUANTUM_PAINTER_SUPPORTS_256_PALETTE
 /**
  * @def This controls whether 256-color palettes are supported. This has relatively hefty requirements on RAM -- at
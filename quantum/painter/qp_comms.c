@@ -46,6 +46,21 @@ uint32_t qp_comms_send(painter_device_t device, const void *data, uint32_t byte_
     return driver->comms_vtable->comms_send(device, data, byte_count);
 }
 
+uint32_t qp_comms_send_async(painter_device_t device, const void *data, uint32_t byte_count) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+    if (!driver || !driver->validate_ok) {
+        qp_dprintf("qp_comms_send_async: fail (validation_ok == false)\n");
+        return false;
+    }
+
+    // Comms without background transfers send straight away
+    if (!driver->comms_vtable->comms_send_async) {
+        return driver->comms_vtable->comms_send(device, data, byte_count);
+    }
+
+    return driver->comms_vtable->comms_send_async(device, data, byte_count);
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Comms APIs that use a D/C pin
 
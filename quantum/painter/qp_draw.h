@@ -9,8 +9,12 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter utility functions
 
-// Global variable used for native pixel data streaming.
-extern uint8_t qp_internal_global_pixdata_buffer[QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE];
+// Global variable used for native pixel data streaming, pointing at the pixdata buffer currently being filled.
+extern uint8_t *qp_internal_global_pixdata_buffer;
+
+// Switches to the other pixdata buffer after sending the current one, so it can be filled while the previous one is
+// still being transmitted. No-op unless QUANTUM_PAINTER_PIXDATA_ASYNC is enabled.
+void qp_internal_swap_pixdata_buffer(void);
 
 // Check if the supplied bpp is capable of being rendered
 bool qp_internal_bpp_capable(uint8_t bits_per_pixel);
@@ -98,3 +102,11 @@ bool qp_internal_byte_appender(uint8_t byteval, void* cb_arg);
 bool qp_internal_appender(painter_device_t device, uint8_t bpp, uint32_t pixel_count, qp_internal_byte_input_callback input_callback, void* input_state);
 
 qp_internal_byte_input_callback qp_internal_prepare_input_state(qp_internal_byte_input_state_t* input_state, painter_compression_t compression);
+
+// Helpers for keeping decoded pixel data in RAM, in the display's native format:
+//     - qp_internal_native_byte_count returns the size of the buffer needed for the specified number of pixels
+//     - qp_internal_decode_to_native decodes pixels into a buffer instead of sending them to the display
+//     - qp_internal_stream_native sends a decoded buffer to the display, within the current viewport
+uint32_t qp_internal_native_byte_count(painter_device_t device, uint32_t pixel_count);
+bool     qp_internal_decode_to_native(painter_device_t device, uint8_t bpp, uint32_t pixel_count, qp_internal_byte_input_callback input_callback, void* input_state, uint8_t* buffer);
+bool     qp_internal_stream_native(painter_device_t device, const uint8_t* buffer, uint32_t pixel_count);
@@ -139,6 +139,7 @@ bool qp_internal_pixel_appender(qp_pixel_t* palette, uint8_t index, void* cb_arg
         if (!driver->driver_vtable->pixdata(state->device, qp_internal_global_pixdata_buffer, state->pixel_write_pos)) {
             return false;
         }
+        qp_internal_swap_pixdata_buffer();
         state->pixel_write_pos = 0;
     }
 
@@ -159,6 +160,7 @@ bool qp_internal_byte_appender(uint8_t byteval, void* cb_arg) {
         if (!driver->driver_vtable->pixdata(state->device, qp_internal_global_pixdata_buffer, state->byte_write_pos * 8 / driver->native_bits_per_pixel)) {
             return false;
         }
+        qp_internal_swap_pixdata_buffer();
         state->byte_write_pos = 0;
     }
 
@@ -204,6 +206,69 @@ bool qp_internal_appender(painter_device_t device, uint8_t bpp, uint32_t pixel_c
     return ret;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Native-format buffers
+
+typedef struct qp_internal_native_output_state_t {
+    painter_device_t device;
+    uint8_t*         buffer;
+    uint32_t         write_pos; // in pixels for palette-based data, in bytes for native data
+} qp_internal_native_output_state_t;
+
+static bool qp_internal_native_pixel_appender(qp_pixel_t* palette, uint8_t index, void* cb_arg) {
+    qp_internal_native_output_state_t* state  = (qp_internal_native_output_state_t*)cb_arg;
+    painter_driver_t*                  driver = (painter_driver_t*)state->device;
+    return driver->driver_vtable->append_pixels(state->device, state->buffer, palette, state->write_pos++, 1, &index);
+}
+
+static bool qp_internal_native_byte_appender(uint8_t byteval, void* cb_arg) {
+    qp_internal_native_output_state_t* state  = (qp_internal_native_output_state_t*)cb_arg;
+    painter_driver_t*                  driver = (painter_driver_t*)state->device;
+    return driver->driver_vtable->append_pixdata(state->device, state->buffer, state->write_pos++, byteval);
+}
+
+uint32_t qp_internal_native_byte_count(painter_device_t device, uint32_t pixel_count) {
+    painter_driver_t* driver = (painter_driver_t*)device;
+    return (pixel_count * driver->native_bits_per_pixel + 7) / 8;
+}
+
+bool qp_internal_decode_to_native(painter_device_t device, uint8_t bpp, uint32_t pixel_count, qp_internal_byte_input_callback input_callback, void* input_state, uint8_t* buffer) {
+    painter_driver_t*                 driver       = (painter_driver_t*)device;
+    qp_internal_native_output_state_t output_state = {.device = device, .buffer = buffer, .write_pos = 0};
+
+    // Non-native pixel format
+    if (bpp <= 8) {
+        return qp_internal_decode_palette(device, pixel_count, bpp, input_callback, input_state, qp_internal_global_pixel_lookup_table, qp_internal_native_pixel_appender, &output_state);
+    }
+
+    // Native pixel format
+    if (bpp != driver->native_bits_per_pixel) {
+        qp_dprintf("Asset's bpp (%d) doesn't match the target display's native_bits_per_pixel (%d)\n", bpp, driver->native_bits_per_pixel);
+        return false;
+    }
+    return qp_internal_send_bytes(device, pixel_count * bpp / 8, input_callback, input_state, qp_internal_native_byte_appender, &output_state);
+}
+
+bool qp_internal_stream_native(painter_device_t device, const uint8_t* buffer, uint32_t pixel_count) {
+    painter_driver_t* driver     = (painter_driver_t*)device;
+    const uint32_t    max_pixels = qp_internal_num_pixels_in_buffer(device);
+    while (pixel_count > 0) {
+        uint32_t pixels = QP_MIN(pixel_count, max_pixels);
+        uint32_t bytes  = qp_internal_native_byte_count(device, pixels);
+
+        // Sent from the pixel data buffer, as the source may be overwritten before the transfer completes
+        memcpy(qp_internal_global_pixdata_buffer, buffer, bytes);
+        if (!driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, pixels)) {
+            return false;
+        }
+        qp_internal_swap_pixdata_buffer();
+
+        buffer += bytes;
+        pixel_count -= pixels;
+    }
+    return true;
+}
+
 qp_internal_byte_input_callback qp_internal_prepare_input_state(qp_internal_byte_input_state_t* input_state, painter_compression_t compression) {
     switch (compression) {
         case IMAGE_UNCOMPRESSED:
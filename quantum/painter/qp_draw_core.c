@@ -19,8 +19,15 @@ _Static_assert((QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE > 0) && (QUANTUM_PAINTER_PIX
 //       **** very likely get artifacts rendered to the screen as a result.                                       ****
 //
 
-// Buffer used for transmitting native pixel data to the downstream device.
-__attribute__((__aligned__(4))) uint8_t qp_internal_global_pixdata_buffer[QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE];
+// Buffers used for transmitting native pixel data to the downstream device. With asynchronous transmission, one is
+// filled while the other is sent.
+#if QUANTUM_PAINTER_PIXDATA_ASYNC
+#    define QP_PIXDATA_BUFFER_COUNT 2
+#else
+#    define QP_PIXDATA_BUFFER_COUNT 1
+#endif
+__attribute__((__aligned__(4))) static uint8_t qp_internal_global_pixdata_buffers[QP_PIXDATA_BUFFER_COUNT][QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE];
+uint8_t                                       *qp_internal_global_pixdata_buffer = qp_internal_global_pixdata_buffers[0];
 
 // Static buffer to contain a generated color palette
 static bool                                       generated_palette = false;
@@ -41,6 +48,12 @@ uint32_t qp_internal_num_pixels_in_buffer(painter_device_t device) {
     return ((QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE * 8) / driver->native_bits_per_pixel);
 }
 
+void qp_internal_swap_pixdata_buffer(void) {
+#if QUANTUM_PAINTER_PIXDATA_ASYNC
+    qp_internal_global_pixdata_buffer = (qp_internal_global_pixdata_buffer == qp_internal_global_pixdata_buffers[0]) ? qp_internal_global_pixdata_buffers[1] : qp_internal_global_pixdata_buffers[0];
+#endif
+}
+
 // qp_setpixel internal implementation, but accepts a buffer with pre-converted native pixel. Only the first pixel is used.
 bool qp_internal_setpixel_impl(painter_device_t device, uint16_t x, uint16_t y) {
     painter_driver_t *driver = (painter_driver_t *)device;
@@ -24,6 +24,129 @@ typedef struct qgf_image_handle_t {
 
 static qgf_image_handle_t image_descriptors[QUANTUM_PAINTER_NUM_IMAGES] = {0};
 
+typedef struct qgf_frame_info_t {
+    painter_compression_t compression_scheme;
+    uint8_t               bpp;
+    bool                  has_palette;
+    bool                  is_panel_native;
+    bool                  is_delta;
+    uint16_t              left;
+    uint16_t              top;
+    uint16_t              right;
+    uint16_t              bottom;
+    uint16_t              delay;
+} qgf_frame_info_t;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Image cache
+
+#if QUANTUM_PAINTER_IMAGE_CACHE_SIZE > 0
+
+typedef struct qp_image_cache_entry_t {
+    painter_device_t    device;
+    qgf_image_handle_t *image;
+    uint16_t            frame_number;
+    bool                recolored; // whether the frame depends on the fg/bg colors
+    qp_pixel_t          fg_hsv888;
+    qp_pixel_t          bg_hsv888;
+    qgf_frame_info_t    frame_info;
+    uint32_t            offset; // location of the pixel data in the cache buffer
+    uint32_t            length;
+    uint32_t            last_used; // zero if the entry is free
+} qp_image_cache_entry_t;
+
+static qp_image_cache_entry_t image_cache[QUANTUM_PAINTER_IMAGE_CACHE_ENTRIES] = {0};
+static uint8_t                image_cache_data[QUANTUM_PAINTER_IMAGE_CACHE_SIZE] __attribute__((aligned(4)));
+static uint32_t               image_cache_clock = 0;
+
+static inline bool qp_image_cache_colors_match(qp_pixel_t a, qp_pixel_t b) {
+    return a.hsv888.h == b.hsv888.h && a.hsv888.s == b.hsv888.s && a.hsv888.v == b.hsv888.v;
+}
+
+static qp_image_cache_entry_t *qp_image_cache_find(painter_device_t device, qgf_image_handle_t *qgf_image, uint16_t frame_number, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888) {
+    for (int i = 0; i < QUANTUM_PAINTER_IMAGE_CACHE_ENTRIES; ++i) {
+        qp_image_cache_entry_t *entry = &image_cache[i];
+        if (!entry->last_used || entry->device != device || entry->image != qgf_image || entry->frame_number != frame_number) {
+            continue;
+        }
+        if (entry->recolored && !(qp_image_cache_colors_match(entry->fg_hsv888, fg_hsv888) && qp_image_cache_colors_match(entry->bg_hsv888, bg_hsv888))) {
+            continue;
+        }
+        entry->last_used = ++image_cache_clock;
+        return entry;
+    }
+    return NULL;
+}
+
+// Finds space in the cache buffer that isn't used by any entry
+static bool qp_image_cache_find_space(uint32_t length, uint32_t *offset) {
+    // Candidate locations are the start of the buffer, and the end of each entry
+    for (int i = -1; i < QUANTUM_PAINTER_IMAGE_CACHE_ENTRIES; ++i) {
+        if (i >= 0 && !image_cache[i].last_used) {
+            continue;
+        }
+        uint32_t candidate = i < 0 ? 0 : image_cache[i].offset + image_cache[i].length;
+        if (candidate + length > QUANTUM_PAINTER_IMAGE_CACHE_SIZE) {
+            continue;
+        }
+
+        bool overlaps = false;
+        for (int j = 0; j < QUANTUM_PAINTER_IMAGE_CACHE_ENTRIES && !overlaps; ++j) {
+            qp_image_cache_entry_t *entry = &image_cache[j];
+            overlaps                      = entry->last_used && candidate < entry->offset + entry->length && entry->offset < candidate + length;
+        }
+        if (!overlaps) {
+            *offset = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Allocates an entry with the requested amount of space, replacing the least recently used entries until it fits
+static qp_image_cache_entry_t *qp_image_cache_allocate(uint32_t length) {
+    // Keep each entry's data 4-byte aligned
+    length = (length + 3) & ~3u;
+    if (length > QUANTUM_PAINTER_IMAGE_CACHE_SIZE) {
+        return NULL;
+    }
+
+    while (true) {
+        qp_image_cache_entry_t *free_entry = NULL;
+        qp_image_cache_entry_t *lru_entry  = NULL;
+        for (int i = 0; i < QUANTUM_PAINTER_IMAGE_CACHE_ENTRIES; ++i) {
+            qp_image_cache_entry_t *entry = &image_cache[i];
+            if (!entry->last_used) {
+                free_entry = free_entry ? free_entry : entry;
+            } else if (!lru_entry || entry->last_used < lru_entry->last_used) {
+                lru_entry = entry;
+            }
+        }
+
+        uint32_t offset;
+        if (free_entry && qp_image_cache_find_space(length, &offset)) {
+            free_entry->offset = offset;
+            free_entry->length = length;
+            return free_entry;
+        }
+
+        if (!lru_entry) {
+            return NULL;
+        }
+        lru_entry->last_used = 0;
+    }
+}
+
+static void qp_image_cache_drop_image(qgf_image_handle_t *qgf_image) {
+    for (int i = 0; i < QUANTUM_PAINTER_IMAGE_CACHE_ENTRIES; ++i) {
+        if (image_cache[i].image == qgf_image) {
+            image_cache[i].last_used = 0;
+        }
+    }
+}
+
+#endif // QUANTUM_PAINTER_IMAGE_CACHE_SIZE > 0
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Helper: load image from stream
 
@@ -95,6 +218,10 @@ bool qp_close_image(painter_image_handle_t image) {
         return false;
     }
 
+#if QUANTUM_PAINTER_IMAGE_CACHE_SIZE > 0
+    qp_image_cache_drop_image(qgf_image);
+#endif // QUANTUM_PAINTER_IMAGE_CACHE_SIZE > 0
+
     // Free up this image for use elsewhere.
     qgf_image->validate_ok = false;
     qp_stream_close(&qgf_image->stream);
@@ -111,19 +238,6 @@ bool qp_drawimage(painter_device_t device, uint16_t x, uint16_t y, painter_image
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter External API: qp_drawimage_recolor
 
-typedef struct qgf_frame_info_t {
-    painter_compression_t compression_scheme;
-    uint8_t               bpp;
-    bool                  has_palette;
-    bool                  is_panel_native;
-    bool                  is_delta;
-    uint16_t              left;
-    uint16_t              top;
-    uint16_t              right;
-    uint16_t              bottom;
-    uint16_t              delay;
-} qgf_frame_info_t;
-
 static bool qp_drawimage_prepare_frame_for_stream_read(painter_device_t device, qgf_image_handle_t *qgf_image, uint16_t frame_number, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, qgf_frame_info_t *info) {
     painter_driver_t *driver = (painter_driver_t *)device;
 
@@ -222,8 +336,18 @@ static bool qp_drawimage_recolor_impl(painter_device_t device, uint16_t x, uint1
         return false;
     }
 
+    bool cached = false;
+#if QUANTUM_PAINTER_IMAGE_CACHE_SIZE > 0
+    // Frames that have been drawn before don't need to be read from the stream
+    qp_image_cache_entry_t *entry = qp_image_cache_find(device, qgf_image, frame_number, fg_hsv888, bg_hsv888);
+    if (entry) {
+        *frame_info = entry->frame_info;
+        cached      = true;
+    }
+#endif // QUANTUM_PAINTER_IMAGE_CACHE_SIZE > 0
+
     // Read the frame info
-    if (!qp_drawimage_prepare_frame_for_stream_read(device, qgf_image, frame_number, fg_hsv888, bg_hsv888, frame_info)) {
+    if (!cached && !qp_drawimage_prepare_frame_for_stream_read(device, qgf_image, frame_number, fg_hsv888, bg_hsv888, frame_info)) {
         qp_dprintf("qp_drawimage_recolor: fail (could not read frame %d)\n", frame_number);
         return false;
     }
@@ -254,6 +378,15 @@ static bool qp_drawimage_recolor_impl(painter_device_t device, uint16_t x, uint1
         return false;
     }
 
+#if QUANTUM_PAINTER_IMAGE_CACHE_SIZE > 0
+    if (cached) {
+        bool ret = qp_internal_stream_native(device, &image_cache_data[entry->offset], pixel_count);
+        qp_dprintf("qp_drawimage_recolor: %s (cached)\n", ret ? "ok" : "fail");
+        qp_comms_stop(device);
+        return ret;
+    }
+#endif // QUANTUM_PAINTER_IMAGE_CACHE_SIZE > 0
+
     // Set up the input state
     qp_internal_byte_input_state_t  input_state    = {.device = device, .src_stream = &qgf_image->stream};
     qp_internal_byte_input_callback input_callback = qp_internal_prepare_input_state(&input_state, frame_info->compression_scheme);
@@ -263,6 +396,28 @@ static bool qp_drawimage_recolor_impl(painter_device_t device, uint16_t x, uint1
         return false;
     }
 
+#if QUANTUM_PAINTER_IMAGE_CACHE_SIZE > 0
+    // Decode the frame into the cache if it fits, and send it from there
+    entry = qp_image_cache_allocate(qp_internal_native_byte_count(device, pixel_count));
+    if (entry) {
+        bool ret = qp_internal_decode_to_native(device, frame_info->bpp, pixel_count, input_callback, &input_state, &image_cache_data[entry->offset]);
+        if (ret) {
+            entry->device       = device;
+            entry->image        = qgf_image;
+            entry->frame_number = frame_number;
+            entry->recolored    = !frame_info->has_palette && frame_info->bpp <= 8;
+            entry->fg_hsv888    = fg_hsv888;
+            entry->bg_hsv888    = bg_hsv888;
+            entry->frame_info   = *frame_info;
+            entry->last_used    = ++image_cache_clock;
+            ret                 = qp_internal_stream_native(device, &image_cache_data[entry->offset], pixel_count);
+        }
+        qp_dprintf("qp_drawimage_recolor: %s\n", ret ? "ok" : "fail");
+        qp_comms_stop(device);
+        return ret;
+    }
+#endif // QUANTUM_PAINTER_IMAGE_CACHE_SIZE > 0
+
     // Decode and stream pixels
     bool ret = qp_internal_appender(device, frame_info->bpp, pixel_count, input_callback, &input_state);
 
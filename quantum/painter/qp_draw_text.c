@@ -21,6 +21,9 @@ typedef struct qff_font_handle_t {
     bool                  has_palette;
     bool                  is_panel_native;
     painter_compression_t compression_scheme;
+    bool                  unicode_table_sorted;
+    uint32_t              unicode_table_offset; // offset of the first unicode glyph entry
+    uint32_t              glyph_data_offset;    // offset of the first byte of glyph data
     union {
         qp_stream_t        stream;
         qp_memory_stream_t mem_stream;
@@ -32,10 +35,160 @@ typedef struct qff_font_handle_t {
     bool  owns_buffer;
     void *buffer;
 #endif // QUANTUM_PAINTER_LOAD_FONTS_TO_RAM
+#if QUANTUM_PAINTER_FONT_GLYPH_INDEX
+    qff_unicode_glyph_v1_t *unicode_index;
+#endif // QUANTUM_PAINTER_FONT_GLYPH_INDEX
 } qff_font_handle_t;
 
 static qff_font_handle_t font_descriptors[QUANTUM_PAINTER_NUM_FONTS] = {0};
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Glyph cache
+
+#if QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+
+typedef struct qp_glyph_cache_entry_t {
+    painter_device_t   device;
+    qff_font_handle_t *font;
+    uint32_t           code_point;
+    qp_pixel_t         fg_hsv888; // both zero for fonts with their own palette
+    qp_pixel_t         bg_hsv888;
+    uint32_t           last_used; // zero if the entry is free
+    uint8_t            data[QUANTUM_PAINTER_GLYPH_CACHE_ENTRY_SIZE] __attribute__((aligned(4)));
+} qp_glyph_cache_entry_t;
+
+static qp_glyph_cache_entry_t glyph_cache[QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES] = {0};
+static uint32_t               glyph_cache_clock                                = 0;
+
+static inline bool qp_glyph_cache_colors_match(qp_pixel_t a, qp_pixel_t b) {
+    return a.hsv888.h == b.hsv888.h && a.hsv888.s == b.hsv888.s && a.hsv888.v == b.hsv888.v;
+}
+
+static qp_glyph_cache_entry_t *qp_glyph_cache_find(painter_device_t device, qff_font_handle_t *qff_font, uint32_t code_point, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888) {
+    for (int i = 0; i < QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES; ++i) {
+        qp_glyph_cache_entry_t *entry = &glyph_cache[i];
+        if (entry->last_used && entry->device == device && entry->font == qff_font && entry->code_point == code_point && qp_glyph_cache_colors_match(entry->fg_hsv888, fg_hsv888) && qp_glyph_cache_colors_match(entry->bg_hsv888, bg_hsv888)) {
+            entry->last_used = ++glyph_cache_clock;
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+static qp_glyph_cache_entry_t *qp_glyph_cache_evict(void) {
+    // Pick a free entry, otherwise the least recently used one
+    qp_glyph_cache_entry_t *victim = &glyph_cache[0];
+    for (int i = 0; i < QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES && victim->last_used; ++i) {
+        if (glyph_cache[i].last_used < victim->last_used) {
+            victim = &glyph_cache[i];
+        }
+    }
+    victim->last_used = 0;
+    return victim;
+}
+
+static void qp_glyph_cache_drop_font(qff_font_handle_t *qff_font) {
+    for (int i = 0; i < QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES; ++i) {
+        if (glyph_cache[i].font == qff_font) {
+            glyph_cache[i].last_used = 0;
+        }
+    }
+}
+
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Helper: unicode glyph lookup
+
+// Reads the unicode glyph entry at the specified index of the (sorted, if indexed) table
+static inline bool qp_font_read_unicode_glyph(qff_font_handle_t *font, uint16_t index, qff_unicode_glyph_v1_t *glyph_info) {
+#if QUANTUM_PAINTER_FONT_GLYPH_INDEX
+    if (font->unicode_index) {
+        *glyph_info = font->unicode_index[index];
+        return true;
+    }
+#endif // QUANTUM_PAINTER_FONT_GLYPH_INDEX
+
+    if (qp_stream_setpos(&font->stream, font->unicode_table_offset + index * sizeof(qff_unicode_glyph_v1_t)) < 0) {
+        qp_dprintf("Failed to set stream position while reading unicode glyph info\n");
+        return false;
+    }
+    return qp_stream_read(glyph_info, sizeof(qff_unicode_glyph_v1_t), 1, &font->stream) == 1;
+}
+
+static bool qp_font_find_unicode_glyph(qff_font_handle_t *font, uint32_t code_point, qff_unicode_glyph_v1_t *glyph_info) {
+    if (!font->unicode_table_sorted) {
+        // Tables not written in code point order can only be searched linearly
+        for (uint16_t i = 0; i < font->num_unicode_glyphs; ++i) {
+            if (!qp_font_read_unicode_glyph(font, i, glyph_info)) {
+                return false;
+            }
+            if (glyph_info->code_point == code_point) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    uint16_t lower = 0;
+    uint16_t upper = font->num_unicode_glyphs;
+    while (lower < upper) {
+        uint16_t middle = lower + (upper - lower) / 2;
+        if (!qp_font_read_unicode_glyph(font, middle, glyph_info)) {
+            return false;
+        }
+        if (glyph_info->code_point == code_point) {
+            return true;
+        }
+        if (glyph_info->code_point < code_point) {
+            lower = middle + 1;
+        } else {
+            upper = middle;
+        }
+    }
+    return false;
+}
+
+// Builds the code point index for the unicode glyph table, falling back to searching the table in the stream
+static void qp_font_build_unicode_index(qff_font_handle_t *font) {
+    font->unicode_table_sorted = true;
+
+#if QUANTUM_PAINTER_FONT_GLYPH_INDEX
+    font->unicode_index = NULL;
+    if (font->num_unicode_glyphs > 0) {
+        qff_unicode_glyph_v1_t *index = malloc(font->num_unicode_glyphs * sizeof(qff_unicode_glyph_v1_t));
+        if (index != NULL && qp_stream_setpos(&font->stream, font->unicode_table_offset) >= 0 && qp_stream_read(index, sizeof(qff_unicode_glyph_v1_t), font->num_unicode_glyphs, &font->stream) == font->num_unicode_glyphs) {
+            // QMK's font generator writes the table in code point order, so this is normally a single pass
+            for (uint16_t i = 1; i < font->num_unicode_glyphs; ++i) {
+                qff_unicode_glyph_v1_t glyph_info = index[i];
+                uint16_t               j          = i;
+                while (j > 0 && index[j - 1].code_point > glyph_info.code_point) {
+                    index[j] = index[j - 1];
+                    --j;
+                }
+                index[j] = glyph_info;
+            }
+            font->unicode_index = index;
+            return;
+        }
+
+        qp_dprintf("qp_load_font: could not build the unicode glyph index, falling back to the stream\n");
+        free(index);
+    }
+#endif // QUANTUM_PAINTER_FONT_GLYPH_INDEX
+
+    // Binary search the table in place, unless its code points are out of order
+    qff_unicode_glyph_v1_t glyph_info;
+    uint32_t               previous = 0;
+    for (uint16_t i = 0; i < font->num_unicode_glyphs; ++i) {
+        if (!qp_font_read_unicode_glyph(font, i, &glyph_info) || (i > 0 && glyph_info.code_point <= previous)) {
+            font->unicode_table_sorted = false;
+            break;
+        }
+        previous = glyph_info.code_point;
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Helper: load font from stream
 
@@ -106,6 +259,19 @@ static painter_font_handle_t qp_load_font_internal(bool (*stream_factory)(qff_fo
         return NULL;
     }
 
+    // Work out where the glyph tables and data live
+    font->unicode_table_offset = sizeof(qff_font_descriptor_v1_t)                                       // Skip the font descriptor
+                                 + (font->has_ascii_table ? sizeof(qff_ascii_glyph_table_v1_t) : 0)     // Skip the ascii table
+                                 + sizeof(qgf_block_header_v1_t);                                       // Skip the unicode block header
+    font->glyph_data_offset    = sizeof(qff_font_descriptor_v1_t)                                                                                                                // Skip the font descriptor
+                              + (font->has_ascii_table ? sizeof(qff_ascii_glyph_table_v1_t) : 0)                                                                                 // Skip the ascii table
+                              + (font->num_unicode_glyphs > 0 ? (sizeof(qff_unicode_glyph_table_v1_t) + (font->num_unicode_glyphs * sizeof(qff_unicode_glyph_v1_t))) : 0) // Skip the unicode table
+                              + (font->has_palette ? (sizeof(qgf_palette_v1_t) + ((1 << font->bpp) * sizeof(qgf_palette_entry_v1_t))) : 0)                                    // Skip the palette
+                              + sizeof(qgf_block_header_v1_t);                                                                                                                   // Skip the data block header
+
+    // Index the unicode glyphs, so they can be found without scanning the table on every lookup
+    qp_font_build_unicode_index(font);
+
     // Validation success, we can return the handle
     font->validate_ok = true;
     qp_dprintf("qp_load_font: ok\n");
@@ -151,6 +317,15 @@ bool qp_close_font(painter_font_handle_t font) {
     }
 #endif // QUANTUM_PAINTER_LOAD_FONTS_TO_RAM
 
+#if QUANTUM_PAINTER_FONT_GLYPH_INDEX
+    free(qff_font->unicode_index);
+    qff_font->unicode_index = NULL;
+#endif // QUANTUM_PAINTER_FONT_GLYPH_INDEX
+
+#if QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+    qp_glyph_cache_drop_font(qff_font);
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+
     // Free up this font for use elsewhere.
     qp_stream_close(&qff_font->stream);
     qff_font->validate_ok = false;
@@ -215,6 +390,7 @@ static inline bool qp_drawtext_prepare_font_for_render(painter_device_t device,
 }
 
 static inline bool qp_drawtext_prepare_glyph_for_render(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t *width) {
+    uint32_t glyph_value;
     if (code_point >= 0x20 && code_point < 0x7F && qff_font->has_ascii_table) {
         // Do ascii table
         qff_ascii_glyph_v1_t glyph_info;
@@ -231,65 +407,27 @@ static inline bool qp_drawtext_prepare_glyph_for_render(qff_font_handle_t *qff_f
             return false;
         }
 
-        uint8_t  glyph_width  = (uint8_t)(glyph_info.value & QFF_GLYPH_WIDTH_MASK);
-        uint32_t glyph_offset = ((glyph_info.value & QFF_GLYPH_OFFSET_MASK) >> QFF_GLYPH_WIDTH_BITS);
-        uint32_t data_offset  = sizeof(qff_font_descriptor_v1_t)                                                                                                                   // Skip the font descriptor
-                               + (qff_font->has_ascii_table ? sizeof(qff_ascii_glyph_table_v1_t) : 0)                                                                              // Skip the ascii table
-                               + (qff_font->num_unicode_glyphs > 0 ? (sizeof(qff_unicode_glyph_table_v1_t) + (qff_font->num_unicode_glyphs * sizeof(qff_unicode_glyph_v1_t))) : 0) // Skip the unicode table
-                               + (qff_font->has_palette ? (sizeof(qgf_palette_v1_t) + ((1 << qff_font->bpp) * sizeof(qgf_palette_entry_v1_t))) : 0)                                // Skip the palette
-                               + sizeof(qgf_block_header_v1_t)                                                                                                                     // Skip the data block header
-                               + glyph_offset;                                                                                                                                     // Jump to the specified glyph offset
-
-        if (qp_stream_setpos(&qff_font->stream, data_offset) < 0) {
-            qp_dprintf("Failed to set stream position while preparing ascii glyph data\n");
-            return false;
-        }
-
-        *width = glyph_width;
-        return true;
+        glyph_value = glyph_info.value;
     } else {
         // Do unicode table, which may include singular ascii glyphs if full ascii table isn't specified
-        uint32_t glyph_info_offset = sizeof(qff_font_descriptor_v1_t)                                       // Skip the font descriptor
-                                     + (qff_font->has_ascii_table ? sizeof(qff_ascii_glyph_table_v1_t) : 0) // Skip the ascii table
-                                     + sizeof(qgf_block_header_v1_t);                                       // Skip the unicode block header
-
-        if (qp_stream_setpos(&qff_font->stream, glyph_info_offset) < 0) {
-            qp_dprintf("Failed to set stream position while preparing glyph data\n");
+        qff_unicode_glyph_v1_t glyph_info;
+        if (!qp_font_find_unicode_glyph(qff_font, code_point, &glyph_info)) {
+            qp_dprintf("Failed to find unicode glyph info\n");
             return false;
         }
 
-        qff_unicode_glyph_v1_t glyph_info;
-        for (uint16_t i = 0; i < qff_font->num_unicode_glyphs; ++i) {
-            if (qp_stream_read(&glyph_info, sizeof(qff_unicode_glyph_v1_t), 1, &qff_font->stream) != 1) {
-                qp_dprintf("Failed to set stream position while reading unicode glyph info\n");
-                return false;
-            }
-
-            if (glyph_info.code_point == code_point) {
-                uint8_t  glyph_width  = (uint8_t)(glyph_info.value & QFF_GLYPH_WIDTH_MASK);
-                uint32_t glyph_offset = ((glyph_info.value & QFF_GLYPH_OFFSET_MASK) >> QFF_GLYPH_WIDTH_BITS);
-                uint32_t data_offset  = sizeof(qff_font_descriptor_v1_t)                                                                                                                   // Skip the font descriptor
-                                       + (qff_font->has_ascii_table ? sizeof(qff_ascii_glyph_table_v1_t) : 0)                                                                              // Skip the ascii table
-                                       + (qff_font->num_unicode_glyphs > 0 ? (sizeof(qff_unicode_glyph_table_v1_t) + (qff_font->num_unicode_glyphs * sizeof(qff_unicode_glyph_v1_t))) : 0) // Skip the unicode table
-                                       + (qff_font->has_palette ? (sizeof(qgf_palette_v1_t) + ((1 << qff_font->bpp) * sizeof(qgf_palette_entry_v1_t))) : 0)                                // Skip the palette
-                                       + sizeof(qgf_block_header_v1_t)                                                                                                                     // Skip the data block header
-                                       + glyph_offset;                                                                                                                                     // Jump to the specified glyph offset
-
-                if (qp_stream_setpos(&qff_font->stream, data_offset) < 0) {
-                    qp_dprintf("Failed to set stream position while preparing unicode glyph data\n");
-                    return false;
-                }
-
-                *width = glyph_width;
-                return true;
-            }
-        }
+        glyph_value = glyph_info.value;
+    }
 
-        // Not found
-        qp_dprintf("Failed to find unicode glyph info\n");
+    uint8_t  glyph_width  = (uint8_t)(glyph_value & QFF_GLYPH_WIDTH_MASK);
+    uint32_t glyph_offset = ((glyph_value & QFF_GLYPH_OFFSET_MASK) >> QFF_GLYPH_WIDTH_BITS);
+    if (qp_stream_setpos(&qff_font->stream, qff_font->glyph_data_offset + glyph_offset) < 0) {
+        qp_dprintf("Failed to set stream position while preparing glyph data\n");
         return false;
     }
-    return false;
+
+    *width = glyph_width;
+    return true;
 }
 
 // Function to iterate over each UTF8 codepoint, invoking the callback for each decoded glyph
@@ -345,6 +483,8 @@ typedef struct code_point_iter_drawglyph_state_t {
     qp_internal_byte_input_callback   input_callback;
     qp_internal_byte_input_state_t *  input_state;
     qp_internal_pixel_output_state_t *output_state;
+    qp_pixel_t                        fg_hsv888;
+    qp_pixel_t                        bg_hsv888;
 } code_point_iter_drawglyph_state_t;
 
 // Codepoint handler callback: drawing
@@ -366,6 +506,27 @@ static inline bool qp_font_code_point_handler_drawglyph(qff_font_handle_t *qff_f
 
     // Decode the pixel data for the glyph, and stream it
     uint32_t pixel_count = ((uint32_t)width) * height;
+
+#if QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+    // Palette-based glyphs which fit in the cache are only decoded the first time they're drawn
+    if (qff_font->bpp <= 8 && qp_internal_native_byte_count(state->device, pixel_count) <= QUANTUM_PAINTER_GLYPH_CACHE_ENTRY_SIZE) {
+        qp_glyph_cache_entry_t *entry = qp_glyph_cache_find(state->device, qff_font, code_point, state->fg_hsv888, state->bg_hsv888);
+        if (!entry) {
+            entry = qp_glyph_cache_evict();
+            if (!qp_internal_decode_to_native(state->device, qff_font->bpp, pixel_count, state->input_callback, state->input_state, entry->data)) {
+                return false;
+            }
+            entry->device     = state->device;
+            entry->font       = qff_font;
+            entry->code_point = code_point;
+            entry->fg_hsv888  = state->fg_hsv888;
+            entry->bg_hsv888  = state->bg_hsv888;
+            entry->last_used  = ++glyph_cache_clock;
+        }
+        return qp_internal_stream_native(state->device, entry->data, pixel_count);
+    }
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+
     return qp_internal_appender(state->device, qff_font->bpp, pixel_count, state->input_callback, state->input_state);
 }
 
@@ -428,6 +589,9 @@ int16_t qp_drawtext_recolor(painter_device_t device, uint16_t x, uint16_t y, pai
     // Set up the pixel output state
     qp_internal_pixel_output_state_t output_state = {.device = device, .pixel_write_pos = 0, .max_pixels = qp_internal_num_pixels_in_buffer(device)};
 
+    qp_pixel_t fg_hsv888 = {.hsv888 = {.h = hue_fg, .s = sat_fg, .v = val_fg}};
+    qp_pixel_t bg_hsv888 = {.hsv888 = {.h = hue_bg, .s = sat_bg, .v = val_bg}};
+
     // Set up the codepoint iteration state
     code_point_iter_drawglyph_state_t state = {// Common
                                                .device = device,
@@ -437,10 +601,11 @@ int16_t qp_drawtext_recolor(painter_device_t device, uint16_t x, uint16_t y, pai
                                                .input_callback = input_callback,
                                                .input_state    = &input_state,
                                                // Output
-                                               .output_state = &output_state};
+                                               .output_state = &output_state,
+                                               // Colors, which don't apply to fonts with their own palette
+                                               .fg_hsv888 = qff_font->has_palette ? (qp_pixel_t){0} : fg_hsv888,
+                                               .bg_hsv888 = qff_font->has_palette ? (qp_pixel_t){0} : bg_hsv888};
 
-    qp_pixel_t fg_hsv888 = {.hsv888 = {.h = hue_fg, .s = sat_fg, .v = val_fg}};
-    qp_pixel_t bg_hsv888 = {.hsv888 = {.h = hue_bg, .s = sat_bg, .v = val_bg}};
     uint32_t   data_offset;
     if (!qp_drawtext_prepare_font_for_render(driver, qff_font, fg_hsv888, bg_hsv888, &data_offset)) {
         qp_dprintf("qp_drawtext_recolor: fail (failed to prepare font for rendering)\n");
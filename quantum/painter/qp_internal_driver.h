@@ -44,6 +44,10 @@ typedef struct painter_comms_vtable_t {
     painter_driver_comms_start_func comms_start;
     painter_driver_comms_stop_func  comms_stop;
     painter_driver_comms_send_func  comms_send;
+
+    // Optional, returns once the data is being sent. The data has to stay unchanged until the next comms call, which
+    // waits for the transfer to finish.
+    painter_driver_comms_send_func comms_send_async;
 } painter_comms_vtable_t;
 
 typedef void (*painter_driver_comms_send_command_func)(painter_device_t device, uint8_t cmd);
@@ -25,6 +25,13 @@
 #    include "mousekey.h"
 #endif
 
+#ifdef POINTING_DEVICE_ACCUMULATE_MOTION
+#    include "host.h"
+#    if defined(SPLIT_POINTING_ENABLE) && defined(POINTING_DEVICE_COMBINED)
+#        error POINTING_DEVICE_ACCUMULATE_MOTION not supported with POINTING_DEVICE_COMBINED.
+#    endif
+#endif
+
 #if (defined(POINTING_DEVICE_ROTATION_90) + defined(POINTING_DEVICE_ROTATION_180) + defined(POINTING_DEVICE_ROTATION_270)) > 1
 #    error More than one rotation selected.  This is not supported.
 #endif
@@ -79,6 +86,70 @@ uint16_t pointing_device_get_shared_cpi(void) {
 static report_mouse_t local_mouse_report         = {};
 static bool           pointing_device_force_send = false;
 
+#ifdef POINTING_DEVICE_ACCUMULATE_MOTION
+typedef struct {
+    int16_t x;
+    int16_t y;
+    int16_t h;
+    int16_t v;
+} pointing_device_motion_t;
+
+// Motion read from the sensor that hasn't been sent to the host yet
+static pointing_device_motion_t accumulated_motion = {};
+
+static inline int16_t pointing_device_add_saturated(int16_t total, int16_t delta) {
+    int32_t sum = (int32_t)total + delta;
+    return sum < INT16_MIN ? INT16_MIN : (sum > INT16_MAX ? INT16_MAX : sum);
+}
+
+static inline int16_t pointing_device_take_motion(int16_t *total, int16_t min, int16_t max) {
+    int16_t taken = *total < min ? min : (*total > max ? max : *total);
+    *total -= taken;
+    return taken;
+}
+
+/**
+ * @brief Moves the motion in a mouse report into the accumulated motion
+ *
+ * @param[in] mouse_report report_mouse_t
+ * @return report_mouse_t without motion
+ */
+static report_mouse_t pointing_device_accumulate_motion(report_mouse_t mouse_report) {
+    accumulated_motion.x = pointing_device_add_saturated(accumulated_motion.x, mouse_report.x);
+    accumulated_motion.y = pointing_device_add_saturated(accumulated_motion.y, mouse_report.y);
+    accumulated_motion.h = pointing_device_add_saturated(accumulated_motion.h, mouse_report.h);
+    accumulated_motion.v = pointing_device_add_saturated(accumulated_motion.v, mouse_report.v);
+    mouse_report.x       = 0;
+    mouse_report.y       = 0;
+    mouse_report.h       = 0;
+    mouse_report.v       = 0;
+    return mouse_report;
+}
+
+/**
+ * @brief Moves as much accumulated motion as fits into a mouse report, the rest is kept for the next one
+ *
+ * @param[in] mouse_report report_mouse_t
+ * @return report_mouse_t with the accumulated motion
+ */
+static report_mouse_t pointing_device_release_motion(report_mouse_t mouse_report) {
+    mouse_report.x = pointing_device_take_motion(&accumulated_motion.x, XY_REPORT_MIN, XY_REPORT_MAX);
+    mouse_report.y = pointing_device_take_motion(&accumulated_motion.y, XY_REPORT_MIN, XY_REPORT_MAX);
+    mouse_report.h = pointing_device_take_motion(&accumulated_motion.h, INT8_MIN, INT8_MAX);
+    mouse_report.v = pointing_device_take_motion(&accumulated_motion.v, INT8_MIN, INT8_MAX);
+    return mouse_report;
+}
+#endif // POINTING_DEVICE_ACCUMULATE_MOTION
+
+#ifdef POINTING_DEVICE_SUBPIXEL_ENABLE
+#    if defined(SPLIT_POINTING_ENABLE) && defined(POINTING_DEVICE_COMBINED)
+// Motion not sent yet of this side's and the other side's pointing device
+static pointing_device_subpixel_t subpixel_motion[2] = {};
+#    else
+static pointing_device_subpixel_t subpixel_motion[1] = {};
+#    endif
+#endif
+
 extern const pointing_device_driver_t pointing_device_driver;
 
 /**
@@ -156,6 +227,12 @@ __attribute__((weak)) void pointing_device_init(void) {
 #endif
     }
 
+#ifdef POINTING_DEVICE_SUBPIXEL_ENABLE
+    for (uint8_t i = 0; i < sizeof(subpixel_motion) / sizeof(subpixel_motion[0]); i++) {
+        pointing_device_subpixel_clear(&subpixel_motion[i]);
+    }
+#endif
+
     pointing_device_init_kb();
     pointing_device_init_user();
 }
@@ -273,6 +350,15 @@ __attribute__((weak)) bool pointing_device_task(void) {
     }
 #endif
 
+#ifdef POINTING_DEVICE_ACCUMULATE_MOTION
+    // Sum up motion until the host has taken the previous report, so exactly one report goes out per host poll
+    local_mouse_report = pointing_device_accumulate_motion(local_mouse_report);
+    if (!host_mouse_ready()) {
+        return false;
+    }
+    local_mouse_report = pointing_device_release_motion(local_mouse_report);
+#endif
+
     // allow kb to intercept and modify report
 #if defined(SPLIT_POINTING_ENABLE) && defined(POINTING_DEVICE_COMBINED)
     if (is_keyboard_left()) {
@@ -282,9 +368,16 @@ __attribute__((weak)) bool pointing_device_task(void) {
         local_mouse_report  = pointing_device_adjust_by_defines_right(local_mouse_report);
         shared_mouse_report = pointing_device_adjust_by_defines(shared_mouse_report);
     }
+#    ifdef POINTING_DEVICE_SUBPIXEL_ENABLE
+    local_mouse_report  = pointing_device_subpixel_apply(&subpixel_motion[0], local_mouse_report);
+    shared_mouse_report = pointing_device_subpixel_apply(&subpixel_motion[1], shared_mouse_report);
+#    endif
     local_mouse_report = is_keyboard_left() ? pointing_device_task_combined_kb(local_mouse_report, shared_mouse_report) : pointing_device_task_combined_kb(shared_mouse_report, local_mouse_report);
 #else
     local_mouse_report = pointing_device_adjust_by_defines(local_mouse_report);
+#    ifdef POINTING_DEVICE_SUBPIXEL_ENABLE
+    local_mouse_report = pointing_device_subpixel_apply(&subpixel_motion[0], local_mouse_report);
+#    endif
     local_mouse_report = pointing_device_task_kb(local_mouse_report);
 #endif
     // automatic mouse layer function
@@ -0,0 +1,178 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#ifdef POINTING_DEVICE_SUBPIXEL_ENABLE
+
+#    include <stddef.h>
+#    include "pointing_device.h"
+
+/* largest motion kept, matching what the accumulated motion holds */
+#    define POINTING_DEVICE_FIXED_MAX ((pointing_device_fixed_t)INT16_MAX << POINTING_DEVICE_FIXED_SHIFT)
+
+static uint16_t scale = POINTING_DEVICE_SCALE;
+
+#    ifdef POINTING_DEVICE_ACCEL_CURVE
+static const pointing_device_accel_point_t  default_accel_curve[] = POINTING_DEVICE_ACCEL_CURVE;
+static const pointing_device_accel_point_t *accel_curve           = default_accel_curve;
+static uint8_t                              accel_curve_count     = sizeof(default_accel_curve) / sizeof(default_accel_curve[0]);
+#    else
+static const pointing_device_accel_point_t *accel_curve       = NULL;
+static uint8_t                              accel_curve_count = 0;
+#    endif
+
+/**
+ * @brief Sets the factor applied to sensor motion
+ *
+ * @param[in] new_scale Q8.8 factor, e.g. POINTING_DEVICE_FIXED(0.5) to halve the motion
+ */
+void pointing_device_set_scale(uint16_t new_scale) {
+    scale = new_scale;
+}
+
+/**
+ * @brief Gets the factor applied to sensor motion
+ *
+ * @return Q8.8 factor
+ */
+uint16_t pointing_device_get_scale(void) {
+    return scale;
+}
+
+/**
+ * @brief Sets the acceleration curve used by pointing_device_accel_gain
+ *
+ * The points have to be sorted by speed and stay valid while the curve is in use. Passing no points turns acceleration off.
+ *
+ * @param[in] points curve points
+ * @param[in] count number of points
+ */
+void pointing_device_set_accel_curve(const pointing_device_accel_point_t *points, uint8_t count) {
+    accel_curve       = count ? points : NULL;
+    accel_curve_count = count;
+}
+
+/**
+ * @brief Weak function looking up the gain for a speed
+ *
+ * Interpolates linearly between the points of the acceleration curve, and keeps the gain of the first and last point beyond them.
+ *
+ * @param[in] speed Q8.8 scaled counts per report
+ * @return Q8.8 gain
+ */
+__attribute__((weak)) uint16_t pointing_device_accel_gain(uint16_t speed) {
+    if (!accel_curve) {
+        return POINTING_DEVICE_FIXED_ONE;
+    }
+    if (speed <= accel_curve[0].speed) {
+        return accel_curve[0].gain;
+    }
+    for (uint8_t i = 1; i < accel_curve_count; i++) {
+        const pointing_device_accel_point_t *low  = &accel_curve[i - 1];
+        const pointing_device_accel_point_t *high = &accel_curve[i];
+        if (speed <= high->speed) {
+            int32_t offset = ((int32_t)high->gain - low->gain) * (speed - low->speed);
+            int32_t range  = high->speed - low->speed;
+            // Round to the nearest step, so the gain isn't biased low
+            return low->gain + (offset + (offset < 0 ? -range : range) / 2) / range;
+        }
+    }
+    return accel_curve[accel_curve_count - 1].gain;
+}
+
+static uint16_t isqrt32(uint32_t value) {
+    uint32_t result = 0;
+    uint32_t bit    = 1UL << 30;
+    while (bit > value) {
+        bit >>= 2;
+    }
+    while (bit) {
+        if (value >= result + bit) {
+            value -= result + bit;
+            result = (result >> 1) + bit;
+        } else {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+    return result;
+}
+
+/**
+ * @brief Gets the length of a motion
+ *
+ * @param[in] x Q8.8 motion
+ * @param[in] y Q8.8 motion
+ * @return Q8.8 length, saturating just short of 256 counts
+ */
+uint16_t pointing_device_motion_speed(pointing_device_fixed_t x, pointing_device_fixed_t y) {
+    uint32_t abs_x = x < 0 ? -x : x;
+    uint32_t abs_y = y < 0 ? -y : y;
+    if (abs_x < (1UL << 15) && abs_y < (1UL << 15)) {
+        return isqrt32(abs_x * abs_x + abs_y * abs_y);
+    }
+    // At 128 counts or more the fraction no longer matters
+    abs_x >>= POINTING_DEVICE_FIXED_SHIFT;
+    abs_y >>= POINTING_DEVICE_FIXED_SHIFT;
+    uint32_t length = isqrt32(abs_x * abs_x + abs_y * abs_y);
+    return length > (UINT16_MAX >> POINTING_DEVICE_FIXED_SHIFT) ? UINT16_MAX : length << POINTING_DEVICE_FIXED_SHIFT;
+}
+
+static inline pointing_device_fixed_t pointing_device_fixed_clamp(pointing_device_fixed_t value) {
+    return value < -POINTING_DEVICE_FIXED_MAX ? -POINTING_DEVICE_FIXED_MAX : (value > POINTING_DEVICE_FIXED_MAX ? POINTING_DEVICE_FIXED_MAX : value);
+}
+
+// Multiplies by a Q8.8 factor, rounding to the nearest 1/256th, split up so it stays within 32 bits
+static pointing_device_fixed_t pointing_device_fixed_mul(pointing_device_fixed_t value, uint16_t factor) {
+    uint32_t magnitude = value < 0 ? -value : value;
+    uint32_t product   = (magnitude >> POINTING_DEVICE_FIXED_SHIFT) * factor + (((magnitude & (POINTING_DEVICE_FIXED_ONE - 1)) * factor + POINTING_DEVICE_FIXED_ONE / 2) >> POINTING_DEVICE_FIXED_SHIFT);
+    return pointing_device_fixed_clamp(value < 0 ? -(pointing_device_fixed_t)product : (pointing_device_fixed_t)product);
+}
+
+// Sends the whole counts, as many as fit in a report, and keeps the fraction of a count
+static mouse_xy_report_t pointing_device_fixed_take(pointing_device_fixed_t *total) {
+    pointing_device_fixed_t counts = *total / POINTING_DEVICE_FIXED_ONE;
+    // Whole counts that don't fit are dropped, carrying them over would keep the cursor moving long after a flick
+    *total %= POINTING_DEVICE_FIXED_ONE;
+    if (counts < XY_REPORT_MIN) {
+        counts = XY_REPORT_MIN;
+    } else if (counts > XY_REPORT_MAX) {
+        counts = XY_REPORT_MAX;
+    }
+    return counts;
+}
+
+/**
+ * @brief Drops motion that has not been sent yet
+ *
+ * @param[in] state pointing_device_subpixel_t
+ */
+void pointing_device_subpixel_clear(pointing_device_subpixel_t *state) {
+    state->x = 0;
+    state->y = 0;
+}
+
+/**
+ * @brief Scales and accelerates the motion of a mouse report in fixed point
+ *
+ * The fraction of a count left over is carried over to the next report, motion that does not fit in the report is dropped.
+ *
+ * @param[in] state motion not sent yet, kept per pointing device
+ * @param[in] mouse_report report_mouse_t with sensor counts
+ * @return report_mouse_t with the motion to send
+ */
+report_mouse_t pointing_device_subpixel_apply(pointing_device_subpixel_t *state, report_mouse_t mouse_report) {
+    pointing_device_fixed_t x = pointing_device_fixed_clamp((pointing_device_fixed_t)mouse_report.x * scale);
+    pointing_device_fixed_t y = pointing_device_fixed_clamp((pointing_device_fixed_t)mouse_report.y * scale);
+
+    if (x || y) {
+        uint16_t gain = pointing_device_accel_gain(pointing_device_motion_speed(x, y));
+        state->x      = pointing_device_fixed_clamp(state->x + pointing_device_fixed_mul(x, gain));
+        state->y      = pointing_device_fixed_clamp(state->y + pointing_device_fixed_mul(y, gain));
+    }
+
+    mouse_report.x = pointing_device_fixed_take(&state->x);
+    mouse_report.y = pointing_device_fixed_take(&state->y);
+    return mouse_report;
+}
+
+#endif // POINTING_DEVICE_SUBPIXEL_ENABLE
@@ -0,0 +1,44 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include "report.h"
+
+#ifndef POINTING_DEVICE_SUBPIXEL_ENABLE
+#    error "POINTING_DEVICE_SUBPIXEL_ENABLE not defined! check config settings"
+#endif
+
+/* Q8.8 fixed point, motion is kept in 1/256ths of a count */
+typedef int32_t pointing_device_fixed_t;
+
+#define POINTING_DEVICE_FIXED_SHIFT 8
+#define POINTING_DEVICE_FIXED_ONE (1 << POINTING_DEVICE_FIXED_SHIFT)
+/* converts a constant to an unsigned Q8.8 value, for scales and curve points */
+#define POINTING_DEVICE_FIXED(value) ((uint16_t)((value) * POINTING_DEVICE_FIXED_ONE + 0.5))
+
+#ifndef POINTING_DEVICE_SCALE
+#    define POINTING_DEVICE_SCALE POINTING_DEVICE_FIXED(1)
+#endif
+
+/* a point of the acceleration curve, both values are Q8.8 */
+typedef struct {
+    uint16_t speed; // scaled counts per report
+    uint16_t gain;
+} pointing_device_accel_point_t;
+
+/* motion that has not been sent yet, per pointing device */
+typedef struct {
+    pointing_device_fixed_t x;
+    pointing_device_fixed_t y;
+} pointing_device_subpixel_t;
+
+void     pointing_device_set_scale(uint16_t scale);
+uint16_t pointing_device_get_scale(void);
+void     pointing_device_set_accel_curve(const pointing_device_accel_point_t *points, uint8_t count);
+uint16_t pointing_device_accel_gain(uint16_t speed);
+uint16_t pointing_device_motion_speed(pointing_device_fixed_t x, pointing_device_fixed_t y);
+
+void           pointing_device_subpixel_clear(pointing_device_subpixel_t *state);
+report_mouse_t pointing_device_subpixel_apply(pointing_device_subpixel_t *state, report_mouse_t mouse_report);
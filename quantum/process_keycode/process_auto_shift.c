@@ -364,15 +364,15 @@ void set_autoshift_timeout(uint16_t timeout) {
 }
 
 bool process_auto_shift(uint16_t keycode, keyrecord_t *record) {
-    // Note that record->event.time isn't reliable, see:
-    // https://github.com/qmk/qmk_firmware/pull/9826#issuecomment-733559550
+    // Key events carry the time the matrix was scanned, so hold durations
+    // don't depend on how long processing was delayed. Anything else, such
+    // as events generated by the firmware itself, is timed on arrival.
     // clang-format off
     const uint16_t now =
-#if !defined(RETRO_SHIFT) || defined(NO_ACTION_TAPPING)
-        timer_read()
-#else
-        (record->event.pressed) ? retroshift_time : timer_read()
+#if defined(RETRO_SHIFT) && !defined(NO_ACTION_TAPPING)
+        (record->event.pressed) ? retroshift_time :
 #endif
+        IS_KEYEVENT(record->event) ? record->event.time : timer_read()
     ;
     // clang-format on
 
@@ -459,7 +459,9 @@ bool process_auto_shift(uint16_t keycode, keyrecord_t *record) {
                 && get_hold_on_other_key_press(keycode, record)
 #    endif
             ) {
-                autoshift_end(KC_NO, now, false, &autoshift_lastrecord);
+                // The interrupting key is still held, so it has been held until now
+                // rather than until this release, which may have been buffered
+                autoshift_end(KC_NO, timer_read(), false, &autoshift_lastrecord);
             }
 #endif
             // clang-format on
@@ -491,7 +493,7 @@ bool process_auto_shift(uint16_t keycode, keyrecord_t *record) {
 // Called to record time before possible delays by action_tapping_process.
 void retroshift_poll_time(keyevent_t *event) {
     last_retroshift_time = retroshift_time;
-    retroshift_time      = timer_read();
+    retroshift_time      = IS_KEYEVENT(*event) ? event->time : timer_read();
 }
 // Used to swap the times of Retro Shifted key and Auto Shift key that interrupted it.
 void retroshift_swap_times(void) {
@@ -26,6 +26,7 @@
 #include "action_tapping.h"
 #include "action_util.h"
 #include "keymap_introspection.h"
+#include "debug.h"
 
 __attribute__((weak)) void process_combo_event(uint16_t combo_index, bool pressed) {}
 
@@ -94,6 +95,100 @@ static queued_combo_t combo_buffer[COMBO_BUFFER_LENGTH];
 
 #define INCREMENT_MOD(i) i = (i + 1) % COMBO_BUFFER_LENGTH
 
+#ifdef COMBO_INDEX_SIZE
+/* Inverse index from keycode to the combos containing it, so that a key event
+ * only visits its candidate combos instead of every combo in the keymap.
+ * Entries are sorted by keycode, and by combo index within the same keycode
+ * so candidates are processed in the same order as the linear scan. */
+typedef struct {
+    uint16_t keycode;
+    uint16_t combo_index;
+} combo_index_entry_t;
+
+typedef enum {
+    COMBO_INDEX_INVALID,
+    COMBO_INDEX_READY,
+    COMBO_INDEX_UNAVAILABLE, // combos didn't fit, fall back to the linear scan
+} combo_index_state_t;
+
+static combo_index_entry_t combo_index[COMBO_INDEX_SIZE];
+static uint16_t            combo_index_size  = 0;
+static combo_index_state_t combo_index_state = COMBO_INDEX_INVALID;
+
+/* Combos whose state may need resetting by clear_combos(). */
+#    ifndef COMBO_INDEX_TOUCHED_LENGTH
+#        define COMBO_INDEX_TOUCHED_LENGTH 32
+#    endif
+static uint16_t touched_combos[COMBO_INDEX_TOUCHED_LENGTH];
+static uint8_t  touched_combos_count    = 0;
+static bool     touched_combos_overflow = true;
+
+void combo_index_invalidate(void) {
+    combo_index_state = COMBO_INDEX_INVALID;
+    // Touched combo indices may not refer to the same combos anymore
+    touched_combos_overflow = true;
+}
+
+static void combo_index_build(void) {
+    combo_index_size  = 0;
+    combo_index_state = COMBO_INDEX_READY;
+
+    for (uint16_t idx = 0; idx < combo_count(); ++idx) {
+        const uint16_t *keys = combo_get(idx)->keys;
+        uint16_t        key;
+
+        for (uint8_t key_i = 0; (key = pgm_read_word(&keys[key_i])) != COMBO_END; ++key_i) {
+            bool duplicate = false;
+            for (uint8_t prev_i = 0; prev_i < key_i; ++prev_i) {
+                duplicate |= pgm_read_word(&keys[prev_i]) == key;
+            }
+            if (duplicate) {
+                continue;
+            }
+
+            if (combo_index_size == COMBO_INDEX_SIZE) {
+                dprintf("combo: COMBO_INDEX_SIZE too small for %u combos, using linear scan\n", combo_count());
+                combo_index_state = COMBO_INDEX_UNAVAILABLE;
+                return;
+            }
+
+            // Combos are added in index order, so a stable insertion by keycode keeps both orderings
+            uint16_t pos = combo_index_size++;
+            while (pos > 0 && combo_index[pos - 1].keycode > key) {
+                combo_index[pos] = combo_index[pos - 1];
+                pos--;
+            }
+            combo_index[pos] = (combo_index_entry_t){
+                .keycode     = key,
+                .combo_index = idx,
+            };
+        }
+    }
+}
+
+/* Returns the position of the first entry for keycode, or of the entry that would follow it. */
+static uint16_t combo_index_find(uint16_t keycode) {
+    uint16_t low = 0, high = combo_index_size;
+    while (low < high) {
+        uint16_t mid = low + (high - low) / 2;
+        if (combo_index[mid].keycode < keycode) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+static inline void touch_combo(uint16_t combo_index) {
+    if (touched_combos_count < COMBO_INDEX_TOUCHED_LENGTH) {
+        touched_combos[touched_combos_count++] = combo_index;
+    } else {
+        touched_combos_overflow = true;
+    }
+}
+#endif
+
 #ifndef EXTRA_SHORT_COMBOS
 /* flags are their own elements in combo_t struct. */
 #    define COMBO_ACTIVE(combo) (combo->active)
@@ -141,10 +236,10 @@ static queued_combo_t combo_buffer[COMBO_BUFFER_LENGTH];
         } while (0)
 #endif
 
-static inline void release_combo(uint16_t combo_index, combo_t *combo) {
+static inline void release_combo(uint16_t combo_index, combo_t *combo, uint16_t time) {
     if (combo->keycode) {
         keyrecord_t record = {
-            .event   = MAKE_COMBOEVENT(false),
+            .event   = MAKE_TIMED_EVENT(0, 0, false, COMBO_EVENT, time),
             .keycode = combo->keycode,
         };
 #ifndef NO_ACTION_TAPPING
@@ -194,11 +289,34 @@ static inline uint16_t _get_combo_term(uint16_t combo_index, combo_t *combo) {
 void clear_combos(void) {
     uint16_t index = 0;
     longest_term   = 0;
+#ifdef COMBO_INDEX_SIZE
+    if (!touched_combos_overflow) {
+        // Active combos are kept around, they still need resetting once released
+        uint8_t kept = 0;
+        for (uint8_t i = 0; i < touched_combos_count; ++i) {
+            combo_t *combo = combo_get(touched_combos[i]);
+            if (!COMBO_ACTIVE(combo)) {
+                RESET_COMBO_STATE(combo);
+            } else {
+                touched_combos[kept++] = touched_combos[i];
+            }
+        }
+        touched_combos_count = kept;
+        return;
+    }
+    touched_combos_count    = 0;
+    touched_combos_overflow = false;
+#endif
     for (index = 0; index < combo_count(); ++index) {
         combo_t *combo = combo_get(index);
         if (!COMBO_ACTIVE(combo)) {
             RESET_COMBO_STATE(combo);
         }
+#ifdef COMBO_INDEX_SIZE
+        else {
+            touch_combo(index);
+        }
+#endif
     }
 }
 
@@ -436,6 +554,11 @@ static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *
     if (record->event.pressed && key_is_part_of_combo) {
         uint16_t time = _get_combo_term(combo_index, combo);
         if (!COMBO_ACTIVE(combo)) {
+#ifdef COMBO_INDEX_SIZE
+            if (NO_COMBO_KEYS_ARE_DOWN && !COMBO_DISABLED(combo)) {
+                touch_combo(combo_index);
+            }
+#endif
             KEY_STATE_DOWN(combo->state, key_index);
             if (longest_term < time) {
                 longest_term = time;
@@ -446,8 +569,8 @@ static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *
             /* Buffer the combo so we can fire it after COMBO_TERM */
 
 #ifndef COMBO_NO_TIMER
-            /* Don't buffer this combo if its combo term has passed. */
-            if (timer && timer_elapsed(timer) > time) {
+            /* Don't buffer this combo if its combo term had passed when the key was pressed. */
+            if (timer && TIMER_DIFF_16(record->event.time, timer) > time) {
                 DISABLE_COMBO(combo);
                 return true;
             } else
@@ -501,14 +624,14 @@ static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *
                 apply_combos(); // also apply other prepared combos and dump key buffer
 #    ifdef COMBO_PROCESS_KEY_RELEASE
                 if (process_combo_key_release(combo_index, combo, key_index, keycode)) {
-                    release_combo(combo_index, combo);
+                    release_combo(combo_index, combo, record->event.time);
                 }
 #    endif
             }
 #endif
         } else if (COMBO_ACTIVE(combo) && ONLY_ONE_KEY_IS_DOWN(COMBO_STATE(combo)) && KEY_NOT_YET_RELEASED(COMBO_STATE(combo), key_index)) {
             /* last key released */
-            release_combo(combo_index, combo);
+            release_combo(combo_index, combo, record->event.time);
             key_is_part_of_combo = true;
 
 #ifdef COMBO_PROCESS_KEY_RELEASE
@@ -520,7 +643,7 @@ static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *
 
 #ifdef COMBO_PROCESS_KEY_RELEASE
             if (process_combo_key_release(combo_index, combo, key_index, keycode)) {
-                release_combo(combo_index, combo);
+                release_combo(combo_index, combo, record->event.time);
             }
 #endif
         } else {
@@ -535,8 +658,7 @@ static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *
 }
 
 bool process_combo(uint16_t keycode, keyrecord_t *record) {
-    bool is_combo_key          = false;
-    bool no_combo_keys_pressed = true;
+    bool is_combo_key = false;
 
     if (keycode == QK_COMBO_ON && record->event.pressed) {
         combo_enable();
@@ -564,10 +686,22 @@ bool process_combo(uint16_t keycode, keyrecord_t *record) {
     }
 #endif
 
-    for (uint16_t idx = 0; idx < combo_count(); ++idx) {
-        combo_t *combo = combo_get(idx);
-        is_combo_key |= process_single_combo(combo, keycode, record, idx);
-        no_combo_keys_pressed = no_combo_keys_pressed && (NO_COMBO_KEYS_ARE_DOWN || COMBO_ACTIVE(combo) || COMBO_DISABLED(combo));
+#ifdef COMBO_INDEX_SIZE
+    if (combo_index_state == COMBO_INDEX_INVALID) {
+        combo_index_build();
+    }
+    if (combo_index_state == COMBO_INDEX_READY) {
+        for (uint16_t i = combo_index_find(keycode); i < combo_index_size && combo_index[i].keycode == keycode; ++i) {
+            uint16_t idx = combo_index[i].combo_index;
+            is_combo_key |= process_single_combo(combo_get(idx), keycode, record, idx);
+        }
+    } else
+#endif
+    {
+        for (uint16_t idx = 0; idx < combo_count(); ++idx) {
+            combo_t *combo = combo_get(idx);
+            is_combo_key |= process_single_combo(combo, keycode, record, idx);
+        }
     }
 
     if (record->event.pressed && is_combo_key) {
@@ -575,10 +709,10 @@ bool process_combo(uint16_t keycode, keyrecord_t *record) {
 #    ifdef COMBO_STRICT_TIMER
         if (!timer) {
             // timer is set only on the first key
-            timer = timer_read();
+            timer = record->event.time;
         }
 #    else
-        timer = timer_read();
+        timer = record->event.time;
 #    endif
 #endif
 
@@ -73,6 +73,10 @@ typedef struct combo_t {
 /* check if keycode is only modifiers */
 #define KEYCODE_IS_MOD(code) (IS_MODIFIER_KEYCODE(code) || (IS_QK_MODS(code) && !QK_MODS_GET_BASIC_KEYCODE(code)))
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 bool process_combo(uint16_t keycode, keyrecord_t *record);
 void combo_task(void);
 void process_combo_event(uint16_t combo_index, bool pressed);
@@ -81,3 +85,14 @@ void combo_enable(void);
 void combo_disable(void);
 void combo_toggle(void);
 bool is_combo_enabled(void);
+
+#ifdef COMBO_INDEX_SIZE
+// Rebuild the keycode to combo index, needed when combo_count()/combo_get() start returning different combos
+void combo_index_invalidate(void);
+#else
+#    define combo_index_invalidate()
+#endif
+
+#ifdef __cplusplus
+}
+#endif
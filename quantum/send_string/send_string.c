@@ -151,6 +151,10 @@ void send_string(const char *string) {
 }
 
 void send_string_with_delay(const char *string, uint8_t interval) {
+#ifdef SEND_STRING_ASYNC_ENABLE
+    // Keep the order with the strings still queued
+    send_string_async_flush();
+#endif
     while (1) {
         char ascii_code = *string;
         if (!ascii_code) break;
@@ -193,6 +197,10 @@ void send_string_with_delay(const char *string, uint8_t interval) {
 }
 
 void send_char(char ascii_code) {
+#ifdef SEND_STRING_ASYNC_ENABLE
+    // Keep the order with the strings still queued
+    send_string_async_flush();
+#endif
     send_char_with_delay(ascii_code, TAP_CODE_DELAY);
 }
 
@@ -298,6 +306,10 @@ void send_string_P(const char *string) {
 }
 
 void send_string_with_delay_P(const char *string, uint8_t interval) {
+#ifdef SEND_STRING_ASYNC_ENABLE
+    // Keep the order with the strings still queued
+    send_string_async_flush();
+#endif
     while (1) {
         char ascii_code = pgm_read_byte(string);
         if (!ascii_code) break;
@@ -24,6 +24,7 @@
  */
 
 #include <stdint.h>
+#include <stdbool.h>
 
 #include "progmem.h"
 #include "send_string_keycodes.h"
@@ -161,4 +162,73 @@ void send_string_with_delay_P(const char *string, uint8_t interval);
  */
 #define SEND_STRING_DELAY(string, interval) send_string_with_delay_P(PSTR(string), interval)
 
+#if defined(SEND_STRING_ASYNC_ENABLE) || defined(__DOXYGEN__)
+/**
+ * \brief Reads the character at a position of a string, e.g. from PROGMEM or EEPROM.
+ */
+typedef char (*send_string_reader_t)(const char *position);
+
+/**
+ * \brief Type out a string of ASCII characters without blocking.
+ *
+ * The keystrokes are queued and sent by `send_string_async_task()`, paced by their delays and by the host
+ * taking the previous report, so the keyboard keeps scanning while they go out. The string is copied, and
+ * strings queued one after the other are typed in order. If the queue is full, this waits for room.
+ *
+ * \param string The string to type out.
+ */
+void send_string_async(const char *string);
+
+/**
+ * \brief Type out a string of ASCII characters without blocking, with a delay between each character.
+ *
+ * \param string The string to type out.
+ * \param interval The amount of time, in milliseconds, to wait before typing the next character.
+ */
+void send_string_with_delay_async(const char *string, uint8_t interval);
+
+/**
+ * \brief Type out a string without blocking, reading it as it is typed.
+ *
+ * The string is not copied, so it has to stay unchanged until it has been typed, e.g. a string in PROGMEM or EEPROM.
+ *
+ * \param string The string to type out.
+ * \param interval The amount of time, in milliseconds, to wait before typing the next character.
+ * \param read The function reading the string's characters.
+ */
+void send_string_with_reader_async(const char *string, uint8_t interval, send_string_reader_t read);
+
+/**
+ * \brief Whether any queued keystrokes are still to be sent.
+ */
+bool send_string_async_busy(void);
+
+/**
+ * \brief Block until all queued keystrokes have been sent.
+ */
+void send_string_async_flush(void);
+
+/**
+ * \brief Send the queued keystrokes that are due, called from the keyboard task.
+ */
+void send_string_async_task(void);
+
+#    if defined(__AVR__) || defined(__DOXYGEN__)
+/**
+ * \brief Type out a PROGMEM string of ASCII characters without blocking, with a delay between each character.
+ *
+ * \param string The string to type out.
+ * \param interval The amount of time, in milliseconds, to wait before typing the next character.
+ */
+void send_string_with_delay_async_P(const char *string, uint8_t interval);
+#    else
+#        define send_string_with_delay_async_P(string, interval) send_string_with_delay_async(string, interval)
+#    endif
+
+/**
+ * \brief Shortcut macro for send_string_with_delay_async_P(PSTR(string), 0).
+ */
+#    define SEND_STRING_ASYNC(string) send_string_with_delay_async_P(PSTR(string), 0)
+#endif
+
 /** \} */
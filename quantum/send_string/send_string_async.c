@@ -0,0 +1,320 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "send_string.h"
+
+#include <ctype.h>
+#include <string.h>
+
+#include "quantum_keycodes.h"
+#include "keycode.h"
+#include "action.h"
+#include "host.h"
+#include "timer.h"
+#include "wait.h"
+
+// Keystrokes queued ahead of the one being sent
+#ifndef SEND_STRING_ASYNC_QUEUE_SIZE
+#    define SEND_STRING_ASYNC_QUEUE_SIZE 16
+#endif
+
+// Strings waiting to be typed
+#ifndef SEND_STRING_ASYNC_SOURCE_COUNT
+#    define SEND_STRING_ASYNC_SOURCE_COUNT 4
+#endif
+
+// Space for the copies of the strings waiting to be typed
+#ifndef SEND_STRING_ASYNC_BUFFER_SIZE
+#    define SEND_STRING_ASYNC_BUFFER_SIZE 128
+#endif
+
+// How long to wait for the host to take a report before sending the next one anyway
+#ifndef SEND_STRING_ASYNC_READY_TIMEOUT
+#    define SEND_STRING_ASYNC_READY_TIMEOUT 50
+#endif
+
+// The most keystrokes a single character turns into
+#define MAX_OPS_PER_CHAR 8
+
+#define PGM_LOADBIT(mem, pos) ((pgm_read_byte(&((mem)[(pos) / 8])) >> ((pos) % 8)) & 0x01)
+
+enum {
+    OP_REGISTER,
+    OP_UNREGISTER,
+    OP_WAIT,
+    OP_CHAR,
+};
+
+typedef struct {
+    uint8_t  type;
+    uint8_t  code;
+    uint16_t delay; // ms to wait after the op
+} async_op_t;
+
+typedef struct {
+    const char          *position;
+    send_string_reader_t read;
+    uint8_t              interval;
+} async_source_t;
+
+static async_op_t ops[SEND_STRING_ASYNC_QUEUE_SIZE];
+static uint8_t    op_head  = 0;
+static uint8_t    op_count = 0;
+
+static async_source_t sources[SEND_STRING_ASYNC_SOURCE_COUNT];
+static uint8_t        source_head  = 0;
+static uint8_t        source_count = 0;
+
+static char     buffer[SEND_STRING_ASYNC_BUFFER_SIZE];
+static uint16_t buffer_used = 0;
+
+static uint32_t op_time          = 0;
+static uint16_t op_delay         = 0;
+static bool     delaying         = false;
+static uint32_t ready_since      = 0;
+static bool     waiting_for_host = false;
+
+static char read_ram(const char *position) {
+    return *position;
+}
+
+#if defined(__AVR__)
+static char read_progmem(const char *position) {
+    return pgm_read_byte(position);
+}
+#endif
+
+static void queue_op(uint8_t type, uint8_t code, uint16_t delay) {
+    async_op_t *op = &ops[(op_head + op_count) % SEND_STRING_ASYNC_QUEUE_SIZE];
+    op->type       = type;
+    op->code       = code;
+    op->delay      = delay;
+    op_count++;
+}
+
+// Adds a delay after the last queued op, delays longer than a minute are cut short
+static void queue_wait(uint32_t ms) {
+    if (!ms) {
+        return;
+    }
+    if (op_count) {
+        async_op_t *last = &ops[(op_head + op_count - 1) % SEND_STRING_ASYNC_QUEUE_SIZE];
+        if (last->delay + ms <= UINT16_MAX) {
+            last->delay += ms;
+            return;
+        }
+    }
+    queue_op(OP_WAIT, 0, ms < UINT16_MAX ? ms : UINT16_MAX);
+}
+
+static void queue_char(char ascii_code, uint8_t interval) {
+#if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
+    if (ascii_code == '\a') { // BEL
+        queue_op(OP_CHAR, ascii_code, 0);
+        return;
+    }
+#endif
+
+    uint8_t keycode    = pgm_read_byte(&ascii_to_keycode_lut[(uint8_t)ascii_code]);
+    bool    is_shifted = PGM_LOADBIT(ascii_to_shift_lut, (uint8_t)ascii_code);
+    bool    is_altgred = PGM_LOADBIT(ascii_to_altgr_lut, (uint8_t)ascii_code);
+    bool    is_dead    = PGM_LOADBIT(ascii_to_dead_lut, (uint8_t)ascii_code);
+
+    // Same keystrokes and delays as send_char_with_delay()
+    if (is_shifted) {
+        queue_op(OP_REGISTER, KC_LEFT_SHIFT, interval);
+    }
+    if (is_altgred) {
+        queue_op(OP_REGISTER, KC_RIGHT_ALT, interval);
+    }
+    queue_op(OP_REGISTER, keycode, interval);
+    queue_op(OP_UNREGISTER, keycode, interval);
+    if (is_altgred) {
+        queue_op(OP_UNREGISTER, KC_RIGHT_ALT, interval);
+    }
+    if (is_shifted) {
+        queue_op(OP_UNREGISTER, KC_LEFT_SHIFT, interval);
+    }
+    if (is_dead) {
+        queue_op(OP_REGISTER, KC_SPACE, TAP_CODE_DELAY);
+        queue_op(OP_UNREGISTER, KC_SPACE, interval);
+    }
+}
+
+// Queues the keystrokes of the next character of a string, returns false at its end
+static bool queue_next(async_source_t *source) {
+    char ascii_code = source->read(source->position++);
+    if (!ascii_code) {
+        return false;
+    }
+    if (ascii_code != SS_QMK_PREFIX) {
+        queue_char(ascii_code, source->interval);
+        return true;
+    }
+
+    // A sequence cut short ends the string
+    ascii_code      = source->read(source->position++);
+    uint8_t keycode = 0;
+    if (ascii_code == SS_TAP_CODE || ascii_code == SS_DOWN_CODE || ascii_code == SS_UP_CODE) {
+        keycode = source->read(source->position++);
+        if (!keycode) {
+            return false;
+        }
+    }
+
+    if (ascii_code == SS_TAP_CODE) {
+        queue_op(OP_REGISTER, keycode, keycode == KC_CAPS_LOCK ? TAP_HOLD_CAPS_DELAY : TAP_CODE_DELAY);
+        queue_op(OP_UNREGISTER, keycode, 0);
+    } else if (ascii_code == SS_DOWN_CODE) {
+        queue_op(OP_REGISTER, keycode, 0);
+    } else if (ascii_code == SS_UP_CODE) {
+        queue_op(OP_UNREGISTER, keycode, 0);
+    } else if (ascii_code == SS_DELAY_CODE) {
+        uint32_t ms = 0;
+        while (isdigit((uint8_t)(ascii_code = source->read(source->position)))) {
+            ms = ms * 10 + ascii_code - '0';
+            source->position++;
+        }
+        if (!ascii_code) {
+            return false;
+        }
+        // Skip the '|'
+        source->position++;
+        queue_wait(ms);
+    } else {
+        return false;
+    }
+
+    queue_wait(source->interval);
+    return true;
+}
+
+// Turns the queued strings into keystrokes, as far as they fit in the queue
+static void fill_queue(void) {
+    while (source_count && SEND_STRING_ASYNC_QUEUE_SIZE - op_count >= MAX_OPS_PER_CHAR) {
+        if (!queue_next(&sources[source_head])) {
+            source_head = (source_head + 1) % SEND_STRING_ASYNC_SOURCE_COUNT;
+            source_count--;
+            if (!source_count) {
+                buffer_used = 0;
+            }
+        }
+    }
+}
+
+// Sends the next keystroke if it is due, returns false if there was nothing to send yet
+static bool send_next(void) {
+    if (delaying) {
+        if (timer_elapsed32(op_time) < op_delay) {
+            return false;
+        }
+        delaying = false;
+    }
+
+    fill_queue();
+    if (!op_count) {
+        return false;
+    }
+
+    async_op_t op = ops[op_head];
+    if (op.type == OP_REGISTER || op.type == OP_UNREGISTER) {
+        // Hold the keystroke until the host has taken the previous report
+        if (!host_keyboard_ready()) {
+            if (!waiting_for_host) {
+                waiting_for_host = true;
+                ready_since      = timer_read32();
+            }
+            if (timer_elapsed32(ready_since) < SEND_STRING_ASYNC_READY_TIMEOUT) {
+                return false;
+            }
+        }
+        waiting_for_host = false;
+    }
+
+    op_head = (op_head + 1) % SEND_STRING_ASYNC_QUEUE_SIZE;
+    op_count--;
+
+    switch (op.type) {
+        case OP_REGISTER:
+            register_code(op.code);
+            break;
+        case OP_UNREGISTER:
+            unregister_code(op.code);
+            break;
+        case OP_CHAR:
+            send_char_with_delay(op.code, 0);
+            break;
+    }
+
+    if (op.delay) {
+        op_time  = timer_read32();
+        op_delay = op.delay;
+        delaying = true;
+    }
+    return true;
+}
+
+static void wait_for_next(void) {
+    if (!send_next()) {
+        wait_ms(1);
+    }
+}
+
+static void queue_source(const char *string, uint8_t interval, send_string_reader_t read) {
+    while (source_count == SEND_STRING_ASYNC_SOURCE_COUNT) {
+        wait_for_next();
+    }
+
+    async_source_t *source = &sources[(source_head + source_count) % SEND_STRING_ASYNC_SOURCE_COUNT];
+    source->position       = string;
+    source->read           = read;
+    source->interval       = interval;
+    source_count++;
+}
+
+void send_string_async(const char *string) {
+    send_string_with_delay_async(string, TAP_CODE_DELAY);
+}
+
+void send_string_with_delay_async(const char *string, uint8_t interval) {
+    size_t length = strlen(string) + 1;
+    if (length > SEND_STRING_ASYNC_BUFFER_SIZE) {
+        // Too long to copy, type it out straight away after what is queued
+        send_string_with_delay(string, interval);
+        return;
+    }
+
+    // The buffer is reused once all the strings in it are typed
+    while (buffer_used + length > SEND_STRING_ASYNC_BUFFER_SIZE) {
+        wait_for_next();
+    }
+
+    char *copy = &buffer[buffer_used];
+    memcpy(copy, string, length);
+    buffer_used += length;
+    queue_source(copy, interval, read_ram);
+}
+
+void send_string_with_reader_async(const char *string, uint8_t interval, send_string_reader_t read) {
+    queue_source(string, interval, read);
+}
+
+#if defined(__AVR__)
+void send_string_with_delay_async_P(const char *string, uint8_t interval) {
+    queue_source(string, interval, read_progmem);
+}
+#endif
+
+bool send_string_async_busy(void) {
+    return source_count || op_count || delaying;
+}
+
+void send_string_async_flush(void) {
+    while (send_string_async_busy()) {
+        wait_for_next();
+    }
+}
+
+void send_string_async_task(void) {
+    send_next();
+}
@@ -0,0 +1,124 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+
+#include "split_delta.h"
+#include "crc.h"
+
+#define DELTA_FULL_FRAME 0
+
+static inline uint8_t chunk_count(uint8_t size, uint8_t chunk_size) {
+    return (size + chunk_size - 1) / chunk_size;
+}
+
+static inline uint8_t chunk_length(uint8_t size, uint8_t chunk_size, uint8_t chunk) {
+    uint8_t offset = chunk * chunk_size;
+    return size - offset < chunk_size ? size - offset : chunk_size;
+}
+
+uint8_t split_delta_encode(split_delta_encoder_t *encoder, const void *state, uint8_t *payload) {
+    const uint8_t *current     = state;
+    uint8_t       *shadow      = encoder->shadow;
+    uint8_t        chunks      = chunk_count(encoder->size, encoder->chunk_size);
+    uint8_t        bitmap_size = (chunks + 7) / 8;
+    uint8_t        base        = encoder->full ? DELTA_FULL_FRAME : encoder->generation;
+    uint8_t        length      = SPLIT_DELTA_HEADER_SIZE;
+
+    if (base != DELTA_FULL_FRAME) {
+        uint8_t *bitmap = &payload[length];
+        memset(bitmap, 0, bitmap_size);
+        length += bitmap_size;
+
+        for (uint8_t chunk = 0; chunk < chunks; chunk++) {
+            uint8_t offset = chunk * encoder->chunk_size;
+            uint8_t len    = chunk_length(encoder->size, encoder->chunk_size, chunk);
+            if (memcmp(&current[offset], &shadow[offset], len) == 0) {
+                continue;
+            }
+            if (length + len > SPLIT_DELTA_PAYLOAD_SIZE(encoder->size)) {
+                // Larger than the full state
+                base = DELTA_FULL_FRAME;
+                break;
+            }
+            bitmap[chunk / 8] |= 1 << (chunk % 8);
+            memcpy(&payload[length], &current[offset], len);
+            length += len;
+        }
+    }
+
+    if (base == DELTA_FULL_FRAME) {
+        memcpy(&payload[SPLIT_DELTA_HEADER_SIZE], current, encoder->size);
+        length = SPLIT_DELTA_HEADER_SIZE + encoder->size;
+    }
+
+    // Generation 0 marks full frames, so it is skipped
+    encoder->generation = encoder->generation == UINT8_MAX ? 1 : encoder->generation + 1;
+    encoder->full       = false;
+    memcpy(shadow, current, encoder->size);
+
+    payload[0] = encoder->generation;
+    payload[1] = base;
+    payload[2] = crc8(current, encoder->size);
+    return length;
+}
+
+bool split_delta_decode(split_delta_decoder_t *decoder, void *state, const uint8_t *payload, uint8_t length) {
+    if (length < SPLIT_DELTA_HEADER_SIZE) {
+        return false;
+    }
+
+    uint8_t        generation = payload[0];
+    uint8_t        base       = payload[1];
+    uint8_t        checksum   = payload[2];
+    uint8_t       *target     = state;
+    const uint8_t *data       = &payload[SPLIT_DELTA_HEADER_SIZE];
+    uint8_t        remaining  = length - SPLIT_DELTA_HEADER_SIZE;
+
+    if (decoder->generation != DELTA_FULL_FRAME && generation == decoder->generation) {
+        return true;
+    }
+
+    if (base == DELTA_FULL_FRAME) {
+        if (remaining != decoder->size) {
+            return false;
+        }
+        memcpy(target, data, decoder->size);
+    } else {
+        uint8_t chunks      = chunk_count(decoder->size, decoder->chunk_size);
+        uint8_t bitmap_size = (chunks + 7) / 8;
+        if (base != decoder->generation || remaining < bitmap_size) {
+            return false;
+        }
+
+        const uint8_t *bitmap = data;
+        data += bitmap_size;
+        remaining -= bitmap_size;
+
+        // Validate the length before touching the state
+        uint16_t expected = 0;
+        for (uint8_t chunk = 0; chunk < chunks; chunk++) {
+            if (bitmap[chunk / 8] & (1 << (chunk % 8))) {
+                expected += chunk_length(decoder->size, decoder->chunk_size, chunk);
+            }
+        }
+        if (expected != remaining) {
+            return false;
+        }
+
+        for (uint8_t chunk = 0; chunk < chunks; chunk++) {
+            if (bitmap[chunk / 8] & (1 << (chunk % 8))) {
+                uint8_t len = chunk_length(decoder->size, decoder->chunk_size, chunk);
+                memcpy(&target[chunk * decoder->chunk_size], data, len);
+                data += len;
+            }
+        }
+    }
+
+    if (crc8(target, decoder->size) != checksum) {
+        decoder->generation = DELTA_FULL_FRAME;
+        return false;
+    }
+    decoder->generation = generation;
+    return true;
+}
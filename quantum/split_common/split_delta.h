@@ -0,0 +1,67 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * \file
+ *
+ * Delta encoding of state that is synced between the split halves.
+ *
+ * The state is divided into fixed size chunks, and a frame only carries the
+ * chunks that changed since the previous frame, together with the generation
+ * of the state it applies on top of. A receiver that isn't at that generation
+ * rejects the frame, so that the sender can fall back to a full frame.
+ *
+ * Payload layout: [generation][base generation][crc8 of the resulting state]
+ * followed by a bitmap of the chunks that are included and the chunks
+ * themselves. Full frames have a base generation of 0 and carry the whole
+ * state without a bitmap.
+ */
+
+#define SPLIT_DELTA_HEADER_SIZE 3
+
+// Largest payload for a state of the given size, a full frame is sent whenever a delta wouldn't be smaller
+#define SPLIT_DELTA_PAYLOAD_SIZE(state_size) (SPLIT_DELTA_HEADER_SIZE + (state_size))
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    void   *shadow;     // the state as of the last encoded frame
+    uint8_t size;       // size of the state
+    uint8_t chunk_size; // granularity of the changes that are sent
+    uint8_t generation; // generation of the last encoded frame
+    bool    full;       // encode a full frame next
+} split_delta_encoder_t;
+
+typedef struct {
+    uint8_t size;
+    uint8_t chunk_size;
+    uint8_t generation; // generation of the state, 0 if it isn't known to be in sync
+} split_delta_decoder_t;
+
+/**
+ * \brief Encode the changes to the state since the previous frame.
+ *
+ * \param payload Receives the frame payload, has to hold at least `SPLIT_DELTA_PAYLOAD_SIZE(encoder->size)` bytes.
+ * \return The length of the payload.
+ */
+uint8_t split_delta_encode(split_delta_encoder_t *encoder, const void *state, uint8_t *payload);
+
+/**
+ * \brief Apply a frame payload to the state.
+ *
+ * Frames that were already applied are ignored. If the frame doesn't apply to
+ * the current generation, or the result doesn't match the checksum, false is
+ * returned and a full frame is needed to get back in sync.
+ */
+bool split_delta_decode(split_delta_decoder_t *decoder, void *state, const uint8_t *payload, uint8_t length);
+
+#ifdef __cplusplus
+}
+#endif
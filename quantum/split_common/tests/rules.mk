@@ -0,0 +1,36 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+split_transport_common_DEFS := \
+	-DSPLIT_KEYBOARD \
+	-DSPLIT_TRANSPORT_MIRROR \
+	-DDISABLE_SYNC_TIMER \
+	-DMATRIX_ROWS=8 \
+	-DMATRIX_COLS=16
+split_transport_common_SRC := \
+	$(QUANTUM_PATH)/split_common/tests/split_transport_tests.cpp \
+	$(QUANTUM_PATH)/split_common/transactions.c \
+	$(QUANTUM_PATH)/split_common/transport.c \
+	$(QUANTUM_PATH)/split_common/split_delta.c \
+	$(QUANTUM_PATH)/crc.c \
+	$(PLATFORM_PATH)/synchronization_util.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/drivers/serial_loopback.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
+split_transport_common_INC := \
+	$(QUANTUM_PATH)/split_common
+
+split_transport_DEFS := $(split_transport_common_DEFS)
+split_transport_SRC := $(split_transport_common_SRC)
+split_transport_INC := $(split_transport_common_INC)
+
+split_transport_delta_DEFS := $(split_transport_common_DEFS) -DSPLIT_TRANSPORT_DELTA
+split_transport_delta_SRC := $(split_transport_common_SRC)
+split_transport_delta_INC := $(split_transport_common_INC)
+
+split_transport_batching_DEFS := $(split_transport_common_DEFS) -DSPLIT_TRANSACTION_BATCHING
+split_transport_batching_SRC := $(split_transport_common_SRC)
+split_transport_batching_INC := $(split_transport_common_INC)
+
+split_transport_push_DEFS := $(split_transport_common_DEFS) -DSPLIT_MATRIX_PUSH
+split_transport_push_SRC := $(split_transport_common_SRC)
+split_transport_push_INC := $(split_transport_common_INC)
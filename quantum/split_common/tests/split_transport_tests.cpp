@@ -0,0 +1,233 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstdio>
+#include <cstring>
+
+#include "gtest/gtest.h"
+
+// transport.h and transaction_id_define.h use C11 static assertions
+#define _Static_assert static_assert
+
+extern "C" {
+#include "matrix.h"
+#include "timer.h"
+#include "transactions.h"
+#include "serial_loopback.h"
+
+void set_time(uint32_t t);
+}
+
+#if defined(SPLIT_TRANSPORT_DELTA)
+#    define SPLIT_FEATURE "delta"
+#elif defined(SPLIT_TRANSACTION_BATCHING)
+#    define SPLIT_FEATURE "batching"
+#elif defined(SPLIT_MATRIX_PUSH)
+#    define SPLIT_FEATURE "push"
+#else
+#    define SPLIT_FEATURE "default"
+#endif
+
+#define ROWS_PER_HAND (MATRIX_ROWS / 2)
+
+// Time each half spends scanning its matrix
+#define SCAN_TIME_US 250
+
+extern "C" {
+bool is_transport_connected(void) {
+    return true;
+}
+}
+
+static const serial_loopback_link_t fast_link   = {1000000, 0, 0};
+static const serial_loopback_link_t noisy_link  = {1000000, 0, 1e-3};
+static const serial_loopback_link_t simple_link = {0, 0, 0};
+
+class SplitTransport : public ::testing::Test {
+   protected:
+    matrix_row_t master_matrix[ROWS_PER_HAND];
+    matrix_row_t slave_matrix[ROWS_PER_HAND];
+    matrix_row_t slave_matrix_on_master[ROWS_PER_HAND];
+    matrix_row_t master_matrix_on_slave[ROWS_PER_HAND];
+    uint64_t     now_us;
+    uint64_t     link_busy_us;
+    uint32_t     scans;
+
+    void start(const serial_loopback_link_t &link, uint32_t seed = 1) {
+        memset(master_matrix, 0, sizeof(master_matrix));
+        memset(slave_matrix, 0, sizeof(slave_matrix));
+        memset(slave_matrix_on_master, 0, sizeof(slave_matrix_on_master));
+        memset(master_matrix_on_slave, 0, sizeof(master_matrix_on_slave));
+        timer_clear();
+        serial_loopback_init(&link, seed);
+        now_us       = 0;
+        link_busy_us = 0;
+        scans        = 0;
+    }
+
+    // Runs one scan of both halves, the slave first, and advances the clock by the time they took
+    bool scan() {
+        serial_loopback_enter_slave();
+        transactions_slave(master_matrix_on_slave, slave_matrix);
+        serial_loopback_leave_slave();
+        bool okay = transactions_master(master_matrix, slave_matrix_on_master);
+
+        uint64_t busy_us = serial_loopback_stats()->busy_us;
+        now_us += SCAN_TIME_US + busy_us - link_busy_us;
+        link_busy_us = busy_us;
+        set_time(now_us / 1000);
+        scans++;
+        return okay;
+    }
+
+    // Scans until the halves are in sync, which can take until the next forced sync
+    void settle() {
+        uint64_t until = now_us + 2 * 1000 * 100;
+        while (now_us < until) {
+            scan();
+        }
+    }
+
+    bool in_sync() {
+        return memcmp(slave_matrix, slave_matrix_on_master, sizeof(slave_matrix)) == 0 && memcmp(master_matrix, master_matrix_on_slave, sizeof(master_matrix)) == 0;
+    }
+
+    void settle_and_reset_stats() {
+        settle();
+        serial_loopback_reset_stats();
+        link_busy_us = 0;
+        scans        = 0;
+    }
+};
+
+TEST_F(SplitTransport, SlaveKeyReachesMaster) {
+    start(fast_link);
+    settle();
+
+    slave_matrix[2] = 1 << 5;
+    EXPECT_TRUE(scan());
+    EXPECT_EQ(slave_matrix_on_master[2], 1 << 5);
+
+    slave_matrix[2] = 0;
+    EXPECT_TRUE(scan());
+    EXPECT_EQ(slave_matrix_on_master[2], 0);
+}
+
+TEST_F(SplitTransport, MasterKeyReachesSlave) {
+    start(fast_link);
+    settle();
+
+    master_matrix[1] = 1 << 9;
+    // The slave runs before the master, and batched writes are applied a scan later
+    for (int i = 0; i < 3 && master_matrix_on_slave[1] != master_matrix[1]; i++) {
+        EXPECT_TRUE(scan());
+    }
+    EXPECT_EQ(master_matrix_on_slave[1], 1 << 9);
+}
+
+TEST_F(SplitTransport, EveryRowReachesMaster) {
+    start(simple_link);
+    settle();
+
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        slave_matrix[row] = 0xA5A5 >> row;
+    }
+    EXPECT_TRUE(scan());
+    EXPECT_TRUE(memcmp(slave_matrix, slave_matrix_on_master, sizeof(slave_matrix)) == 0);
+}
+
+TEST_F(SplitTransport, RecoversFromBitErrors) {
+    start(noisy_link, 42);
+    settle();
+
+    uint32_t seed = 7;
+    for (int i = 0; i < 2000; i++) {
+        seed = seed * 1103515245 + 12345;
+        if (i % 10 == 0) {
+            slave_matrix[(seed >> 8) % ROWS_PER_HAND] ^= 1 << ((seed >> 16) % MATRIX_COLS);
+        } else if (i % 10 == 5) {
+            master_matrix[(seed >> 8) % ROWS_PER_HAND] ^= 1 << ((seed >> 16) % MATRIX_COLS);
+        }
+        scan();
+    }
+    EXPECT_GT(serial_loopback_stats()->bit_errors, 0);
+    EXPECT_GT(serial_loopback_stats()->failed_transactions, 0);
+
+    // Once the errors stop, both halves have to end up in sync
+    serial_loopback_set_link(&fast_link);
+    settle();
+    EXPECT_TRUE(in_sync());
+}
+
+////////////////////////////////////////////////////
+// Benchmarks
+
+typedef struct {
+    const char            *name;
+    serial_loopback_link_t link;
+    uint32_t               max_latency_us; // regression bound for the key-to-report latency
+} SplitTransportBenchmarkParams;
+
+class SplitTransportBenchmark : public SplitTransport, public ::testing::WithParamInterface<SplitTransportBenchmarkParams> {};
+
+// Types on both halves for ten seconds, timing each slave key from the change until the master has it
+TEST_P(SplitTransportBenchmark, Typing) {
+    start(GetParam().link);
+    settle_and_reset_stats();
+
+    uint64_t start_us      = now_us;
+    uint64_t changed_us    = 0;
+    bool     pending       = false;
+    uint32_t keys          = 0;
+    uint64_t total_latency = 0;
+    uint64_t max_latency   = 0;
+    uint64_t next_key_us   = now_us;
+    uint32_t seed          = 1;
+
+    while (now_us - start_us < 10 * 1000 * 1000) {
+        if (!pending && now_us >= next_key_us) {
+            seed = seed * 1103515245 + 12345;
+            slave_matrix[(seed >> 8) % ROWS_PER_HAND] ^= 1 << ((seed >> 16) % MATRIX_COLS);
+            master_matrix[(seed >> 20) % ROWS_PER_HAND] ^= 1 << ((seed >> 24) % MATRIX_COLS);
+            changed_us  = now_us;
+            pending     = true;
+            next_key_us = now_us + 30 * 1000 + (seed >> 4) % (20 * 1000);
+        }
+        scan();
+        if (pending && memcmp(slave_matrix, slave_matrix_on_master, sizeof(slave_matrix)) == 0) {
+            uint64_t latency = now_us - changed_us;
+            total_latency += latency;
+            max_latency = latency > max_latency ? latency : max_latency;
+            pending     = false;
+            keys++;
+        }
+    }
+
+    const serial_loopback_stats_t *stats   = serial_loopback_stats();
+    double                         seconds = (now_us - start_us) / 1e6;
+    double                         mean    = keys ? (double)total_latency / keys : 0;
+    printf("[ SPLIT    ] %s/%s: %.0f transactions/s, %.0f scans/s, %.1f bytes/scan, latency %.0f us mean, %llu us max\n", SPLIT_FEATURE, GetParam().name, stats->transactions / seconds, scans / seconds, (double)stats->bytes / scans, mean, (unsigned long long)max_latency);
+    RecordProperty("transactions_per_second", (int)(stats->transactions / seconds));
+    RecordProperty("bytes_per_scan_x10", (int)(10.0 * stats->bytes / scans));
+    RecordProperty("mean_latency_us", (int)mean);
+    RecordProperty("max_latency_us", (int)max_latency);
+
+    EXPECT_GT(keys, 150);
+    EXPECT_EQ(stats->failed_transactions, 0);
+    EXPECT_LE(max_latency, GetParam().max_latency_us);
+    EXPECT_TRUE(in_sync());
+}
+
+// clang-format off
+INSTANTIATE_TEST_CASE_P(
+    Links,
+    SplitTransportBenchmark,
+    ::testing::Values(
+        SplitTransportBenchmarkParams{"1M", {1000000, 0, 0}, 2000},
+        SplitTransportBenchmarkParams{"460800", {460800, 20, 0}, 3000},
+        SplitTransportBenchmarkParams{"115200", {115200, 50, 0}, 6000}
+    ),
+    [](const ::testing::TestParamInfo<SplitTransportBenchmarkParams>& info) {
+        return std::string("Baud") + info.param.name;
+    });
+// clang-format on
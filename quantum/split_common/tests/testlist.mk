@@ -0,0 +1,5 @@
+TEST_LIST += \
+	split_transport \
+	split_transport_delta \
+	split_transport_batching \
+	split_transport_push
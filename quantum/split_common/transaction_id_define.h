@@ -21,8 +21,16 @@ enum serial_transaction_id {
     I2C_EXECUTE_CALLBACK,
 #endif // USE_I2C
 
+#ifdef SPLIT_TRANSACTION_BATCHING
+    EXCHANGE_BATCH,
+#endif // SPLIT_TRANSACTION_BATCHING
+
     GET_SLAVE_MATRIX_CHECKSUM,
     GET_SLAVE_MATRIX_DATA,
+#ifdef SPLIT_TRANSPORT_DELTA
+    GET_SLAVE_MATRIX_DELTA,
+    CMD_SLAVE_MATRIX_RESYNC,
+#endif // SPLIT_TRANSPORT_DELTA
 
 #ifdef SPLIT_TRANSPORT_MIRROR
     PUT_MASTER_MATRIX,
@@ -84,9 +84,26 @@
 #define trans_initiator2target_cb(cb) \
     { 0, 0, 0, 0, cb }
 
-#define transport_write(id, data, length) transport_execute_transaction(id, data, length, NULL, 0)
-#define transport_read(id, data, length) transport_execute_transaction(id, NULL, 0, data, length)
-#define transport_exec(id) transport_execute_transaction(id, NULL, 0, NULL, 0)
+#define trans_initiator2target_frame_initializer_cb(member, cb) \
+    { sizeof_member(split_shared_memory_t, member), offsetof(split_shared_memory_t, member), 0, 0, cb, true }
+
+#define trans_target2initiator_frame_initializer_cb(member, cb) \
+    { 0, 0, sizeof_member(split_shared_memory_t, member), offsetof(split_shared_memory_t, member), cb, true }
+
+#define trans_bidirectional_frame_initializer_cb(initiator2target_member, target2initiator_member, cb) \
+    { sizeof_member(split_shared_memory_t, initiator2target_member), offsetof(split_shared_memory_t, initiator2target_member), sizeof_member(split_shared_memory_t, target2initiator_member), offsetof(split_shared_memory_t, target2initiator_member), cb, true }
+
+#ifdef SPLIT_TRANSACTION_BATCHING
+// Writes and reads made by the handlers are staged for the next batch exchange
+static bool transaction_execute(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length);
+#    define transport_write(id, data, length) transaction_execute(id, data, length, NULL, 0)
+#    define transport_read(id, data, length) transaction_execute(id, NULL, 0, data, length)
+#    define transport_exec(id) transaction_execute(id, NULL, 0, NULL, 0)
+#else
+#    define transport_write(id, data, length) transport_execute_transaction(id, data, length, NULL, 0)
+#    define transport_read(id, data, length) transport_execute_transaction(id, NULL, 0, data, length)
+#    define transport_exec(id) transport_execute_transaction(id, NULL, 0, NULL, 0)
+#endif // SPLIT_TRANSACTION_BATCHING
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 // Forward-declare the RPC callback handlers
@@ -176,34 +193,421 @@ inline static bool send_if_data_mismatch(int8_t trans_id, uint32_t *last_update,
 }
 
 ////////////////////////////////////////////////////
-// Slave matrix
+// Delta-encoded transactions
 
-static bool slave_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
-    static uint32_t     last_update                    = 0;
-    static matrix_row_t last_matrix[(MATRIX_ROWS) / 2] = {0}; // last successfully-read matrix, so we can replicate if there are checksum errors
-    matrix_row_t        temp_matrix[(MATRIX_ROWS) / 2];       // holding area while we test whether or not checksum is correct
+#ifdef SPLIT_TRANSPORT_DELTA
 
-    bool okay = read_if_checksum_mismatch(GET_SLAVE_MATRIX_CHECKSUM, GET_SLAVE_MATRIX_DATA, &last_update, temp_matrix, split_shmem->smatrix.matrix, sizeof(split_shmem->smatrix.matrix));
+#    ifdef SPLIT_TRANSACTION_BATCHING
+#        error "SPLIT_TRANSPORT_DELTA can't be combined with SPLIT_TRANSACTION_BATCHING, which already only sends the data that changed."
+#    endif
+
+inline static void encode_delta(split_delta_encoder_t *encoder, const void *source, split_frame_t *frame) {
+    frame->length   = split_delta_encode(encoder, source, frame->data);
+    frame->checksum = crc8(frame->data, frame->length);
+}
+
+inline static bool decode_delta(split_delta_decoder_t *decoder, void *destination, const split_frame_t *frame, size_t frame_size) {
+    if (frame->length > frame_size - SPLIT_FRAME_HEADER_SIZE || frame->checksum != crc8(frame->data, frame->length)) {
+        return false;
+    }
+    return split_delta_decode(decoder, destination, frame->data, frame->length);
+}
+
+// The encoder's shadow doubles as the record of what was last sent
+inline static bool send_delta_if_data_mismatch(int8_t trans_id, uint32_t *last_update, split_delta_encoder_t *encoder, const void *source, split_frame_t *frame, size_t frame_size) {
+    bool forced = timer_elapsed32(*last_update) >= FORCED_SYNC_THROTTLE_MS;
+    if (!forced && memcmp(source, encoder->shadow, encoder->size) == 0) {
+        return true;
+    }
+
+    // The periodic sync is a full frame, so a target that lost track recovers without a round trip
+    encoder->full |= forced;
+    encode_delta(encoder, source, frame);
+    bool okay = transport_write(trans_id, frame, split_frame_size(frame, frame_size));
     if (okay) {
-        // Checksum matches the received data, save as the last matrix state
-        memcpy(last_matrix, temp_matrix, sizeof(temp_matrix));
+        *last_update = timer_read32();
+    } else {
+        // The target may or may not have applied it
+        encoder->full = true;
+    }
+    return okay;
+}
+
+#endif // SPLIT_TRANSPORT_DELTA
+
+////////////////////////////////////////////////////
+// Batched transactions
+
+#ifdef SPLIT_TRANSACTION_BATCHING
+
+/*
+ * Request: [sequence][flags][read mask, 4 bytes LE] followed by an [id][initiator2target buffer] block per staged write
+ * Reply:   [sequence][flags] followed by an [id][target2initiator buffer] block per read whose data changed, and if
+ *          truncated, the [mask of changed reads that didn't fit, 4 bytes LE]
+ */
+#    define BATCH_MASK_SIZE 4
+#    define BATCH_REQUEST_HEADER_SIZE (2 + BATCH_MASK_SIZE)
+#    define BATCH_RESPONSE_HEADER_SIZE 2
+
+_Static_assert(SPLIT_TRANSACTION_BATCH_SIZE >= BATCH_REQUEST_HEADER_SIZE, "SPLIT_TRANSACTION_BATCH_SIZE too small for the batch header");
+_Static_assert(NUM_TOTAL_TRANSACTIONS <= BATCH_MASK_SIZE * 8, "SPLIT_TRANSACTION_BATCHING supports up to 32 transactions");
+
+#    define BATCH_FLAG_FULL_SYNC (1 << 0) // request: reply with every read, not just the changed ones
+#    define BATCH_FLAG_TRUNCATED (1 << 1) // reply: not every changed read fitted
+
+#    define BATCH_BIT(id) (1UL << (id))
+
+static bool     batch_staging        = false;
+static bool     batch_reads_valid    = false;
+static bool     batch_full_sync      = true;
+static uint8_t  batch_sequence       = 0;
+static uint8_t  batch_request_length = BATCH_REQUEST_HEADER_SIZE;
+static uint32_t batch_write_mask     = 0; // staged writes waiting for the next exchange
+static uint32_t batch_read_mask      = 0; // reads that are served from the batch reply
+static uint32_t batch_stale_mask     = 0; // reads that changed, but didn't fit in the last reply
+
+static bool transaction_execute(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
+    if (batch_staging) {
+        split_transaction_desc_t *trans = &split_transaction_table[id];
+        if (initiator2target_length > 0 && target2initiator_length == 0) {
+            bool staged = batch_write_mask & BATCH_BIT(id);
+            if (staged || batch_request_length + 1 + trans->initiator2target_buffer_size <= SPLIT_TRANSACTION_BATCH_SIZE) {
+                size_t len = trans->initiator2target_buffer_size < initiator2target_length ? trans->initiator2target_buffer_size : initiator2target_length;
+                memcpy(split_trans_initiator2target_buffer(trans), initiator2target_buf, len);
+                if (!staged) {
+                    batch_write_mask |= BATCH_BIT(id);
+                    batch_request_length += 1 + trans->initiator2target_buffer_size;
+                }
+                return true;
+            }
+            // Doesn't fit in the frame, send it on its own
+        } else if (initiator2target_length == 0 && target2initiator_length > 0) {
+            if (batch_reads_valid && (batch_read_mask & BATCH_BIT(id))) {
+                if (!(batch_stale_mask & BATCH_BIT(id))) {
+                    size_t len = trans->target2initiator_buffer_size < target2initiator_length ? trans->target2initiator_buffer_size : target2initiator_length;
+                    memcpy(target2initiator_buf, split_trans_target2initiator_buffer(trans), len);
+                    return true;
+                }
+                // Cut off from the reply, so read on its own. The slave sends it again in the next reply.
+            } else {
+                // First time this is read, or the exchange failed. The slave
+                // doesn't know what this read returns, so resend everything.
+                batch_read_mask |= BATCH_BIT(id);
+                batch_full_sync = true;
+            }
+        }
+    }
+    return transport_execute_transaction(id, initiator2target_buf, initiator2target_length, target2initiator_buf, target2initiator_length);
+}
+
+static bool batch_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static uint32_t     last_full_sync = 0;
+    split_batch_frame_t request;
+    split_batch_frame_t response;
+
+    if (timer_elapsed32(last_full_sync) >= FORCED_SYNC_THROTTLE_MS) {
+        batch_full_sync = true;
+    }
+
+#    ifndef DISABLE_SYNC_TIMER
+    // Staged one loop earlier, so bring it up to date
+    if (batch_write_mask & BATCH_BIT(PUT_SYNC_TIMER)) {
+        split_shmem->sync_timer = sync_timer_read32() + SYNC_TIMER_OFFSET;
+    }
+#    endif // DISABLE_SYNC_TIMER
+
+    uint8_t *data = request.data;
+    *data++       = ++batch_sequence;
+    *data++       = batch_full_sync ? BATCH_FLAG_FULL_SYNC : 0;
+    for (uint8_t i = 0; i < BATCH_MASK_SIZE; i++) {
+        *data++ = batch_read_mask >> (i * 8);
+    }
+    for (int8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; id++) {
+        if (batch_write_mask & BATCH_BIT(id)) {
+            split_transaction_desc_t *trans = &split_transaction_table[id];
+            *data++                         = id;
+            memcpy(data, split_trans_initiator2target_buffer(trans), trans->initiator2target_buffer_size);
+            data += trans->initiator2target_buffer_size;
+        }
+    }
+    request.length   = data - request.data;
+    request.checksum = crc8(request.data, request.length);
+
+    batch_reads_valid = false;
+    if (!transport_execute_transaction(EXCHANGE_BATCH, &request, sizeof(request), &response, sizeof(response))) {
+        batch_full_sync = true;
+        return false;
+    }
+
+    if (response.length < BATCH_RESPONSE_HEADER_SIZE || response.length > sizeof(response.data) || response.checksum != crc8(response.data, response.length) || response.data[0] != batch_sequence) {
+        batch_full_sync = true;
+        return false;
+    }
+
+    // The writes have been applied on the slave
+    batch_write_mask     = 0;
+    batch_request_length = BATCH_REQUEST_HEADER_SIZE;
+    if (batch_full_sync) {
+        last_full_sync  = timer_read32();
+        batch_full_sync = false;
+    }
+
+    uint8_t *end     = response.data + response.length;
+    batch_stale_mask = 0;
+    if (response.data[1] & BATCH_FLAG_TRUNCATED) {
+        if (response.length < BATCH_RESPONSE_HEADER_SIZE + BATCH_MASK_SIZE) {
+            batch_full_sync = true;
+            return false;
+        }
+        end -= BATCH_MASK_SIZE;
+        for (uint8_t i = 0; i < BATCH_MASK_SIZE; i++) {
+            batch_stale_mask |= (uint32_t)end[i] << (i * 8);
+        }
+    }
+    data = response.data + BATCH_RESPONSE_HEADER_SIZE;
+    while (data < end) {
+        uint8_t id = *data++;
+        if (id >= NUM_TOTAL_TRANSACTIONS || end - data < split_transaction_table[id].target2initiator_buffer_size) {
+            batch_full_sync = true;
+            return false;
+        }
+        split_transaction_desc_t *trans = &split_transaction_table[id];
+        memcpy(split_trans_target2initiator_buffer(trans), data, trans->target2initiator_buffer_size);
+        data += trans->target2initiator_buffer_size;
+    }
+
+    batch_reads_valid = true;
+    return true;
+}
+
+static void slave_batch_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    // Copy of the reads as they were last sent, so only what changed since is sent
+    static uint8_t  sent[SPLIT_TRANSACTION_BATCH_SIZE];
+    static uint32_t sent_layout = 0; // read mask the copy is laid out for
+    static uint32_t sent_mask   = 0; // reads with a valid copy
+
+    split_batch_frame_t *request  = &split_shmem->batch_request;
+    split_batch_frame_t *response = &split_shmem->batch_response;
+
+    response->length = 0;
+    if (request->length < BATCH_REQUEST_HEADER_SIZE || request->length > sizeof(request->data) || request->checksum != crc8(request->data, request->length)) {
+        return;
+    }
+
+    const uint8_t *data      = request->data;
+    uint8_t        sequence  = *data++;
+    uint8_t        flags     = *data++;
+    uint32_t       read_mask = 0;
+    for (uint8_t i = 0; i < BATCH_MASK_SIZE; i++) {
+        read_mask |= (uint32_t)*data++ << (i * 8);
+    }
+
+    const uint8_t *end = request->data + request->length;
+    while (data < end) {
+        uint8_t id = *data++;
+        if (id >= NUM_TOTAL_TRANSACTIONS || end - data < split_transaction_table[id].initiator2target_buffer_size) {
+            return;
+        }
+        split_transaction_desc_t *trans = &split_transaction_table[id];
+        memcpy(split_trans_initiator2target_buffer(trans), data, trans->initiator2target_buffer_size);
+        data += trans->initiator2target_buffer_size;
+        if (trans->slave_callback) {
+            trans->slave_callback(trans->initiator2target_buffer_size, split_trans_initiator2target_buffer(trans), trans->target2initiator_buffer_size, split_trans_target2initiator_buffer(trans));
+        }
+    }
+
+    if ((flags & BATCH_FLAG_FULL_SYNC) || read_mask != sent_layout) {
+        sent_layout = read_mask;
+        sent_mask   = 0;
+    }
+
+    uint8_t *reply       = response->data;
+    uint8_t  reply_flags = 0;
+    uint8_t  sent_offset = 0;
+    uint32_t cut_off     = 0;
+    *reply++             = sequence;
+    reply++;
+    for (int8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; id++) {
+        split_transaction_desc_t *trans = &split_transaction_table[id];
+        if (!(read_mask & BATCH_BIT(id)) || trans->target2initiator_buffer_size == 0) {
+            continue;
+        }
+
+        const uint8_t *current = split_trans_target2initiator_buffer(trans);
+        uint8_t       *last    = NULL;
+        if (sent_offset + trans->target2initiator_buffer_size <= sizeof(sent)) {
+            last = &sent[sent_offset];
+            sent_offset += trans->target2initiator_buffer_size;
+        }
+        // Reads that don't fit in the copy are always sent
+        if ((sent_mask & BATCH_BIT(id)) && last && memcmp(last, current, trans->target2initiator_buffer_size) == 0) {
+            continue;
+        }
+
+        // Room is kept for the mask of reads that are cut off. Their copy isn't updated, so they're sent next time.
+        if (reply + 1 + trans->target2initiator_buffer_size > response->data + sizeof(response->data) - BATCH_MASK_SIZE) {
+            reply_flags |= BATCH_FLAG_TRUNCATED;
+            cut_off |= BATCH_BIT(id);
+            continue;
+        }
+        *reply++ = id;
+        memcpy(reply, current, trans->target2initiator_buffer_size);
+        reply += trans->target2initiator_buffer_size;
+        if (last) {
+            memcpy(last, current, trans->target2initiator_buffer_size);
+            sent_mask |= BATCH_BIT(id);
+        }
+    }
+    if (cut_off) {
+        for (uint8_t i = 0; i < BATCH_MASK_SIZE; i++) {
+            *reply++ = cut_off >> (i * 8);
+        }
+    }
+    response->data[1]  = reply_flags;
+    response->length   = reply - response->data;
+    response->checksum = crc8(response->data, response->length);
+}
+
+#    define TRANSACTIONS_BATCH_MASTER() TRANSACTION_HANDLER_MASTER(batch)
+#    define TRANSACTIONS_BATCH_REGISTRATIONS [EXCHANGE_BATCH] = trans_bidirectional_frame_initializer_cb(batch_request, batch_response, slave_batch_callback),
+
+#else // SPLIT_TRANSACTION_BATCHING
+
+#    define TRANSACTIONS_BATCH_MASTER()
+#    define TRANSACTIONS_BATCH_REGISTRATIONS
+
+#endif // SPLIT_TRANSACTION_BATCHING
+
+////////////////////////////////////////////////////
+// Slave matrix
+
+static uint16_t slave_matrix_time = 0;
+
+static void slave_matrix_store(split_slave_matrix_data_t *last_data, const split_slave_matrix_data_t *data) {
+#ifdef DISABLE_SYNC_TIMER
+    // Without a shared clock, the best estimate is the time the change was received
+    if (memcmp(last_data->matrix, data->matrix, sizeof(data->matrix)) != 0) {
+        slave_matrix_time = timer_read();
+    }
+#else
+    slave_matrix_time = data->scan_time;
+#endif
+    memcpy(last_data, data, sizeof(split_slave_matrix_data_t));
+}
+
+#ifdef SPLIT_TRANSPORT_DELTA
+static split_slave_matrix_data_t slave_matrix_shadow;
+static split_delta_encoder_t     slave_matrix_encoder = {&slave_matrix_shadow, sizeof(split_slave_matrix_data_t), sizeof(matrix_row_t), 0, true};
+
+static void slave_matrix_delta_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    // Encoded as the master reads it, against the state it read last
+    encode_delta(&slave_matrix_encoder, &split_shmem->smatrix.data, (split_frame_t *)&split_shmem->smatrix_delta);
+}
+
+static void slave_matrix_resync_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    slave_matrix_encoder.full = true;
+}
+
+static bool slave_matrix_read_delta(split_slave_matrix_data_t *data) {
+    static split_delta_decoder_t decoder = {sizeof(split_slave_matrix_data_t), sizeof(matrix_row_t), 0};
+    split_slave_matrix_delta_t   frame;
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        if (!transport_read(GET_SLAVE_MATRIX_DELTA, &frame, sizeof(frame))) {
+            return false;
+        }
+        if (decode_delta(&decoder, data, (split_frame_t *)&frame, sizeof(frame))) {
+            return true;
+        }
+        // Out of step with the slave, have the next read carry the full matrix
+        if (!transport_exec(CMD_SLAVE_MATRIX_RESYNC)) {
+            return false;
+        }
+    }
+    return false;
+}
+
+// Same as read_if_checksum_mismatch, with the data read as a delta against the shared memory
+static bool slave_matrix_read_if_checksum_mismatch(uint32_t *last_update, split_slave_matrix_data_t *destination) {
+    split_slave_matrix_data_t *equiv_shmem = &split_shmem->smatrix.data;
+    uint8_t                    curr_checksum;
+    bool                       okay = transport_read(GET_SLAVE_MATRIX_CHECKSUM, &curr_checksum, sizeof(curr_checksum));
+    if (okay && (timer_elapsed32(*last_update) >= FORCED_SYNC_THROTTLE_MS || curr_checksum != crc8(equiv_shmem, sizeof(*equiv_shmem)))) {
+        memcpy(destination, equiv_shmem, sizeof(*destination));
+        okay &= slave_matrix_read_delta(destination);
+        okay &= curr_checksum == crc8(destination, sizeof(*destination));
+        if (okay) {
+            memcpy(equiv_shmem, destination, sizeof(*destination));
+            *last_update = timer_read32();
+        }
+    } else {
+        memcpy(destination, equiv_shmem, sizeof(*destination));
+    }
+    return okay;
+}
+#endif // SPLIT_TRANSPORT_DELTA
+
+static bool slave_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static uint32_t                  last_update = 0;
+    static split_slave_matrix_data_t last_data   = {0}; // last successfully-read matrix, so we can replicate if there are checksum errors
+    split_slave_matrix_data_t        temp_data;         // holding area while we test whether or not checksum is correct
+    bool                             okay = true;
+
+#ifdef SPLIT_MATRIX_PUSH
+    // The slave pushes its matrix as soon as it changes, so only poll for the periodic resync
+    if (transport_pushed(GET_SLAVE_MATRIX_DATA)) {
+        slave_matrix_store(&last_data, &split_shmem->smatrix.data);
+    }
+    if (timer_elapsed32(last_update) >= FORCED_SYNC_THROTTLE_MS)
+#endif // SPLIT_MATRIX_PUSH
+    {
+#ifdef SPLIT_TRANSPORT_DELTA
+        okay = slave_matrix_read_if_checksum_mismatch(&last_update, &temp_data);
+#else
+        okay = read_if_checksum_mismatch(GET_SLAVE_MATRIX_CHECKSUM, GET_SLAVE_MATRIX_DATA, &last_update, &temp_data, &split_shmem->smatrix.data, sizeof(split_shmem->smatrix.data));
+#endif // SPLIT_TRANSPORT_DELTA
+        if (okay) {
+            // Checksum matches the received data, save as the last matrix state
+            slave_matrix_store(&last_data, &temp_data);
+        }
     }
     // Copy out the last-known-good matrix state to the slave matrix
-    memcpy(slave_matrix, last_matrix, sizeof(last_matrix));
+    memcpy(slave_matrix, last_data.matrix, sizeof(last_data.matrix));
     return okay;
 }
 
 static void slave_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
-    memcpy(split_shmem->smatrix.matrix, slave_matrix, sizeof(split_shmem->smatrix.matrix));
-    split_shmem->smatrix.checksum = crc8(split_shmem->smatrix.matrix, sizeof(split_shmem->smatrix.matrix));
+    if (memcmp(split_shmem->smatrix.data.matrix, slave_matrix, sizeof(split_shmem->smatrix.data.matrix)) != 0) {
+        memcpy(split_shmem->smatrix.data.matrix, slave_matrix, sizeof(split_shmem->smatrix.data.matrix));
+#ifndef DISABLE_SYNC_TIMER
+        // Runs straight after the slave's matrix scan, so this is when the change was seen
+        split_shmem->smatrix.data.scan_time = sync_timer_read();
+#endif
+#ifdef SPLIT_MATRIX_PUSH
+        // The shared memory is locked, so this can't interleave with a transaction reply
+        transport_push(GET_SLAVE_MATRIX_DATA);
+#endif // SPLIT_MATRIX_PUSH
+    }
+    split_shmem->smatrix.checksum = crc8(&split_shmem->smatrix.data, sizeof(split_shmem->smatrix.data));
+}
+
+uint16_t split_slave_matrix_time(void) {
+    return slave_matrix_time;
 }
 
 // clang-format off
 #define TRANSACTIONS_SLAVE_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(slave_matrix)
 #define TRANSACTIONS_SLAVE_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(slave_matrix)
+#ifdef SPLIT_TRANSPORT_DELTA
+#    define TRANSACTIONS_SLAVE_MATRIX_DELTA_REGISTRATIONS \
+    [GET_SLAVE_MATRIX_DELTA]  = trans_target2initiator_frame_initializer_cb(smatrix_delta, slave_matrix_delta_callback), \
+    [CMD_SLAVE_MATRIX_RESYNC] = trans_initiator2target_cb(slave_matrix_resync_callback),
+#else
+#    define TRANSACTIONS_SLAVE_MATRIX_DELTA_REGISTRATIONS
+#endif // SPLIT_TRANSPORT_DELTA
 #define TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS \
     [GET_SLAVE_MATRIX_CHECKSUM] = trans_target2initiator_initializer(smatrix.checksum), \
-    [GET_SLAVE_MATRIX_DATA]     = trans_target2initiator_initializer(smatrix.matrix),
+    [GET_SLAVE_MATRIX_DATA]     = trans_target2initiator_initializer(smatrix.data), \
+    TRANSACTIONS_SLAVE_MATRIX_DELTA_REGISTRATIONS
 // clang-format on
 
 ////////////////////////////////////////////////////
@@ -545,8 +949,23 @@ static bool led_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_
     led_matrix_sync_t led_matrix_sync;
     memcpy(&led_matrix_sync.led_matrix, &led_matrix_eeconfig, sizeof(led_eeconfig_t));
     led_matrix_sync.led_suspend_state = led_matrix_get_suspend_state();
+#    ifdef SPLIT_TRANSPORT_DELTA
+    static led_matrix_sync_t     last_sent;
+    static split_delta_encoder_t encoder = {&last_sent, sizeof(led_matrix_sync_t), 1, 0, true};
+    led_matrix_delta_t           frame;
+    return send_delta_if_data_mismatch(PUT_LED_MATRIX, &last_update, &encoder, &led_matrix_sync, (split_frame_t *)&frame, sizeof(frame));
+#    else
     return send_if_data_mismatch(PUT_LED_MATRIX, &last_update, &led_matrix_sync, &split_shmem->led_matrix_sync, sizeof(led_matrix_sync));
+#    endif // SPLIT_TRANSPORT_DELTA
+}
+
+#    ifdef SPLIT_TRANSPORT_DELTA
+// Decoded as soon as it arrives, before the next frame can overwrite it
+static void led_matrix_delta_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    static split_delta_decoder_t decoder = {sizeof(led_matrix_sync_t), 1, 0};
+    decode_delta(&decoder, &split_shmem->led_matrix_sync, (const split_frame_t *)initiator2target_buffer, initiator2target_buffer_size);
 }
+#    endif // SPLIT_TRANSPORT_DELTA
 
 static void led_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     split_shared_memory_lock();
@@ -559,7 +978,11 @@ static void led_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
 
 #    define TRANSACTIONS_LED_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(led_matrix)
 #    define TRANSACTIONS_LED_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE(led_matrix)
-#    define TRANSACTIONS_LED_MATRIX_REGISTRATIONS [PUT_LED_MATRIX] = trans_initiator2target_initializer(led_matrix_sync),
+#    ifdef SPLIT_TRANSPORT_DELTA
+#        define TRANSACTIONS_LED_MATRIX_REGISTRATIONS [PUT_LED_MATRIX] = trans_initiator2target_frame_initializer_cb(led_matrix_delta, led_matrix_delta_callback),
+#    else
+#        define TRANSACTIONS_LED_MATRIX_REGISTRATIONS [PUT_LED_MATRIX] = trans_initiator2target_initializer(led_matrix_sync),
+#    endif // SPLIT_TRANSPORT_DELTA
 
 #else // defined(LED_MATRIX_ENABLE) && defined(LED_MATRIX_SPLIT)
 
@@ -579,8 +1002,23 @@ static bool rgb_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_
     rgb_matrix_sync_t rgb_matrix_sync;
     memcpy(&rgb_matrix_sync.rgb_matrix, &rgb_matrix_config, sizeof(rgb_config_t));
     rgb_matrix_sync.rgb_suspend_state = rgb_matrix_get_suspend_state();
+#    ifdef SPLIT_TRANSPORT_DELTA
+    static rgb_matrix_sync_t     last_sent;
+    static split_delta_encoder_t encoder = {&last_sent, sizeof(rgb_matrix_sync_t), 1, 0, true};
+    rgb_matrix_delta_t           frame;
+    return send_delta_if_data_mismatch(PUT_RGB_MATRIX, &last_update, &encoder, &rgb_matrix_sync, (split_frame_t *)&frame, sizeof(frame));
+#    else
     return send_if_data_mismatch(PUT_RGB_MATRIX, &last_update, &rgb_matrix_sync, &split_shmem->rgb_matrix_sync, sizeof(rgb_matrix_sync));
+#    endif // SPLIT_TRANSPORT_DELTA
+}
+
+#    ifdef SPLIT_TRANSPORT_DELTA
+// Decoded as soon as it arrives, before the next frame can overwrite it
+static void rgb_matrix_delta_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    static split_delta_decoder_t decoder = {sizeof(rgb_matrix_sync_t), 1, 0};
+    decode_delta(&decoder, &split_shmem->rgb_matrix_sync, (const split_frame_t *)initiator2target_buffer, initiator2target_buffer_size);
 }
+#    endif // SPLIT_TRANSPORT_DELTA
 
 static void rgb_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     split_shared_memory_lock();
@@ -593,7 +1031,11 @@ static void rgb_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
 
 #    define TRANSACTIONS_RGB_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(rgb_matrix)
 #    define TRANSACTIONS_RGB_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE(rgb_matrix)
-#    define TRANSACTIONS_RGB_MATRIX_REGISTRATIONS [PUT_RGB_MATRIX] = trans_initiator2target_initializer(rgb_matrix_sync),
+#    ifdef SPLIT_TRANSPORT_DELTA
+#        define TRANSACTIONS_RGB_MATRIX_REGISTRATIONS [PUT_RGB_MATRIX] = trans_initiator2target_frame_initializer_cb(rgb_matrix_delta, rgb_matrix_delta_callback),
+#    else
+#        define TRANSACTIONS_RGB_MATRIX_REGISTRATIONS [PUT_RGB_MATRIX] = trans_initiator2target_initializer(rgb_matrix_sync),
+#    endif // SPLIT_TRANSPORT_DELTA
 
 #else // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
 
@@ -925,6 +1367,7 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
 #endif // USE_I2C
 
     // clang-format off
+    TRANSACTIONS_BATCH_REGISTRATIONS
     TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS
     TRANSACTIONS_MASTER_MATRIX_REGISTRATIONS
     TRANSACTIONS_ENCODERS_REGISTRATIONS
@@ -954,7 +1397,7 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
 #endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 };
 
-bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+static bool transactions_master_handlers(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     TRANSACTIONS_SLAVE_MATRIX_MASTER();
     TRANSACTIONS_MASTER_MATRIX_MASTER();
     TRANSACTIONS_ENCODERS_MASTER();
@@ -977,6 +1420,20 @@ bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix
     return true;
 }
 
+bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+#ifdef SPLIT_TRANSACTION_BATCHING
+    // One exchange carries the writes staged by the previous loop and
+    // returns the reads, the handlers then run against the shared memory
+    TRANSACTIONS_BATCH_MASTER();
+    batch_staging = true;
+    bool okay     = transactions_master_handlers(master_matrix, slave_matrix);
+    batch_staging = false;
+    return okay;
+#else
+    return transactions_master_handlers(master_matrix, slave_matrix);
+#endif // SPLIT_TRANSACTION_BATCHING
+}
+
 void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     TRANSACTIONS_SLAVE_MATRIX_SLAVE();
     TRANSACTIONS_MASTER_MATRIX_SLAVE();
@@ -32,6 +32,7 @@ typedef struct _split_transaction_desc_t {
     uint8_t          target2initiator_buffer_size;
     uint16_t         target2initiator_offset;
     slave_callback_t slave_callback;
+    bool             framed; // buffers hold a variable length frame, see SPLIT_FRAME_STRUCT
 } split_transaction_desc_t;
 
 // Forward declaration for the split transactions
@@ -45,6 +46,9 @@ extern split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS];
 bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
 void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
 
+// sync timer timestamp of the scan in which the slave half's matrix last changed
+uint16_t split_slave_matrix_time(void);
+
 void transaction_register_rpc(int8_t transaction_id, slave_callback_t callback);
 
 bool transaction_rpc_exec(int8_t transaction_id, uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer);
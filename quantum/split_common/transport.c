@@ -32,6 +32,10 @@
 #        define SLAVE_I2C_ADDRESS 0x32
 #    endif
 
+#    ifdef SPLIT_MATRIX_PUSH
+#        error "SPLIT_MATRIX_PUSH requires a full-duplex serial connection, it is not supported over I2C"
+#    endif // SPLIT_MATRIX_PUSH
+
 #    include "i2c_master.h"
 #    include "i2c_slave.h"
 
@@ -59,13 +63,40 @@ i2c_status_t transport_trigger_callback(int8_t id) {
     return i2c_write_register(SLAVE_I2C_ADDRESS, trans->initiator2target_offset, split_trans_initiator2target_buffer(trans), trans->initiator2target_buffer_size, SLAVE_I2C_TIMEOUT);
 }
 
+// Framed buffers are variable length, so only the used part of them is transferred
+static i2c_status_t transport_write_buffer(split_transaction_desc_t *trans, size_t len) {
+    uint8_t *buffer = split_trans_initiator2target_buffer(trans);
+    if (trans->framed) {
+        len = split_frame_size(buffer, trans->initiator2target_buffer_size);
+    }
+    return i2c_write_register(SLAVE_I2C_ADDRESS, trans->initiator2target_offset, buffer, len, SLAVE_I2C_TIMEOUT);
+}
+
+static i2c_status_t transport_read_buffer(split_transaction_desc_t *trans, size_t *len) {
+    uint8_t *buffer = split_trans_target2initiator_buffer(trans);
+    if (!trans->framed) {
+        return i2c_read_register(SLAVE_I2C_ADDRESS, trans->target2initiator_offset, buffer, *len, SLAVE_I2C_TIMEOUT);
+    }
+
+    // Read the header first to know how much of the frame is used
+    i2c_status_t status = i2c_read_register(SLAVE_I2C_ADDRESS, trans->target2initiator_offset, buffer, SPLIT_FRAME_HEADER_SIZE, SLAVE_I2C_TIMEOUT);
+    if (status < 0) {
+        return status;
+    }
+    *len = split_frame_size(buffer, *len);
+    if (*len > SPLIT_FRAME_HEADER_SIZE) {
+        status = i2c_read_register(SLAVE_I2C_ADDRESS, trans->target2initiator_offset + SPLIT_FRAME_HEADER_SIZE, buffer + SPLIT_FRAME_HEADER_SIZE, *len - SPLIT_FRAME_HEADER_SIZE, SLAVE_I2C_TIMEOUT);
+    }
+    return status;
+}
+
 bool transport_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
     i2c_status_t              status;
     split_transaction_desc_t *trans = &split_transaction_table[id];
     if (initiator2target_length > 0) {
         size_t len = trans->initiator2target_buffer_size < initiator2target_length ? trans->initiator2target_buffer_size : initiator2target_length;
         memcpy(split_trans_initiator2target_buffer(trans), initiator2target_buf, len);
-        if ((status = i2c_write_register(SLAVE_I2C_ADDRESS, trans->initiator2target_offset, split_trans_initiator2target_buffer(trans), len, SLAVE_I2C_TIMEOUT)) < 0) {
+        if ((status = transport_write_buffer(trans, len)) < 0) {
             return false;
         }
     }
@@ -77,7 +108,7 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
 
     if (target2initiator_length > 0) {
         size_t len = trans->target2initiator_buffer_size < target2initiator_length ? trans->target2initiator_buffer_size : target2initiator_length;
-        if ((status = i2c_read_register(SLAVE_I2C_ADDRESS, trans->target2initiator_offset, split_trans_target2initiator_buffer(trans), len, SLAVE_I2C_TIMEOUT)) < 0) {
+        if ((status = transport_read_buffer(trans, &len)) < 0) {
             return false;
         }
         memcpy(target2initiator_buf, split_trans_target2initiator_buffer(trans), len);
@@ -119,6 +150,16 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
     return true;
 }
 
+#    ifdef SPLIT_MATRIX_PUSH
+bool transport_push(int8_t id) {
+    return soft_serial_push(id);
+}
+
+bool transport_pushed(int8_t id) {
+    return soft_serial_pushed(id);
+}
+#    endif // SPLIT_MATRIX_PUSH
+
 #endif // USE_I2C
 
 bool transport_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
@@ -16,12 +16,14 @@
 
 #pragma once
 
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 
 #include "progmem.h"
 #include "action_layer.h"
 #include "matrix.h"
+#include "split_delta.h"
 
 #ifndef RPC_M2S_BUFFER_SIZE
 #    define RPC_M2S_BUFFER_SIZE 32
@@ -31,6 +33,10 @@
 #    define RPC_S2M_BUFFER_SIZE 32
 #endif // RPC_S2M_BUFFER_SIZE
 
+#if defined(SPLIT_TRANSACTION_BATCHING) && !defined(SPLIT_TRANSACTION_BATCH_SIZE)
+#    define SPLIT_TRANSACTION_BATCH_SIZE 64
+#endif // defined(SPLIT_TRANSACTION_BATCHING) && !defined(SPLIT_TRANSACTION_BATCH_SIZE)
+
 void transport_master_init(void);
 void transport_slave_init(void);
 
@@ -40,6 +46,13 @@ void transport_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
 
 bool transport_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length);
 
+#ifdef SPLIT_MATRIX_PUSH
+// slave side, sends the target2initiator buffer of a transaction without the master asking for it
+bool transport_push(int8_t id);
+// master side, returns true if the slave pushed the buffer of a transaction since the last call
+bool transport_pushed(int8_t id);
+#endif // SPLIT_MATRIX_PUSH
+
 #ifdef ENCODER_ENABLE
 #    include "encoder.h"
 #endif // ENCODER_ENABLE
@@ -52,11 +65,50 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
 #    include "rgblight.h"
 #endif // RGBLIGHT_ENABLE
 
-typedef struct _split_slave_matrix_sync_t {
-    uint8_t      checksum;
+// Variable length frame, only the header and the used part of the data are transferred
+#define SPLIT_FRAME_STRUCT(size)                               \
+    struct {                                                   \
+        uint8_t length;   /* bytes used in data */             \
+        uint8_t checksum; /* crc8 of the used part of data */ \
+        uint8_t data[size];                                    \
+    }
+
+// Common view of all frames, regardless of their capacity
+typedef struct _split_frame_t {
+    uint8_t length;
+    uint8_t checksum;
+    uint8_t data[];
+} split_frame_t;
+
+#define SPLIT_FRAME_HEADER_SIZE offsetof(split_frame_t, data)
+
+static inline uint16_t split_frame_size(const void *frame, uint16_t capacity) {
+    uint8_t length = ((const split_frame_t *)frame)->length;
+    return SPLIT_FRAME_HEADER_SIZE + (length < capacity - SPLIT_FRAME_HEADER_SIZE ? length : capacity - SPLIT_FRAME_HEADER_SIZE);
+}
+
+#ifdef SPLIT_TRANSACTION_BATCHING
+_Static_assert(SPLIT_TRANSACTION_BATCH_SIZE <= UINT8_MAX, "SPLIT_TRANSACTION_BATCH_SIZE must fit in a byte");
+
+typedef SPLIT_FRAME_STRUCT(SPLIT_TRANSACTION_BATCH_SIZE) split_batch_frame_t;
+#endif // SPLIT_TRANSACTION_BATCHING
+
+typedef struct _split_slave_matrix_data_t {
     matrix_row_t matrix[(MATRIX_ROWS) / 2];
+#ifndef DISABLE_SYNC_TIMER
+    uint16_t scan_time; // sync timer timestamp of the scan that last changed the matrix
+#endif // DISABLE_SYNC_TIMER
+} split_slave_matrix_data_t;
+
+typedef struct _split_slave_matrix_sync_t {
+    uint8_t                   checksum;
+    split_slave_matrix_data_t data;
 } split_slave_matrix_sync_t;
 
+#ifdef SPLIT_TRANSPORT_DELTA
+typedef SPLIT_FRAME_STRUCT(SPLIT_DELTA_PAYLOAD_SIZE(sizeof(split_slave_matrix_data_t))) split_slave_matrix_delta_t;
+#endif // SPLIT_TRANSPORT_DELTA
+
 #ifdef SPLIT_TRANSPORT_MIRROR
 typedef struct _split_master_matrix_sync_t {
     matrix_row_t matrix[(MATRIX_ROWS) / 2];
@@ -84,6 +136,10 @@ typedef struct _led_matrix_sync_t {
     led_eeconfig_t led_matrix;
     bool           led_suspend_state;
 } led_matrix_sync_t;
+
+#    ifdef SPLIT_TRANSPORT_DELTA
+typedef SPLIT_FRAME_STRUCT(SPLIT_DELTA_PAYLOAD_SIZE(sizeof(led_matrix_sync_t))) led_matrix_delta_t;
+#    endif // SPLIT_TRANSPORT_DELTA
 #endif // defined(LED_MATRIX_ENABLE) && defined(LED_MATRIX_SPLIT)
 
 #if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
@@ -93,6 +149,10 @@ typedef struct _rgb_matrix_sync_t {
     rgb_config_t rgb_matrix;
     bool         rgb_suspend_state;
 } rgb_matrix_sync_t;
+
+#    ifdef SPLIT_TRANSPORT_DELTA
+typedef SPLIT_FRAME_STRUCT(SPLIT_DELTA_PAYLOAD_SIZE(sizeof(rgb_matrix_sync_t))) rgb_matrix_delta_t;
+#    endif // SPLIT_TRANSPORT_DELTA
 #endif // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
 
 #ifdef SPLIT_MODS_ENABLE
@@ -152,7 +212,15 @@ typedef struct _split_shared_memory_t {
     int8_t transaction_id;
 #endif // USE_I2C
 
+#ifdef SPLIT_TRANSACTION_BATCHING
+    split_batch_frame_t batch_request;
+    split_batch_frame_t batch_response;
+#endif // SPLIT_TRANSACTION_BATCHING
+
     split_slave_matrix_sync_t smatrix;
+#ifdef SPLIT_TRANSPORT_DELTA
+    split_slave_matrix_delta_t smatrix_delta;
+#endif // SPLIT_TRANSPORT_DELTA
 
 #ifdef SPLIT_TRANSPORT_MIRROR
     split_master_matrix_sync_t mmatrix;
@@ -188,10 +256,16 @@ typedef struct _split_shared_memory_t {
 
 #if defined(LED_MATRIX_ENABLE) && defined(LED_MATRIX_SPLIT)
     led_matrix_sync_t led_matrix_sync;
+#    ifdef SPLIT_TRANSPORT_DELTA
+    led_matrix_delta_t led_matrix_delta;
+#    endif // SPLIT_TRANSPORT_DELTA
 #endif // defined(LED_MATRIX_ENABLE) && defined(LED_MATRIX_SPLIT)
 
 #if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
     rgb_matrix_sync_t rgb_matrix_sync;
+#    ifdef SPLIT_TRANSPORT_DELTA
+    rgb_matrix_delta_t rgb_matrix_delta;
+#    endif // SPLIT_TRANSPORT_DELTA
 #endif // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
 
 #if defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE)
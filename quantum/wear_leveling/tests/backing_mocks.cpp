@@ -18,11 +18,12 @@ void MockBackingStore::reset_instance() {
     backing_max_write_count   = 0;
     backing_total_write_count = 0;
 
-    backing_init_invoke_count   = 0;
-    backing_unlock_invoke_count = 0;
-    backing_erase_invoke_count  = 0;
-    backing_write_invoke_count  = 0;
-    backing_lock_invoke_count   = 0;
+    backing_init_invoke_count       = 0;
+    backing_unlock_invoke_count     = 0;
+    backing_erase_invoke_count      = 0;
+    backing_write_invoke_count      = 0;
+    backing_write_bulk_invoke_count = 0;
+    backing_lock_invoke_count       = 0;
 
     init_success_callback   = [](std::uint64_t) { return true; };
     erase_success_callback  = [](std::uint64_t) { return true; };
@@ -101,6 +102,18 @@ bool MockBackingStore::write(uint32_t address, backing_store_int_t value) {
     return true;
 }
 
+bool MockBackingStore::write_bulk(uint32_t address, const backing_store_int_t* values, std::size_t item_count) {
+    ++backing_write_bulk_invoke_count;
+
+    // Bulk writes are emulated one item at a time, matching the default implementation
+    for (std::size_t i = 0; i < item_count; ++i) {
+        if (!write(address + (i * BACKING_STORE_WRITE_SIZE), values[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
 bool MockBackingStore::lock(void) {
     ++backing_lock_invoke_count;
 
@@ -145,6 +158,10 @@ extern "C" bool backing_store_write(uint32_t address, backing_store_int_t value)
     return MockBackingStore::Instance().write(address, value);
 }
 
+extern "C" bool backing_store_write_bulk(uint32_t address, backing_store_int_t* values, size_t item_count) {
+    return MockBackingStore::Instance().write_bulk(address, values, item_count);
+}
+
 extern "C" bool backing_store_lock(void) {
     return MockBackingStore::Instance().lock();
 }
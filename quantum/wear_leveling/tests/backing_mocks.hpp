@@ -95,6 +95,7 @@ class MockBackingStore {
     std::uint64_t backing_unlock_invoke_count;
     std::uint64_t backing_erase_invoke_count;
     std::uint64_t backing_write_invoke_count;
+    std::uint64_t backing_write_bulk_invoke_count;
     std::uint64_t backing_lock_invoke_count;
 
     // Whether init should succeed
@@ -144,6 +145,9 @@ class MockBackingStore {
     std::uint64_t write_invoke_count() const {
         return backing_write_invoke_count;
     }
+    std::uint64_t write_bulk_invoke_count() const {
+        return backing_write_bulk_invoke_count;
+    }
     std::uint64_t lock_invoke_count() const {
         return backing_lock_invoke_count;
     }
@@ -160,6 +164,7 @@ class MockBackingStore {
     bool unlock();
     bool erase();
     bool write(std::uint32_t address, backing_store_int_t value);
+    bool write_bulk(std::uint32_t address, const backing_store_int_t* values, std::size_t item_count);
     bool lock();
     bool read(std::uint32_t address, backing_store_int_t& value) const;
 
@@ -4,6 +4,7 @@ wear_leveling_common_SRC := \
 	$(LIB_PATH)/fnv/qmk_fnv_type_validation.c \
 	$(LIB_PATH)/fnv/hash_32a.c \
 	$(LIB_PATH)/fnv/hash_64a.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c \
 	$(QUANTUM_PATH)/wear_leveling/wear_leveling.c \
 	$(QUANTUM_PATH)/wear_leveling/tests/backing_mocks.cpp
 wear_leveling_common_INC := \
@@ -63,4 +64,17 @@ wear_leveling_8byte_SRC := \
 	$(wear_leveling_common_SRC) \
 	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_8byte.cpp
 wear_leveling_8byte_INC := \
-	$(wear_leveling_common_INC)
\ No newline at end of file
+	$(wear_leveling_common_INC)
+wear_leveling_write_back_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DBACKING_STORE_WRITE_SIZE=2 \
+	-DWEAR_LEVELING_BACKING_SIZE=384 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=128 \
+	-DWEAR_LEVELING_WRITE_BACK_ENABLE \
+	-DWEAR_LEVELING_WRITE_BACK_RANGES=4 \
+	-DWEAR_LEVELING_WRITE_BACK_BUFFER_SIZE=16
+wear_leveling_write_back_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_write_back.cpp
+wear_leveling_write_back_INC := \
+	$(wear_leveling_common_INC)
@@ -293,3 +293,32 @@ TEST_F(WearLeveling2ByteOptimizedWrites, PlaybackReadbackWord01_Success) {
     wear_leveling_read(0x02, &tmp, sizeof(tmp));
     EXPECT_EQ(tmp, 1) << "Failed to read back the seeded data";
 }
+
+/**
+ * This test verifies that a long write log is played back with far fewer reads than it has entries.
+ */
+TEST_F(WearLeveling2ByteOptimizedWrites, PlaybackLongLog_BulkReads) {
+    std::fill(verify_data.begin(), verify_data.end(), 0);
+
+    // Single-byte multibyte entries, 2 backing store writes each
+    for (uint32_t address = 2000; address < 4000; address += 2) {
+        uint8_t value = (uint8_t)(address >> 1) | 0x80;
+        EXPECT_EQ(test_write(address, &value, sizeof(value)), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    }
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+
+    auto stats = wear_leveling_get_init_stats();
+    EXPECT_EQ(stats->log_bytes, 1000 * 2 * BACKING_STORE_WRITE_SIZE) << "Invalid number of log bytes played back";
+
+    // Log reads grow from 8 bytes up to the chunk size, with the terminating empty slot read last
+    std::size_t expected_reads = 2;
+    for (std::size_t read = 0, chunk = 8; read < stats->log_bytes + BACKING_STORE_WRITE_SIZE; read += chunk, chunk = std::min<std::size_t>(chunk * 2, WEAR_LEVELING_PLAYBACK_CHUNK_SIZE)) {
+        ++expected_reads;
+    }
+    EXPECT_EQ(stats->read_operations, expected_reads) << "Invalid number of reads";
+
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> actual;
+    EXPECT_EQ(wear_leveling_read(0, actual.data(), actual.size()), WEAR_LEVELING_SUCCESS) << "Failed to read";
+    EXPECT_TRUE(std::equal(actual.begin(), actual.end(), verify_data.begin())) << "Invalid readback";
+}
@@ -202,3 +202,38 @@ TEST_F(WearLevelingGeneral, WriteFailure_NoSubsequentWrites) {
     wear_leveling_read(0x04, &test_val, sizeof(test_val));
     EXPECT_EQ(test_val, 0x14) << "Readback should come from cache regardless of unlock failure";
 }
+
+/**
+ * This test verifies that an empty write log is detected with a single read of the log.
+ */
+TEST_F(WearLevelingGeneral, Playback_EmptyLogSingleRead) {
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+
+    auto stats = wear_leveling_get_init_stats();
+    EXPECT_EQ(stats->log_bytes, 0) << "No log should have been played back";
+    EXPECT_EQ(stats->read_operations, 3) << "Expected consolidated data, checksum, and one log read";
+}
+
+/**
+ * This test verifies that the write log is read in growing chunks, and played back correctly.
+ */
+TEST_F(WearLevelingGeneral, Playback_LogReadInChunks) {
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> expected{};
+    for (int i = 0; i < 6; ++i) {
+        expected[i * 2 + 1] = 0x30 + i;
+        EXPECT_EQ(wear_leveling_write(i * 2 + 1, &expected[i * 2 + 1], 1), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    }
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+
+    // Six OPTIMIZED_64 entries, read as 4 items then the remaining 8 items of the backing store
+    auto stats = wear_leveling_get_init_stats();
+    EXPECT_EQ(stats->log_bytes, 6 * BACKING_STORE_WRITE_SIZE) << "Invalid number of log bytes played back";
+    EXPECT_EQ(stats->read_operations, 4) << "Expected consolidated data, checksum, and two log reads";
+
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> actual;
+    EXPECT_EQ(wear_leveling_read(0, actual.data(), actual.size()), WEAR_LEVELING_SUCCESS) << "Failed to read";
+    for (int i = 0; i < WEAR_LEVELING_LOGICAL_SIZE; ++i) {
+        EXPECT_EQ(actual[i], expected[i]) << "Invalid readback";
+    }
+}
@@ -0,0 +1,210 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <numeric>
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "backing_mocks.hpp"
+
+extern "C" {
+#include "timer.h"
+
+void advance_time(uint32_t ms);
+}
+
+class WearLevelingWriteBack : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        wear_leveling_init();
+    }
+};
+
+static void expect_readback(const std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE>& expected) {
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> actual;
+    EXPECT_EQ(wear_leveling_read(0, actual.data(), actual.size()), WEAR_LEVELING_SUCCESS) << "Failed to read";
+    for (std::size_t i = 0; i < actual.size(); ++i) {
+        EXPECT_EQ(actual[i], expected[i]) << "Invalid readback at " << i;
+    }
+}
+
+/**
+ * This test verifies that writes are held back until flushed, while reads see the new data straight away.
+ */
+TEST_F(WearLevelingWriteBack, WritesHeldUntilFlush) {
+    auto&                                                inst = MockBackingStore::Instance();
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> expected{};
+
+    expected[0x50] = 0x12;
+    expected[0x51] = 0x34;
+    EXPECT_EQ(wear_leveling_write(0x50, &expected[0x50], 2), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    EXPECT_EQ(inst.unlock_invoke_count(), 0) << "Unlock should not have been invoked";
+    EXPECT_EQ(inst.write_invoke_count(), 0) << "Write should not have been invoked";
+    expect_readback(expected);
+
+    EXPECT_EQ(wear_leveling_flush(), WEAR_LEVELING_SUCCESS) << "Flush returned incorrect status";
+    EXPECT_EQ(inst.unlock_invoke_count(), 1) << "Unlock should have been invoked once";
+    EXPECT_EQ(inst.lock_invoke_count(), 1) << "Lock should have been invoked once";
+    EXPECT_EQ(inst.write_bulk_invoke_count(), 1) << "Flush should have been a single bulk write";
+    EXPECT_EQ(inst.write_invoke_count(), 3) << "A 2-byte multibyte entry should take 3 writes";
+
+    // Nothing left to flush
+    EXPECT_EQ(wear_leveling_flush(), WEAR_LEVELING_SUCCESS) << "Flush returned incorrect status";
+    EXPECT_EQ(inst.unlock_invoke_count(), 1) << "Unlock should not have been invoked again";
+
+    // The flushed data is played back after re-init
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    expect_readback(expected);
+}
+
+/**
+ * This test verifies that repeated writes to the same address only result in the latest value being logged.
+ */
+TEST_F(WearLevelingWriteBack, RepeatedWritesMerged) {
+    auto& inst = MockBackingStore::Instance();
+
+    for (uint8_t value = 1; value <= 50; ++value) {
+        EXPECT_EQ(wear_leveling_write(0x02, &value, sizeof(value)), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    }
+    EXPECT_EQ(wear_leveling_flush(), WEAR_LEVELING_SUCCESS) << "Flush returned incorrect status";
+
+    // Address<64, so a single OPTIMIZED_64 entry is expected
+    EXPECT_EQ(inst.write_invoke_count(), 1) << "Only the latest value should have been written";
+    auto entry = LOG_ENTRY_MAKE_OPTIMIZED_64(0x02, 50);
+    EXPECT_EQ(inst.log_begin()->value, entry.raw16[0]) << "Invalid log entry";
+}
+
+/**
+ * This test verifies that single-byte writes to adjacent addresses are logged as a single multibyte entry.
+ */
+TEST_F(WearLevelingWriteBack, AdjacentWritesMerged) {
+    auto&                                                inst = MockBackingStore::Instance();
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> expected{};
+
+    for (uint32_t address = 0x44; address > 0x40; --address) {
+        expected[address] = address;
+        EXPECT_EQ(wear_leveling_write(address, &expected[address], 1), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    }
+    expected[0x45] = 0x45;
+    EXPECT_EQ(wear_leveling_write(0x45, &expected[0x45], 1), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    EXPECT_EQ(wear_leveling_flush(), WEAR_LEVELING_SUCCESS) << "Flush returned incorrect status";
+
+    // One 5-byte multibyte entry
+    EXPECT_EQ(inst.write_invoke_count(), 4) << "Adjacent writes should have been logged as one entry";
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    expect_readback(expected);
+}
+
+/**
+ * This test verifies that running out of ranges flushes what was held back, and keeps the new write held.
+ */
+TEST_F(WearLevelingWriteBack, RangesExhaustedForcesFlush) {
+    auto&                                                inst = MockBackingStore::Instance();
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> expected{};
+
+    for (int i = 0; i < WEAR_LEVELING_WRITE_BACK_RANGES; ++i) {
+        expected[i * 2] = 0x80 + i;
+        EXPECT_EQ(wear_leveling_write(i * 2, &expected[i * 2], 1), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    }
+    EXPECT_EQ(inst.write_invoke_count(), 0) << "Write should not have been invoked";
+
+    expected[0x30] = 0x30;
+    EXPECT_EQ(wear_leveling_write(0x30, &expected[0x30], 1), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    EXPECT_EQ(inst.write_bulk_invoke_count(), 1) << "Held back ranges should have been flushed";
+    EXPECT_EQ(inst.write_invoke_count(), WEAR_LEVELING_WRITE_BACK_RANGES) << "Only the held back ranges should have been written";
+
+    EXPECT_EQ(wear_leveling_flush(), WEAR_LEVELING_SUCCESS) << "Flush returned incorrect status";
+    EXPECT_EQ(inst.write_invoke_count(), WEAR_LEVELING_WRITE_BACK_RANGES + 1) << "The last write should have been flushed";
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    expect_readback(expected);
+}
+
+/**
+ * This test verifies that log entries which don't fit in the buffer are written out in multiple bulk writes.
+ */
+TEST_F(WearLevelingWriteBack, LargeRangeSplitsBulkWrites) {
+    auto&                                                inst = MockBackingStore::Instance();
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> expected{};
+
+    std::iota(expected.begin() + 0x40, expected.begin() + 0x54, 0x20);
+    EXPECT_EQ(wear_leveling_write(0x40, &expected[0x40], 0x14), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    EXPECT_EQ(wear_leveling_flush(), WEAR_LEVELING_SUCCESS) << "Flush returned incorrect status";
+
+    // Four 5-byte multibyte entries of 4 writes each, with the buffer holding 8 writes
+    EXPECT_EQ(inst.write_invoke_count(), 16) << "Invalid number of writes";
+    EXPECT_EQ(inst.write_bulk_invoke_count(), 16 / (WEAR_LEVELING_WRITE_BACK_BUFFER_SIZE / BACKING_STORE_WRITE_SIZE)) << "Invalid number of bulk writes";
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    expect_readback(expected);
+}
+
+/**
+ * This test verifies that the task only flushes once writes have been idle for the timeout.
+ */
+TEST_F(WearLevelingWriteBack, TaskFlushesAfterIdleTimeout) {
+    auto&   inst  = MockBackingStore::Instance();
+    uint8_t value = 0x11;
+
+    EXPECT_EQ(wear_leveling_write(0x02, &value, sizeof(value)), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    advance_time(WEAR_LEVELING_WRITE_BACK_TIMEOUT - 1);
+    wear_leveling_task();
+    EXPECT_EQ(inst.write_invoke_count(), 0) << "Task should not have flushed before the timeout";
+
+    // Another write restarts the timeout
+    value = 0x22;
+    EXPECT_EQ(wear_leveling_write(0x02, &value, sizeof(value)), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    advance_time(1);
+    wear_leveling_task();
+    EXPECT_EQ(inst.write_invoke_count(), 0) << "Task should not have flushed before the timeout";
+
+    advance_time(WEAR_LEVELING_WRITE_BACK_TIMEOUT - 1);
+    wear_leveling_task();
+    EXPECT_EQ(inst.write_invoke_count(), 1) << "Task should have flushed after the timeout";
+
+    advance_time(WEAR_LEVELING_WRITE_BACK_TIMEOUT);
+    wear_leveling_task();
+    EXPECT_EQ(inst.write_invoke_count(), 1) << "Task should not flush when nothing is held back";
+}
+
+/**
+ * This test verifies that a flush which fills the write log consolidates, covering all held back data.
+ */
+TEST_F(WearLevelingWriteBack, FlushConsolidatesWhenLogFull) {
+    auto&                                                inst = MockBackingStore::Instance();
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> expected;
+
+    std::iota(expected.begin(), expected.end(), 0x20);
+    EXPECT_EQ(wear_leveling_write(0, expected.data(), expected.size()), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    EXPECT_EQ(wear_leveling_flush(), WEAR_LEVELING_SUCCESS) << "Flush returned incorrect status";
+    EXPECT_EQ(inst.erase_invoke_count(), 0) << "Erase should not have been invoked";
+
+    std::iota(expected.begin(), expected.end(), 0x40);
+    EXPECT_EQ(wear_leveling_write(0, expected.data(), expected.size()), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    EXPECT_EQ(wear_leveling_flush(), WEAR_LEVELING_CONSOLIDATED) << "Flush returned incorrect status";
+    EXPECT_EQ(inst.erase_invoke_count(), 1) << "Erase should have been invoked once";
+
+    // Nothing is left held back after consolidation
+    std::uint64_t write_count = inst.write_invoke_count();
+    EXPECT_EQ(wear_leveling_flush(), WEAR_LEVELING_SUCCESS) << "Flush returned incorrect status";
+    EXPECT_EQ(inst.write_invoke_count(), write_count) << "Write should not have been invoked";
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    expect_readback(expected);
+}
+
+/**
+ * This test verifies that erasing drops any held back writes.
+ */
+TEST_F(WearLevelingWriteBack, EraseDropsHeldWrites) {
+    auto&   inst  = MockBackingStore::Instance();
+    uint8_t value = 0x11;
+
+    EXPECT_EQ(wear_leveling_write(0x02, &value, sizeof(value)), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    EXPECT_EQ(wear_leveling_erase(), WEAR_LEVELING_SUCCESS) << "Erase returned incorrect status";
+    EXPECT_EQ(wear_leveling_flush(), WEAR_LEVELING_SUCCESS) << "Flush returned incorrect status";
+    EXPECT_EQ(inst.write_invoke_count(), 0) << "Write should not have been invoked";
+
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> expected{};
+    expect_readback(expected);
+}
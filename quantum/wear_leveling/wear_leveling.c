@@ -4,6 +4,7 @@
 #include "fnv.h"
 #include "wear_leveling.h"
 #include "wear_leveling_internal.h"
+#include "timer.h"
 
 /*
     This wear leveling algorithm is adapted from algorithms from previous
@@ -61,12 +62,19 @@
             to other subsystems performing reads/writes. This must be a multiple
             of the write size.
 
+        - WEAR_LEVELING_WRITE_BACK_ENABLE: Holds writes back in RAM, merging
+            writes to the same or adjacent logical addresses, until they are
+            flushed -- see "During flushes" below.
+
     General algorithm:
 
         During initialization:
             * The contents of the consolidated data section are read into cache.
             * The contents of the write log are "played back" and update the
-                cache accordingly.
+                cache accordingly. The log is read in bulk, starting with a
+                single entry's worth and doubling each time up to
+                WEAR_LEVELING_PLAYBACK_CHUNK_SIZE, so that short logs aren't
+                over-read and long logs take few backing store reads.
 
         During reads:
             * Logical data is served from the cache.
@@ -75,6 +83,16 @@
             * The cache is updated with the new data.
             * A new write log entry is appended to the log.
             * If the log's full, data is consolidated and the write log cleared.
+            * With write-back enabled, the cache is updated and the written
+                range recorded instead, merged with any range it touches.
+
+        During flushes (write-back only, after an idle timeout, on suspend,
+        or before shutdown):
+            * Each recorded range is encoded into write log entries from the
+                cache, which are gathered in RAM and appended to the log in as
+                few bulk writes as the buffer allows.
+            * If the log fills up, data is consolidated and the write log
+                cleared, which also covers every recorded range.
 
     Write log structure:
 
@@ -164,6 +182,43 @@ static struct __attribute__((__aligned__(BACKING_STORE_WRITE_SIZE))) {
     bool                                                           unlocked;
 } wear_leveling;
 
+/**
+ * Measurements taken during initialization.
+ */
+static wear_leveling_init_stats_t init_stats;
+
+/**
+ * Sequential reader used to stream the write log from the backing store during playback.
+ */
+typedef struct wear_leveling_log_reader_t {
+    backing_store_int_t buffer[(WEAR_LEVELING_PLAYBACK_CHUNK_SIZE) / (BACKING_STORE_WRITE_SIZE)];
+    uint32_t            address;    // backing store address of buffer[0]
+    size_t              count;      // number of items currently held in the buffer
+    size_t              next_count; // number of items to request on the next refill
+} wear_leveling_log_reader_t;
+
+#ifdef WEAR_LEVELING_WRITE_BACK_ENABLE
+/**
+ * Logical address range which has been updated in the cache, but not yet written to the log.
+ */
+typedef struct wear_leveling_range_t {
+    uint32_t start;
+    uint32_t end;
+} wear_leveling_range_t;
+
+/**
+ * Storage area for the write-back buffer.
+ */
+static struct {
+    wear_leveling_range_t dirty[(WEAR_LEVELING_WRITE_BACK_RANGES)];
+    uint8_t               dirty_count;
+    uint32_t              last_write;
+    backing_store_int_t   staged[(WEAR_LEVELING_WRITE_BACK_BUFFER_SIZE) / (BACKING_STORE_WRITE_SIZE)];
+    uint32_t              staged_address;
+    size_t                staged_count;
+} write_back;
+#endif // WEAR_LEVELING_WRITE_BACK_ENABLE
+
 /**
  * Locking helper: status
  */
@@ -203,8 +258,59 @@ static inline backing_store_lock_status_t wear_leveling_lock(void) {
 static void wear_leveling_clear_cache(void) {
     memset(wear_leveling.cache, 0, (WEAR_LEVELING_LOGICAL_SIZE));
     wear_leveling.write_address = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 is due to the FNV1a_64 of the consolidated buffer
+#ifdef WEAR_LEVELING_WRITE_BACK_ENABLE
+    write_back.dirty_count  = 0;
+    write_back.staged_count = 0;
+#endif // WEAR_LEVELING_WRITE_BACK_ENABLE
+}
+
+#ifdef WEAR_LEVELING_WRITE_BACK_ENABLE
+/**
+ * Records a logical address range as needing to be written to the log, merging it with any overlapping or adjacent ranges.
+ *
+ * @return false if there is no space left to record the range
+ */
+static bool wear_leveling_mark_dirty(uint32_t start, uint32_t end) {
+    for (uint8_t i = 0; i < write_back.dirty_count;) {
+        wear_leveling_range_t *range = &write_back.dirty[i];
+        if (start <= range->end && end >= range->start) {
+            // Absorb the existing range, then check again as the merged range may now touch others
+            start  = start < range->start ? start : range->start;
+            end    = end > range->end ? end : range->end;
+            *range = write_back.dirty[--write_back.dirty_count];
+        } else {
+            ++i;
+        }
+    }
+
+    if (write_back.dirty_count >= (WEAR_LEVELING_WRITE_BACK_RANGES)) {
+        return false;
+    }
+
+    write_back.dirty[write_back.dirty_count].start = start;
+    write_back.dirty[write_back.dirty_count].end   = end;
+    ++write_back.dirty_count;
+    return true;
 }
 
+/**
+ * Writes the gathered write log entries to the backing store in a single bulk operation.
+ */
+static wear_leveling_status_t wear_leveling_write_staged(void) {
+    if (write_back.staged_count == 0) {
+        return WEAR_LEVELING_SUCCESS;
+    }
+
+    bool ok                 = backing_store_write_bulk(write_back.staged_address, write_back.staged, write_back.staged_count);
+    write_back.staged_count = 0;
+    if (!ok) {
+        wl_dprintf("Failed to write to backing store\n");
+        return WEAR_LEVELING_FAILED;
+    }
+    return WEAR_LEVELING_SUCCESS;
+}
+#endif // WEAR_LEVELING_WRITE_BACK_ENABLE
+
 /**
  * Reads the consolidated data from the backing store into the cache.
  * Does not consider the write log.
@@ -213,6 +319,7 @@ static wear_leveling_status_t wear_leveling_read_consolidated(void) {
     wl_dprintf("Reading consolidated data\n");
 
     wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+    ++init_stats.read_operations;
     if (!backing_store_read_bulk(0, (backing_store_int_t *)wear_leveling.cache, sizeof(wear_leveling.cache) / sizeof(backing_store_int_t))) {
         wl_dprintf("Failed to read from backing store\n");
         status = WEAR_LEVELING_FAILED;
@@ -223,6 +330,7 @@ static wear_leveling_status_t wear_leveling_read_consolidated(void) {
         uint64_t          expected = fnv_64a_buf(wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE), FNV1A_64_INIT);
         write_log_entry_t entry;
         wl_dprintf("Reading checksum\n");
+        ++init_stats.read_operations;
 #if BACKING_STORE_WRITE_SIZE == 2
         backing_store_read_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw16, 4);
 #elif BACKING_STORE_WRITE_SIZE == 4
@@ -318,6 +426,12 @@ static wear_leveling_status_t wear_leveling_consolidate_force(void) {
     // Next write of the log occurs after the consolidated values at the start of the backing store.
     wear_leveling.write_address = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 due to the FNV1a_64 of the consolidated area
 
+#ifdef WEAR_LEVELING_WRITE_BACK_ENABLE
+    // The cache has been written in full, so anything held back or gathered is now redundant.
+    write_back.dirty_count  = 0;
+    write_back.staged_count = 0;
+#endif // WEAR_LEVELING_WRITE_BACK_ENABLE
+
     return status;
 }
 
@@ -342,11 +456,24 @@ static wear_leveling_status_t wear_leveling_consolidate_if_needed(void) {
  * @return true if consolidation occurred
  */
 static wear_leveling_status_t wear_leveling_append_raw(backing_store_int_t value) {
+#ifdef WEAR_LEVELING_WRITE_BACK_ENABLE
+    // Gather the entry, written out alongside its neighbours once the buffer fills or the flush completes
+    if (write_back.staged_count >= sizeof(write_back.staged) / sizeof(backing_store_int_t)) {
+        if (wear_leveling_write_staged() == WEAR_LEVELING_FAILED) {
+            return WEAR_LEVELING_FAILED;
+        }
+    }
+    if (write_back.staged_count == 0) {
+        write_back.staged_address = wear_leveling.write_address;
+    }
+    write_back.staged[write_back.staged_count++] = value;
+#else
     bool ok = backing_store_write(wear_leveling.write_address, value);
     if (!ok) {
         wl_dprintf("Failed to write to backing store\n");
         return WEAR_LEVELING_FAILED;
     }
+#endif // WEAR_LEVELING_WRITE_BACK_ENABLE
     wear_leveling.write_address += (BACKING_STORE_WRITE_SIZE);
     return wear_leveling_consolidate_if_needed();
 }
@@ -469,6 +596,41 @@ static wear_leveling_status_t wear_leveling_write_raw(uint32_t address, const vo
     return status;
 }
 
+/**
+ * Reads a single item of the write log, refilling the reader's buffer from the backing store when needed.
+ */
+static bool wear_leveling_log_read(wear_leveling_log_reader_t *reader, uint32_t address, backing_store_int_t *value) {
+    if (address < reader->address || address >= reader->address + reader->count * (BACKING_STORE_WRITE_SIZE)) {
+        if (address >= (WEAR_LEVELING_BACKING_SIZE)) {
+            wl_dprintf("Write log entry runs past the end of the backing store\n");
+            return false;
+        }
+
+        size_t count     = reader->next_count;
+        size_t remaining = ((WEAR_LEVELING_BACKING_SIZE) - address) / (BACKING_STORE_WRITE_SIZE);
+        if (count > remaining) {
+            count = remaining;
+        }
+
+        ++init_stats.read_operations;
+        if (!backing_store_read_bulk(address, reader->buffer, count)) {
+            reader->count = 0;
+            return false;
+        }
+        reader->address = address;
+        reader->count   = count;
+
+        // Grow the next read, the further into the log we are the more likely there's plenty more of it
+        reader->next_count *= 2;
+        if (reader->next_count > sizeof(reader->buffer) / sizeof(backing_store_int_t)) {
+            reader->next_count = sizeof(reader->buffer) / sizeof(backing_store_int_t);
+        }
+    }
+
+    *value = reader->buffer[(address - reader->address) / (BACKING_STORE_WRITE_SIZE)];
+    return true;
+}
+
 /**
  * "Replays" the write log from the backing store, updating the local cache with updated values.
  */
@@ -478,9 +640,13 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
     wear_leveling_status_t status          = WEAR_LEVELING_SUCCESS;
     bool                   cancel_playback = false;
     uint32_t               address         = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 due to the FNV1a_64 of the consolidated area
+
+    // Start off reading a single multi-byte entry's worth of the log
+    wear_leveling_log_reader_t reader = {.address = address, .count = 0, .next_count = 8 / (BACKING_STORE_WRITE_SIZE)};
+
     while (!cancel_playback && address < (WEAR_LEVELING_BACKING_SIZE)) {
         backing_store_int_t value;
-        bool                ok = backing_store_read(address, &value);
+        bool                ok = wear_leveling_log_read(&reader, address, &value);
         if (!ok) {
             wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
             cancel_playback = true;
@@ -509,7 +675,7 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
         switch (LOG_ENTRY_GET_TYPE(log)) {
             case LOG_ENTRY_TYPE_MULTIBYTE: {
 #if BACKING_STORE_WRITE_SIZE == 2
-                ok = backing_store_read(address, &log.raw16[1]);
+                ok = wear_leveling_log_read(&reader, address, &log.raw16[1]);
                 if (!ok) {
                     wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
                     cancel_playback = true;
@@ -529,7 +695,7 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
 
 #if BACKING_STORE_WRITE_SIZE == 2
                 if (l > 1) {
-                    ok = backing_store_read(address, &log.raw16[2]);
+                    ok = wear_leveling_log_read(&reader, address, &log.raw16[2]);
                     if (!ok) {
                         wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
                         cancel_playback = true;
@@ -539,7 +705,7 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
                     address += (BACKING_STORE_WRITE_SIZE);
                 }
                 if (l > 3) {
-                    ok = backing_store_read(address, &log.raw16[3]);
+                    ok = wear_leveling_log_read(&reader, address, &log.raw16[3]);
                     if (!ok) {
                         wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
                         cancel_playback = true;
@@ -550,7 +716,7 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
                 }
 #elif BACKING_STORE_WRITE_SIZE == 4
                 if (l > 1) {
-                    ok = backing_store_read(address, &log.raw32[1]);
+                    ok = wear_leveling_log_read(&reader, address, &log.raw32[1]);
                     if (!ok) {
                         wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
                         cancel_playback = true;
@@ -599,6 +765,7 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
 
     // We've reached the end of the log, so we're at the new write location
     wear_leveling.write_address = address;
+    init_stats.log_bytes        = address - ((WEAR_LEVELING_LOGICAL_SIZE) + 8);
 
     if (status == WEAR_LEVELING_FAILED) {
         // If we had a failure during readback, assume we're corrupted -- force a consolidation with the data we already have
@@ -611,14 +778,28 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
     return status;
 }
 
+/**
+ * Loads the consolidated data and plays back the write log, leaving the "live" values in the cache.
+ */
+static wear_leveling_status_t wear_leveling_load(void) {
+    // Read the previous consolidated values, then replay the existing write log so that the cache has the "live" values
+    wear_leveling_status_t status = wear_leveling_read_consolidated();
+    if (status == WEAR_LEVELING_FAILED) {
+        return status;
+    }
+
+    return wear_leveling_playback_log();
+}
+
 /**
  * Wear-leveling initialization
  */
 wear_leveling_status_t wear_leveling_init(void) {
     wl_dprintf("Init\n");
 
-    // Reset the cache
+    // Reset the cache and measurements
     wear_leveling_clear_cache();
+    memset(&init_stats, 0, sizeof(init_stats));
 
     // Initialise the backing store
     if (!backing_store_init()) {
@@ -627,15 +808,11 @@ wear_leveling_status_t wear_leveling_init(void) {
         return WEAR_LEVELING_FAILED;
     }
 
-    // Read the previous consolidated values, then replay the existing write log so that the cache has the "live" values
-    wear_leveling_status_t status = wear_leveling_read_consolidated();
-    if (status == WEAR_LEVELING_FAILED) {
-        // If it failed, clear the cache and return with failure
-        wear_leveling_clear_cache();
-        return status;
-    }
+    uint32_t               start  = timer_read32();
+    wear_leveling_status_t status = wear_leveling_load();
+    init_stats.duration_ms        = timer_elapsed32(start);
+    wl_dprintf("Init took %ldms, %ld log bytes played back in %ld reads\n", (long)init_stats.duration_ms, (long)init_stats.log_bytes, (long)init_stats.read_operations);
 
-    status = wear_leveling_playback_log();
     if (status == WEAR_LEVELING_FAILED) {
         // If it failed, clear the cache and return with failure
         wear_leveling_clear_cache();
@@ -645,6 +822,13 @@ wear_leveling_status_t wear_leveling_init(void) {
     return status;
 }
 
+/**
+ * Retrieves the measurements taken during initialization.
+ */
+const wear_leveling_init_stats_t *wear_leveling_get_init_stats(void) {
+    return &init_stats;
+}
+
 /**
  * Wear-leveling erase.
  * Post-condition: any reads from the backing store directly after an erase operation must come back as zero.
@@ -688,6 +872,21 @@ wear_leveling_status_t wear_leveling_write(const uint32_t address, const void *v
         return true;
     }
 
+#ifdef WEAR_LEVELING_WRITE_BACK_ENABLE
+    // Hold the write back, recording the range so that it's written to the log on the next flush
+    wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+    if (!wear_leveling_mark_dirty(address, address + length)) {
+        // Out of space to record ranges, so flush everything held so far to make room
+        status = wear_leveling_flush();
+        if (status == WEAR_LEVELING_FAILED) {
+            return status;
+        }
+        wear_leveling_mark_dirty(address, address + length);
+    }
+    memcpy(&wear_leveling.cache[address], value, length);
+    write_back.last_write = timer_read32();
+    return status;
+#else
     // Update the cache before writing to the backing store -- if we hit the end of the backing store during writes to the log then we'll force a consolidation in-line
     memcpy(&wear_leveling.cache[address], value, length);
 
@@ -724,6 +923,66 @@ wear_leveling_status_t wear_leveling_write(const uint32_t address, const void *v
     }
 
     return status;
+#endif // WEAR_LEVELING_WRITE_BACK_ENABLE
+}
+
+/**
+ * Writes held back logical data into the write log section of the backing store.
+ */
+wear_leveling_status_t wear_leveling_flush(void) {
+#ifdef WEAR_LEVELING_WRITE_BACK_ENABLE
+    if (write_back.dirty_count == 0) {
+        return WEAR_LEVELING_SUCCESS;
+    }
+
+    wl_dprintf("Flush\n");
+
+    // Unlock the backing store
+    backing_store_lock_status_t lock_status = wear_leveling_unlock();
+    if (lock_status == STATUS_FAILURE) {
+        wear_leveling_lock();
+        return WEAR_LEVELING_FAILED;
+    }
+
+    // Log each range from the cache, which already holds the latest values
+    wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+    for (uint8_t i = 0; i < write_back.dirty_count && status == WEAR_LEVELING_SUCCESS; ++i) {
+        const wear_leveling_range_t *range = &write_back.dirty[i];
+        wl_dprintf("Write ");
+        wl_dump(range->start, &wear_leveling.cache[range->start], range->end - range->start);
+        status = wear_leveling_write_raw(range->start, &wear_leveling.cache[range->start], range->end - range->start);
+    }
+
+    // If consolidation occurred, then the cache has already been written to the consolidated area and there's nothing left to write.
+    if (status == WEAR_LEVELING_SUCCESS) {
+        status = wear_leveling_write_staged();
+    }
+
+    // Failed writes are not retried, matching the behaviour without write-back
+    write_back.dirty_count  = 0;
+    write_back.staged_count = 0;
+
+    if (lock_status == STATUS_SUCCESS) {
+        if (wear_leveling_lock() == STATUS_FAILURE) {
+            status = WEAR_LEVELING_FAILED;
+        }
+    }
+
+    return status;
+#else
+    return WEAR_LEVELING_SUCCESS;
+#endif // WEAR_LEVELING_WRITE_BACK_ENABLE
+}
+
+/**
+ * Flushes held back logical data once writes have been idle for long enough.
+ */
+void wear_leveling_task(void) {
+#ifdef WEAR_LEVELING_WRITE_BACK_ENABLE
+    if (write_back.dirty_count > 0 && timer_elapsed32(write_back.last_write) >= (WEAR_LEVELING_WRITE_BACK_TIMEOUT)) {
+        wear_leveling_flush();
+    }
+#endif // WEAR_LEVELING_WRITE_BACK_ENABLE
 }
 
 /**
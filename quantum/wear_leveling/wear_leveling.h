@@ -13,6 +13,15 @@ typedef enum wear_leveling_status_t {
     WEAR_LEVELING_CONSOLIDATED //< Invocation succeeded, consolidation occurred
 } wear_leveling_status_t;
 
+/**
+ * @typedef Measurements taken during the most recent wear_leveling_init().
+ */
+typedef struct wear_leveling_init_stats_t {
+    uint32_t duration_ms;     //< Time taken to load the consolidated data and play back the write log
+    uint32_t log_bytes;       //< Number of bytes of write log played back
+    uint32_t read_operations; //< Number of reads requested from the backing store
+} wear_leveling_init_stats_t;
+
 /**
  * Wear-leveling initialization
  *
@@ -20,6 +29,16 @@ typedef enum wear_leveling_status_t {
  */
 wear_leveling_status_t wear_leveling_init(void);
 
+/**
+ * Retrieves the measurements taken during the most recent wear-leveling initialization.
+ *
+ * Initialization occurs before the console is available, so these can be printed later on, such as from
+ * keyboard_post_init_user().
+ *
+ * @return Pointer to the measurements
+ */
+const wear_leveling_init_stats_t* wear_leveling_get_init_stats(void);
+
 /**
  * Wear-leveling erasure.
  *
@@ -36,6 +55,9 @@ wear_leveling_status_t wear_leveling_erase(void);
  * determine if an overwrite should occur -- if there is any data mismatch the entire block will be written to the log,
  * not just the changed bytes.
  *
+ * If WEAR_LEVELING_WRITE_BACK_ENABLE is defined, the written range is only held in RAM, merged with other held back
+ * ranges, and written to the log by wear_leveling_flush() or wear_leveling_task().
+ *
  * @param address[in] the logical address to write data
  * @param value[in] pointer to the source buffer
  * @param length[in] length of the data
@@ -52,3 +74,20 @@ wear_leveling_status_t wear_leveling_write(uint32_t address, const void* value,
  * @return Status of the request
  */
 wear_leveling_status_t wear_leveling_read(uint32_t address, void* value, size_t length);
+
+/**
+ * Writes any data held back by the write-back buffer into the backing store.
+ *
+ * Does nothing unless WEAR_LEVELING_WRITE_BACK_ENABLE is defined. Needs to be invoked before power is removed, otherwise
+ * held back writes are lost.
+ *
+ * @return Status of the request
+ */
+wear_leveling_status_t wear_leveling_flush(void);
+
+/**
+ * Flushes held back data once no writes have occurred for WEAR_LEVELING_WRITE_BACK_TIMEOUT milliseconds.
+ *
+ * Does nothing unless WEAR_LEVELING_WRITE_BACK_ENABLE is defined.
+ */
+void wear_leveling_task(void);
@@ -27,6 +27,26 @@ typedef uint64_t backing_store_int_t;
 #    error WEAR_LEVELING_LOGICAL_SIZE was not set.
 #endif
 
+// Largest number of bytes of the write log read in one go during playback
+#ifndef WEAR_LEVELING_PLAYBACK_CHUNK_SIZE
+#    define WEAR_LEVELING_PLAYBACK_CHUNK_SIZE 128
+#endif
+
+#ifdef WEAR_LEVELING_WRITE_BACK_ENABLE
+// Number of separate logical address ranges held back before a flush is forced
+#    ifndef WEAR_LEVELING_WRITE_BACK_RANGES
+#        define WEAR_LEVELING_WRITE_BACK_RANGES 8
+#    endif
+// Number of bytes of write log entries gathered before they're written out together
+#    ifndef WEAR_LEVELING_WRITE_BACK_BUFFER_SIZE
+#        define WEAR_LEVELING_WRITE_BACK_BUFFER_SIZE 64
+#    endif
+// Time in milliseconds without writes before held back data is flushed
+#    ifndef WEAR_LEVELING_WRITE_BACK_TIMEOUT
+#        define WEAR_LEVELING_WRITE_BACK_TIMEOUT 1000
+#    endif
+#endif // WEAR_LEVELING_WRITE_BACK_ENABLE
+
 #ifdef WEAR_LEVELING_DEBUG_OUTPUT
 #    include <debug.h>
 #    define bs_dprintf(...) dprintf("Backing store: " __VA_ARGS__)
@@ -65,6 +85,13 @@ typedef uint64_t backing_store_int_t;
 _Static_assert(WEAR_LEVELING_BACKING_SIZE >= (WEAR_LEVELING_LOGICAL_SIZE * 2), "Total backing size must be at least twice the size of the logical size");
 _Static_assert(WEAR_LEVELING_LOGICAL_SIZE % BACKING_STORE_WRITE_SIZE == 0, "Logical size must be a multiple of write size");
 _Static_assert(WEAR_LEVELING_BACKING_SIZE % WEAR_LEVELING_LOGICAL_SIZE == 0, "Backing size must be a multiple of logical size");
+_Static_assert(WEAR_LEVELING_PLAYBACK_CHUNK_SIZE % BACKING_STORE_WRITE_SIZE == 0, "Playback chunk size must be a multiple of write size");
+_Static_assert(WEAR_LEVELING_PLAYBACK_CHUNK_SIZE >= 8, "Playback chunk size must fit at least one write log entry");
+#ifdef WEAR_LEVELING_WRITE_BACK_ENABLE
+_Static_assert(WEAR_LEVELING_WRITE_BACK_RANGES > 0 && WEAR_LEVELING_WRITE_BACK_RANGES <= 255, "Write-back range count must be between 1 and 255");
+_Static_assert(WEAR_LEVELING_WRITE_BACK_BUFFER_SIZE % BACKING_STORE_WRITE_SIZE == 0, "Write-back buffer size must be a multiple of write size");
+_Static_assert(WEAR_LEVELING_WRITE_BACK_BUFFER_SIZE >= 8, "Write-back buffer size must fit at least one write log entry");
+#endif // WEAR_LEVELING_WRITE_BACK_ENABLE
 
 // Backing Store API, to be implemented elsewhere by flash driver etc.
 bool backing_store_init(void);
@@ -68,3 +68,26 @@ TEST_F(AutoShift, key_release_after_timeout) {
     run_one_scan_loop();
     VERIFY_AND_CLEAR(driver);
 }
+
+TEST_F(AutoShift, key_release_before_timeout_but_processed_late) {
+    TestDriver driver;
+    InSequence s;
+    auto       regular_key = KeymapKey(0, 2, 0, KC_A);
+
+    set_keymap({regular_key});
+
+    // The key was released before the timeout when the matrix was scanned,
+    // but processing was held up until after it
+    const uint16_t scanned = timer_read();
+
+    EXPECT_NO_REPORT(driver);
+    action_exec(key_event_at(regular_key, true, scanned));
+    VERIFY_AND_CLEAR(driver);
+
+    advance_time(AUTO_SHIFT_TIMEOUT * 2);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    action_exec(key_event_at(regular_key, false, scanned + AUTO_SHIFT_TIMEOUT / 2));
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,137 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <iostream>
+
+#include "keyboard_report_util.hpp"
+#include "quantum.h"
+#include "keycode.h"
+#include "test_common.h"
+#include "test_driver.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::AnyNumber;
+using testing::InSequence;
+
+extern "C" {
+#define BENCHMARK_COMBO_COUNT 320
+
+extern combo_t key_combos[BENCHMARK_COMBO_COUNT];
+void           setup_benchmark_combos(void);
+
+static uint16_t active_combo_count = BENCHMARK_COMBO_COUNT;
+static uint32_t combo_get_calls    = 0;
+
+uint16_t combo_count(void) {
+    return active_combo_count;
+}
+
+combo_t* combo_get(uint16_t combo_idx) {
+    combo_get_calls++;
+    return &key_combos[combo_idx];
+}
+}
+
+class ComboIndex : public TestFixture {
+   public:
+    void SetUp() override {
+        setup_benchmark_combos();
+        active_combo_count = BENCHMARK_COMBO_COUNT;
+        combo_index_invalidate();
+    }
+};
+
+TEST_F(ComboIndex, first_and_last_combo_fire) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    KeymapKey  key_b(0, 1, 0, KC_B);
+    KeymapKey  key_j(0, 2, 0, KC_J);
+    KeymapKey  key_k(0, 3, 0, KC_K);
+    set_keymap({key_a, key_b, key_j, key_k});
+
+    EXPECT_REPORT(driver, (KC_C));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_a, key_b});
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_L));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_j, key_k});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ComboIndex, partial_combo_and_other_keys_are_sent) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    KeymapKey  key_e(0, 1, 0, KC_E);
+    set_keymap({key_a, key_e});
+
+    EXPECT_REPORT(driver, (KC_E));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_e);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_a);
+    idle_for(COMBO_TERM);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ComboIndex, combo_after_changing_combo_count) {
+    TestDriver driver;
+    KeymapKey  key_j(0, 0, 0, KC_J);
+    KeymapKey  key_k(0, 1, 0, KC_K);
+    set_keymap({key_j, key_k});
+
+    // J + K is the last combo, it no longer exists once the count is lowered
+    active_combo_count = BENCHMARK_COMBO_COUNT - 1;
+    combo_index_invalidate();
+
+    EXPECT_REPORT(driver, (KC_J));
+    EXPECT_REPORT(driver, (KC_J, KC_K));
+    EXPECT_REPORT(driver, (KC_K));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_j, key_k});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ComboIndex, benchmark_per_event_cost_is_flat) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    KeymapKey  key_b(0, 1, 0, KC_B);
+    KeymapKey  key_e(0, 2, 0, KC_E);
+    set_keymap({key_a, key_b, key_e});
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+
+    const uint16_t counts[]      = {10, 40, 160, BENCHMARK_COMBO_COUNT};
+    const int      events        = 500;
+    uint32_t       baseline_gets = 0;
+
+    for (uint16_t count : counts) {
+        active_combo_count = count;
+        combo_index_invalidate();
+        // Builds the index, and resets the state of all combos once
+        tap_key(key_e);
+
+        combo_get_calls = 0;
+        auto start      = std::chrono::steady_clock::now();
+        for (int i = 0; i < events; i++) {
+            tap_combo({key_a, key_b});
+            tap_key(key_e);
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+        std::cout << "combos: " << count << ", combo_get() calls per event: " << combo_get_calls / (events * 6.0) << ", ns per event: " << elapsed.count() / (events * 6) << std::endl;
+
+        if (baseline_gets == 0) {
+            baseline_gets = combo_get_calls;
+        }
+        EXPECT_EQ(combo_get_calls, baseline_gets) << "with " << count << " combos";
+    }
+    VERIFY_AND_CLEAR(driver);
+}
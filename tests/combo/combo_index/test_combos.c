@@ -0,0 +1,29 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "quantum.h"
+
+#define BENCHMARK_COMBO_COUNT 320
+
+/* The first combo is A + B, the last one J + K. All other combos are made of
+ * keys that are never pressed, so the candidates for A, B, J and K stay the
+ * same however many combos are defined. */
+static uint16_t combo_keys[BENCHMARK_COMBO_COUNT][3];
+
+combo_t key_combos[BENCHMARK_COMBO_COUNT];
+
+void setup_benchmark_combos(void) {
+    for (uint16_t i = 0; i < BENCHMARK_COMBO_COUNT; ++i) {
+        combo_keys[i][0] = QK_UNICODE + 2 * i;
+        combo_keys[i][1] = QK_UNICODE + 2 * i + 1;
+        combo_keys[i][2] = COMBO_END;
+        key_combos[i]    = (combo_t)COMBO(combo_keys[i], KC_D);
+    }
+
+    combo_keys[0][0] = KC_A;
+    combo_keys[0][1] = KC_B;
+    key_combos[0]    = (combo_t)COMBO(combo_keys[0], KC_C);
+
+    combo_keys[BENCHMARK_COMBO_COUNT - 1][0] = KC_J;
+    combo_keys[BENCHMARK_COMBO_COUNT - 1][1] = KC_K;
+    key_combos[BENCHMARK_COMBO_COUNT - 1]    = (combo_t)COMBO(combo_keys[BENCHMARK_COMBO_COUNT - 1], KC_L);
+}
@@ -55,3 +55,24 @@ TEST_F(Combo, combo_osmshift_tapped) {
     tap_key(key_i);
     VERIFY_AND_CLEAR(driver);
 }
+
+TEST_F(Combo, combo_modtest_tapped_but_processed_late) {
+    TestDriver driver;
+    KeymapKey  key_y(0, 0, 1, KC_Y);
+    KeymapKey  key_u(0, 0, 2, KC_U);
+    set_keymap({key_y, key_u});
+
+    // The combo was tapped within both the combo and tapping terms when the
+    // matrix was scanned, but processing was held up for longer than either
+    const uint16_t scanned = timer_read();
+    advance_time(TAPPING_TERM + COMBO_TERM);
+
+    EXPECT_REPORT(driver, (KC_SPACE));
+    EXPECT_EMPTY_REPORT(driver);
+    action_exec(key_event_at(key_y, true, scanned));
+    action_exec(key_event_at(key_u, true, scanned + 1));
+    action_exec(key_event_at(key_y, false, scanned + 2));
+    action_exec(key_event_at(key_u, false, scanned + 3));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
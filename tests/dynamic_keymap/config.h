@@ -0,0 +1,12 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define EEPROM_SIZE 1024
+
+#define DYNAMIC_KEYMAP_CACHE_ENABLE
+#define DYNAMIC_KEYMAP_CACHE_LAYER_COUNT 2
+#define DYNAMIC_KEYMAP_CACHE_MACROS
@@ -0,0 +1,90 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+
+extern "C" {
+#include "dynamic_keymap.h"
+#include "eeprom.h"
+}
+
+class DynamicKeymapCache : public TestFixture {
+   public:
+    void SetUp() override {
+        dynamic_keymap_reset();
+        dynamic_keymap_macro_reset();
+        dynamic_keymap_init();
+    }
+
+    uint16_t eeprom_keycode(uint8_t layer, uint8_t row, uint8_t column) {
+        uint8_t *address = (uint8_t *)dynamic_keymap_key_to_eeprom_address(layer, row, column);
+        return (eeprom_read_byte(address) << 8) | eeprom_read_byte(address + 1);
+    }
+
+    void eeprom_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint16_t keycode) {
+        uint8_t *address = (uint8_t *)dynamic_keymap_key_to_eeprom_address(layer, row, column);
+        eeprom_write_byte(address, keycode >> 8);
+        eeprom_write_byte(address + 1, keycode & 0xFF);
+    }
+};
+
+TEST_F(DynamicKeymapCache, SetKeycodeWritesThrough) {
+    dynamic_keymap_set_keycode(0, 1, 2, KC_Q);
+    dynamic_keymap_set_keycode(3, 3, 9, LCTL(KC_Z));
+
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 1, 2), KC_Q);
+    EXPECT_EQ(dynamic_keymap_get_keycode(3, 3, 9), LCTL(KC_Z));
+    EXPECT_EQ(eeprom_keycode(0, 1, 2), KC_Q);
+    EXPECT_EQ(eeprom_keycode(3, 3, 9), LCTL(KC_Z));
+}
+
+TEST_F(DynamicKeymapCache, CachedLayersAreServedFromRam) {
+    dynamic_keymap_set_keycode(1, 0, 0, KC_A);
+    dynamic_keymap_set_keycode(2, 0, 0, KC_A);
+
+    // Modify EEPROM behind the cache's back
+    eeprom_set_keycode(1, 0, 0, KC_B);
+    eeprom_set_keycode(2, 0, 0, KC_B);
+
+    EXPECT_EQ(dynamic_keymap_get_keycode(1, 0, 0), KC_A);
+    // Layers beyond DYNAMIC_KEYMAP_CACHE_LAYER_COUNT are still read from EEPROM
+    EXPECT_EQ(dynamic_keymap_get_keycode(2, 0, 0), KC_B);
+
+    dynamic_keymap_init();
+    EXPECT_EQ(dynamic_keymap_get_keycode(1, 0, 0), KC_B);
+}
+
+TEST_F(DynamicKeymapCache, SetBufferUpdatesCache) {
+    // Big endian keycodes straddling the end of layer 1 and the start of layer 2
+    uint16_t offset    = 2 * MATRIX_ROWS * MATRIX_COLS * 2 - 2;
+    uint8_t  data[4]   = {KC_C >> 8, KC_C & 0xFF, KC_D >> 8, KC_D & 0xFF};
+    uint8_t  result[4] = {0};
+
+    dynamic_keymap_set_buffer(offset, sizeof(data), data);
+
+    EXPECT_EQ(dynamic_keymap_get_keycode(1, MATRIX_ROWS - 1, MATRIX_COLS - 1), KC_C);
+    EXPECT_EQ(dynamic_keymap_get_keycode(2, 0, 0), KC_D);
+    EXPECT_EQ(eeprom_keycode(1, MATRIX_ROWS - 1, MATRIX_COLS - 1), KC_C);
+
+    dynamic_keymap_get_buffer(offset, sizeof(result), result);
+    EXPECT_EQ(memcmp(data, result, sizeof(data)), 0);
+}
+
+TEST_F(DynamicKeymapCache, MacroBufferIsCached) {
+    uint8_t *macro_address = (uint8_t *)dynamic_keymap_key_to_eeprom_address(dynamic_keymap_get_layer_count(), 0, 0);
+    uint8_t  data[]        = "abc";
+    uint8_t  result[4]     = {0};
+
+    dynamic_keymap_macro_set_buffer(0, sizeof(data), data);
+    EXPECT_EQ(eeprom_read_byte(macro_address + 1), 'b');
+
+    // Modify EEPROM behind the cache's back
+    eeprom_write_byte(macro_address + 1, 'x');
+
+    dynamic_keymap_macro_get_buffer(0, sizeof(result), result);
+    EXPECT_EQ(memcmp(data, result, sizeof(data)), 0);
+}
@@ -0,0 +1,123 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "action_tapping.h"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+extern "C" {
+#include "latency_trace.h"
+void advance_time(uint32_t ms);
+}
+
+using testing::_;
+
+class LatencyTrace : public TestFixture {
+   public:
+    void SetUp() override {
+        latency_trace_reset();
+    }
+
+    latency_stats_t stats(latency_span_t span) {
+        latency_stats_t result;
+        latency_trace_get_stats(span, &result);
+        return result;
+    }
+};
+
+TEST_F(LatencyTrace, TapTracesPressAndRelease) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key);
+    VERIFY_AND_CLEAR(driver);
+
+    for (uint8_t span = 0; span < LATENCY_SPAN_COUNT; span++) {
+        auto result = stats((latency_span_t)span);
+        EXPECT_EQ(result.count, 2);
+        EXPECT_EQ(result.max_us, 0);
+    }
+}
+
+TEST_F(LatencyTrace, HeldModTapIsAttributedToProcessing) {
+    TestDriver driver;
+    auto       mod_tap_key = KeymapKey(0, 1, 0, SFT_T(KC_P));
+
+    set_keymap({mod_tap_key});
+
+    mod_tap_key.press();
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    idle_for(TAPPING_TERM + 1);
+    VERIFY_AND_CLEAR(driver);
+
+    auto process = stats(LATENCY_SPAN_ACTION_TO_PROCESS);
+    EXPECT_EQ(process.count, 1);
+    EXPECT_GE(process.max_us, TAPPING_TERM * 1000);
+    EXPECT_LE(process.max_us, (TAPPING_TERM + 1) * 1000);
+    EXPECT_EQ(stats(LATENCY_SPAN_TOTAL).max_us, process.max_us);
+    EXPECT_EQ(stats(LATENCY_SPAN_MATRIX_TO_ACTION).max_us, 0);
+
+    EXPECT_EMPTY_REPORT(driver);
+    mod_tap_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LatencyTrace, EventWithoutReportIsNotTraced) {
+    TestDriver driver;
+    auto       layer_key = KeymapKey(0, 0, 0, MO(1));
+    auto       key       = KeymapKey(1, 1, 0, KC_A);
+
+    set_keymap({layer_key, key, KeymapKey(0, 1, 0, KC_B), KeymapKey(1, 0, 0, KC_TRNS)});
+
+    EXPECT_NO_REPORT(driver);
+    layer_key.press();
+    run_one_scan_loop();
+    idle_for(100);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(stats(LATENCY_SPAN_TOTAL).count, 0);
+
+    // The layer key must not be completed by a later, unrelated report
+    EXPECT_REPORT(driver, (KC_A));
+    key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(stats(LATENCY_SPAN_TOTAL).count, 1);
+    EXPECT_EQ(stats(LATENCY_SPAN_TOTAL).max_us, 0);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key.release();
+    run_one_scan_loop();
+    layer_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LatencyTrace, StatisticsSummariseDistribution) {
+    for (int i = 0; i < 100; i++) {
+        keyevent_t event = {.key = {.col = 0, .row = 0}, .time = 0, .type = KEY_EVENT, .pressed = true};
+        latency_trace_mark(LATENCY_STAGE_MATRIX, event);
+        latency_trace_mark(LATENCY_STAGE_ACTION, event);
+        latency_trace_mark(LATENCY_STAGE_PROCESS, event);
+        advance_time(i == 0 ? 50 : 1);
+        latency_trace_report();
+    }
+
+    auto result = stats(LATENCY_SPAN_PROCESS_TO_REPORT);
+    EXPECT_EQ(result.count, 100);
+    EXPECT_EQ(result.min_us, 1000);
+    EXPECT_EQ(result.max_us, 50000);
+    EXPECT_EQ(result.avg_us, 1490);
+    // 1000us falls into the 768-1023us bucket
+    EXPECT_EQ(result.p99_us, 1023);
+
+    latency_trace_reset();
+    EXPECT_EQ(stats(LATENCY_SPAN_PROCESS_TO_REPORT).count, 0);
+}
@@ -0,0 +1,85 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+
+class LayerLookupCache : public TestFixture {
+   public:
+    KeymapKey key = KeymapKey(0, 0, 0, KC_A);
+
+    void SetUp() override {
+        set_keymap({key, KeymapKey(1, 0, 0, KC_TRNS), KeymapKey(2, 0, 0, KC_C), KeymapKey(3, 0, 0, KC_TRNS)});
+        layer_lookup_cache_invalidate();
+    }
+};
+
+TEST_F(LayerLookupCache, TransparentLayersResolveToLowerLayer) {
+    EXPECT_EQ(layer_switch_get_layer(key.position), 0);
+
+    layer_on(1);
+    layer_on(3);
+    EXPECT_EQ(layer_switch_get_layer(key.position), 0);
+
+    layer_on(2);
+    EXPECT_EQ(layer_switch_get_layer(key.position), 2);
+
+    layer_off(1);
+    EXPECT_EQ(layer_switch_get_layer(key.position), 2);
+
+    layer_off(2);
+    EXPECT_EQ(layer_switch_get_layer(key.position), 0);
+}
+
+TEST_F(LayerLookupCache, DefaultLayerChangeIsHonoured) {
+    EXPECT_EQ(layer_switch_get_layer(key.position), 0);
+
+    default_layer_set(1 << 2);
+    EXPECT_EQ(layer_switch_get_layer(key.position), 2);
+
+    default_layer_set(1 << 0);
+    EXPECT_EQ(layer_switch_get_layer(key.position), 0);
+}
+
+TEST_F(LayerLookupCache, DirectLayerStateWriteIsHonoured) {
+    EXPECT_EQ(layer_switch_get_layer(key.position), 0);
+
+    layer_state = 1 << 2;
+    EXPECT_EQ(layer_switch_get_layer(key.position), 2);
+
+    layer_state = 0;
+    EXPECT_EQ(layer_switch_get_layer(key.position), 0);
+}
+
+TEST_F(LayerLookupCache, InvalidateAfterKeymapChange) {
+    layer_on(1);
+    EXPECT_EQ(layer_switch_get_layer(key.position), 0);
+
+    set_keymap({key, KeymapKey(1, 0, 0, KC_B), KeymapKey(2, 0, 0, KC_C), KeymapKey(3, 0, 0, KC_TRNS)});
+    layer_lookup_cache_invalidate();
+    EXPECT_EQ(layer_switch_get_layer(key.position), 1);
+}
+
+TEST_F(LayerLookupCache, KeypressUsesResolvedLayer) {
+    TestDriver driver;
+
+    layer_on(3);
+    layer_on(2);
+
+    EXPECT_REPORT(driver, (KC_C));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key);
+    VERIFY_AND_CLEAR(driver);
+
+    layer_off(2);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key);
+    VERIFY_AND_CLEAR(driver);
+}
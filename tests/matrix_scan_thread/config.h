@@ -0,0 +1,9 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+// Leaves room for a whole number of taps
+#define MATRIX_SCAN_THREAD_QUEUE_SIZE 9
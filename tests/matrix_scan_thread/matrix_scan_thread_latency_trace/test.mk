@@ -0,0 +1,5 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+MATRIX_SCAN_THREAD_ENABLE = yes
+LATENCY_TRACE_ENABLE = yes
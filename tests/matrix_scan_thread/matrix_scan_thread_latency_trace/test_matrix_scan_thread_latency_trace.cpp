@@ -0,0 +1,46 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+extern "C" {
+#include "latency_trace.h"
+#include "matrix_scan_thread.h"
+}
+
+class MatrixScanThreadLatencyTrace : public TestFixture {
+   public:
+    void SetUp() override {
+        latency_trace_reset();
+    }
+};
+
+TEST_F(MatrixScanThreadLatencyTrace, TimeQueuedCountsTowardsMatrixStage) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+
+    EXPECT_TRUE(key_event_queue_push(key_event_at(key, true, timer_read())));
+    advance_time(5);
+
+    EXPECT_REPORT(driver, (KC_A));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    latency_stats_t stats;
+    latency_trace_get_stats(LATENCY_SPAN_MATRIX_TO_ACTION, &stats);
+    EXPECT_EQ(stats.count, 1);
+    EXPECT_GE(stats.min_us, 5000);
+    latency_trace_get_stats(LATENCY_SPAN_TOTAL, &stats);
+    EXPECT_GE(stats.min_us, 5000);
+
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_TRUE(key_event_queue_push(key_event_at(key, false, timer_read())));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,117 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "action_tapping.h"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+extern "C" {
+#include "matrix_scan_thread.h"
+}
+
+using testing::_;
+using testing::InSequence;
+
+class MatrixScanThread : public TestFixture {};
+
+TEST_F(MatrixScanThread, ScannedKeyTap) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(MatrixScanThread, QueuedEventsAreProcessedInOrder) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(0, 1, 0, KC_B);
+
+    set_keymap({key_a, key_b});
+
+    const uint16_t now = timer_read();
+    EXPECT_TRUE(key_event_queue_push(key_event_at(key_a, true, now)));
+    EXPECT_TRUE(key_event_queue_push(key_event_at(key_b, true, now)));
+    EXPECT_TRUE(key_event_queue_push(key_event_at(key_a, false, now)));
+    EXPECT_TRUE(key_event_queue_push(key_event_at(key_b, false, now)));
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(MatrixScanThread, TapDecisionUsesScanTimestamps) {
+    TestDriver driver;
+    InSequence s;
+    auto       mod_tap_key = KeymapKey(0, 1, 0, SFT_T(KC_P));
+
+    set_keymap({mod_tap_key});
+
+    // Processing was held up for longer than the tapping term, but the key
+    // was released within it when the matrix was scanned
+    const uint16_t scanned = timer_read();
+    idle_for(TAPPING_TERM * 2);
+
+    EXPECT_TRUE(key_event_queue_push(key_event_at(mod_tap_key, true, scanned)));
+    EXPECT_TRUE(key_event_queue_push(key_event_at(mod_tap_key, false, scanned + TAPPING_TERM / 2)));
+
+    EXPECT_REPORT(driver, (KC_P));
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(MatrixScanThread, HoldDecisionUsesScanTimestamps) {
+    TestDriver driver;
+    InSequence s;
+    auto       mod_tap_key = KeymapKey(0, 1, 0, SFT_T(KC_P));
+
+    set_keymap({mod_tap_key});
+
+    // Both events are processed in the same task, but the key was held past
+    // the tapping term when the matrix was scanned
+    const uint16_t scanned = timer_read();
+    idle_for(TAPPING_TERM * 2);
+
+    EXPECT_TRUE(key_event_queue_push(key_event_at(mod_tap_key, true, scanned)));
+    EXPECT_TRUE(key_event_queue_push(key_event_at(mod_tap_key, false, scanned + TAPPING_TERM + 1)));
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(MatrixScanThread, FullQueueIsDrained) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+
+    // One slot is always kept free to tell a full queue from an empty one
+    const uint8_t taps = (MATRIX_SCAN_THREAD_QUEUE_SIZE - 1) / 2;
+    for (uint8_t i = 0; i < taps; i++) {
+        EXPECT_TRUE(key_event_queue_push(key_event_at(key, true, timer_read())));
+        EXPECT_TRUE(key_event_queue_push(key_event_at(key, false, timer_read())));
+    }
+    EXPECT_FALSE(key_event_queue_push(key_event_at(key, true, timer_read())));
+
+    EXPECT_REPORT(driver, (KC_A)).Times(taps);
+    EXPECT_EMPTY_REPORT(driver).Times(taps);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    keyevent_t event;
+    EXPECT_FALSE(key_event_queue_pop(&event));
+}
@@ -0,0 +1,110 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+
+extern "C" {
+#include "pointing_device.h"
+}
+
+using testing::_;
+using testing::InSequence;
+
+static report_mouse_t sensor_report = {};
+
+extern "C" report_mouse_t pointing_device_driver_get_report(report_mouse_t mouse_report) {
+    mouse_report.x = sensor_report.x;
+    mouse_report.y = sensor_report.y;
+    mouse_report.h = sensor_report.h;
+    mouse_report.v = sensor_report.v;
+    return mouse_report;
+}
+
+MATCHER_P4(IsMotion, x, y, h, v, "") {
+    return arg.x == x && arg.y == y && arg.h == h && arg.v == v;
+}
+
+class PointingDeviceAccumulate : public TestFixture {
+   protected:
+    void SetUp() override {
+        sensor_report = {};
+    }
+
+    void move(int8_t x, int8_t y, int8_t h = 0, int8_t v = 0) {
+        sensor_report.x = x;
+        sensor_report.y = y;
+        sensor_report.h = h;
+        sensor_report.v = v;
+        run_one_scan_loop();
+        sensor_report = {};
+    }
+};
+
+TEST_F(PointingDeviceAccumulate, SendsMotionWhenHostIsReady) {
+    TestDriver driver;
+
+    EXPECT_CALL(driver, send_mouse_mock(IsMotion(5, -3, 0, 0))).Times(1);
+    move(5, -3);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(PointingDeviceAccumulate, SumsMotionUntilHostIsReady) {
+    TestDriver driver;
+    InSequence s;
+
+    driver.set_mouse_ready(false);
+    EXPECT_CALL(driver, send_mouse_mock(_)).Times(0);
+    move(5, -3, 1, 0);
+    move(7, -2, 0, -1);
+    move(-2, 1, 1, 0);
+    VERIFY_AND_CLEAR(driver);
+
+    // One report carries everything read in the meantime
+    driver.set_mouse_ready(true);
+    EXPECT_CALL(driver, send_mouse_mock(IsMotion(10, -4, 2, -1))).Times(1);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(PointingDeviceAccumulate, CarriesOverMotionThatDoesNotFit) {
+    TestDriver driver;
+    InSequence s;
+
+    driver.set_mouse_ready(false);
+    move(100, -100);
+    move(100, -100);
+    move(100, -100);
+
+    // Each report carries as much as fits, one per host poll
+    driver.set_mouse_ready(true);
+    EXPECT_CALL(driver, send_mouse_mock(IsMotion(127, -128, 0, 0))).Times(2);
+    EXPECT_CALL(driver, send_mouse_mock(IsMotion(46, -44, 0, 0))).Times(1);
+    run_one_scan_loop();
+    run_one_scan_loop();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_CALL(driver, send_mouse_mock(_)).Times(0);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(PointingDeviceAccumulate, SaturatesAccumulatedMotion) {
+    TestDriver driver;
+
+    driver.set_mouse_ready(false);
+    for (int i = 0; i < 300; i++) {
+        move(127, 0);
+    }
+    driver.set_mouse_ready(true);
+
+    // 300 * 127 is more than fits in the accumulator, the excess is dropped
+    int32_t sent = 0;
+    EXPECT_CALL(driver, send_mouse_mock(_)).WillRepeatedly([&sent](report_mouse_t &report) { sent += report.x; });
+    for (int i = 0; i < 300; i++) {
+        run_one_scan_loop();
+    }
+    EXPECT_EQ(sent, INT16_MAX);
+    VERIFY_AND_CLEAR(driver);
+}
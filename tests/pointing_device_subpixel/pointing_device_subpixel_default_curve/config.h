@@ -0,0 +1,13 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define POINTING_DEVICE_SUBPIXEL_ENABLE
+#define POINTING_DEVICE_ACCEL_CURVE                              \
+    {                                                            \
+        {POINTING_DEVICE_FIXED(0), POINTING_DEVICE_FIXED(2)},    \
+        {POINTING_DEVICE_FIXED(100), POINTING_DEVICE_FIXED(2)}, \
+    }
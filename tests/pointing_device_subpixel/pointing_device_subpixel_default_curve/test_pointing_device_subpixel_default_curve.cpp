@@ -0,0 +1,60 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+
+extern "C" {
+#include "pointing_device.h"
+}
+
+using testing::InSequence;
+
+static report_mouse_t sensor_report = {};
+
+extern "C" report_mouse_t pointing_device_driver_get_report(report_mouse_t mouse_report) {
+    mouse_report.x = sensor_report.x;
+    mouse_report.y = sensor_report.y;
+    return mouse_report;
+}
+
+MATCHER_P2(IsMotion, x, y, "") {
+    return arg.x == x && arg.y == y;
+}
+
+class PointingDeviceSubpixelDefaultCurve : public TestFixture {
+   protected:
+    void SetUp() override {
+        sensor_report = {};
+        pointing_device_init();
+    }
+
+    void move(mouse_xy_report_t x, mouse_xy_report_t y) {
+        sensor_report.x = x;
+        sensor_report.y = y;
+        run_one_scan_loop();
+        sensor_report = {};
+    }
+};
+
+TEST_F(PointingDeviceSubpixelDefaultCurve, DefaultCurveCanBeTurnedOff) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_CALL(driver, send_mouse_mock(IsMotion(10, -6))).Times(1);
+    move(5, -3);
+    VERIFY_AND_CLEAR(driver);
+
+    pointing_device_set_accel_curve(NULL, 0);
+    EXPECT_EQ(pointing_device_accel_gain(POINTING_DEVICE_FIXED(5)), POINTING_DEVICE_FIXED_ONE);
+
+    EXPECT_CALL(driver, send_mouse_mock(IsMotion(5, -3))).Times(1);
+    move(5, -3);
+    VERIFY_AND_CLEAR(driver);
+
+    // Initializing again doesn't bring the default curve back
+    pointing_device_init();
+    EXPECT_CALL(driver, send_mouse_mock(IsMotion(5, -3))).Times(1);
+    move(5, -3);
+    VERIFY_AND_CLEAR(driver);
+}
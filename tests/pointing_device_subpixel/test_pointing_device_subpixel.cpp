@@ -0,0 +1,312 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+
+extern "C" {
+#include "pointing_device.h"
+}
+
+using testing::_;
+using testing::InSequence;
+
+static report_mouse_t sensor_report = {};
+
+extern "C" report_mouse_t pointing_device_driver_get_report(report_mouse_t mouse_report) {
+    mouse_report.x = sensor_report.x;
+    mouse_report.y = sensor_report.y;
+    return mouse_report;
+}
+
+MATCHER_P2(IsMotion, x, y, "") {
+    return arg.x == x && arg.y == y;
+}
+
+static const pointing_device_accel_point_t linear_curve[] = {
+    {POINTING_DEVICE_FIXED(0), POINTING_DEVICE_FIXED(1)},
+    {POINTING_DEVICE_FIXED(10), POINTING_DEVICE_FIXED(3)},
+};
+
+// Slow below two counts per report, and accelerating up to four times above
+static const pointing_device_accel_point_t s_curve[] = {
+    {POINTING_DEVICE_FIXED(0), POINTING_DEVICE_FIXED(0.5)},
+    {POINTING_DEVICE_FIXED(2), POINTING_DEVICE_FIXED(0.75)},
+    {POINTING_DEVICE_FIXED(6), POINTING_DEVICE_FIXED(2)},
+    {POINTING_DEVICE_FIXED(16), POINTING_DEVICE_FIXED(4)},
+};
+
+class PointingDeviceSubpixel : public TestFixture {
+   protected:
+    void SetUp() override {
+        sensor_report = {};
+        pointing_device_set_scale(POINTING_DEVICE_FIXED(1));
+        pointing_device_set_accel_curve(NULL, 0);
+        pointing_device_init();
+    }
+
+    void move(mouse_xy_report_t x, mouse_xy_report_t y) {
+        sensor_report.x = x;
+        sensor_report.y = y;
+        run_one_scan_loop();
+        sensor_report = {};
+    }
+};
+
+TEST_F(PointingDeviceSubpixel, PassesMotionThroughAtUnitScale) {
+    TestDriver driver;
+
+    EXPECT_CALL(driver, send_mouse_mock(IsMotion(5, -3))).Times(1);
+    move(5, -3);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(PointingDeviceSubpixel, CarriesFractionalMotion) {
+    TestDriver driver;
+    InSequence s;
+
+    pointing_device_set_scale(POINTING_DEVICE_FIXED(0.25));
+
+    // A quarter count per report adds up to a count every fourth report
+    for (int i = 0; i < 3; i++) {
+        EXPECT_CALL(driver, send_mouse_mock(_)).Times(0);
+        move(1, -1);
+        VERIFY_AND_CLEAR(driver);
+        EXPECT_CALL(driver, send_mouse_mock(_)).Times(0);
+        move(1, -1);
+        move(1, -1);
+        VERIFY_AND_CLEAR(driver);
+        EXPECT_CALL(driver, send_mouse_mock(IsMotion(1, -1))).Times(1);
+        move(1, -1);
+        VERIFY_AND_CLEAR(driver);
+    }
+}
+
+TEST_F(PointingDeviceSubpixel, DropsMotionThatDoesNotFit) {
+    TestDriver driver;
+    InSequence s;
+
+    pointing_device_set_scale(POINTING_DEVICE_FIXED(2));
+
+    EXPECT_CALL(driver, send_mouse_mock(IsMotion(127, -128))).Times(1);
+    move(100, -100);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_CALL(driver, send_mouse_mock(_)).Times(0);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(PointingDeviceSubpixel, CarriesFractionOfMotionThatDoesNotFit) {
+    TestDriver driver;
+    InSequence s;
+
+    pointing_device_set_scale(POINTING_DEVICE_FIXED(1.5));
+
+    // 151.5 counts, of which half a count is kept
+    EXPECT_CALL(driver, send_mouse_mock(IsMotion(127, 0))).Times(1);
+    move(101, 0);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_CALL(driver, send_mouse_mock(IsMotion(2, 0))).Times(1);
+    move(1, 0);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(PointingDeviceSubpixel, AppliesAccelerationCurve) {
+    TestDriver driver;
+    InSequence s;
+
+    pointing_device_set_accel_curve(linear_curve, 2);
+
+    // Halfway along the curve, and past its end
+    EXPECT_CALL(driver, send_mouse_mock(IsMotion(10, 0))).Times(1);
+    EXPECT_CALL(driver, send_mouse_mock(IsMotion(0, -60))).Times(1);
+    move(5, 0);
+    move(0, -20);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(PointingDeviceSubpixel, InterpolatesGain) {
+    pointing_device_set_accel_curve(s_curve, 4);
+
+    EXPECT_EQ(pointing_device_accel_gain(POINTING_DEVICE_FIXED(0)), POINTING_DEVICE_FIXED(0.5));
+    EXPECT_EQ(pointing_device_accel_gain(POINTING_DEVICE_FIXED(1)), POINTING_DEVICE_FIXED(0.625));
+    EXPECT_EQ(pointing_device_accel_gain(POINTING_DEVICE_FIXED(4)), POINTING_DEVICE_FIXED(1.375));
+    EXPECT_EQ(pointing_device_accel_gain(POINTING_DEVICE_FIXED(11)), POINTING_DEVICE_FIXED(3));
+    EXPECT_EQ(pointing_device_accel_gain(POINTING_DEVICE_FIXED(200)), POINTING_DEVICE_FIXED(4));
+}
+
+TEST_F(PointingDeviceSubpixel, MeasuresMotionSpeed) {
+    EXPECT_EQ(pointing_device_motion_speed(3 * POINTING_DEVICE_FIXED_ONE, -4 * POINTING_DEVICE_FIXED_ONE), POINTING_DEVICE_FIXED(5));
+    EXPECT_EQ(pointing_device_motion_speed(POINTING_DEVICE_FIXED_ONE / 2, 0), POINTING_DEVICE_FIXED(0.5));
+    EXPECT_EQ(pointing_device_motion_speed(-300 * POINTING_DEVICE_FIXED_ONE, 0), UINT16_MAX);
+}
+
+////////////////////////////////////////////////////
+// Trace replay
+
+typedef struct {
+    int8_t x;
+    int8_t y;
+} sensor_sample_t;
+
+typedef std::vector<sensor_sample_t> sensor_trace_t;
+
+// Turns a path in fractional counts per report into the whole counts a sensor reports
+static sensor_trace_t quantize_path(const std::vector<std::pair<double, double>> &path) {
+    sensor_trace_t trace;
+    double         x = 0, y = 0;
+    int            sent_x = 0, sent_y = 0;
+    for (const auto &step : path) {
+        x += step.first;
+        y += step.second;
+        sensor_sample_t sample = {(int8_t)(std::lround(x) - sent_x), (int8_t)(std::lround(y) - sent_y)};
+        sent_x += sample.x;
+        sent_y += sample.y;
+        trace.push_back(sample);
+    }
+    return trace;
+}
+
+// A slow drag at a fraction of a count per report, as seen at low CPI
+static sensor_trace_t slow_drag_trace(void) {
+    std::vector<std::pair<double, double>> path;
+    for (int i = 0; i < 2000; i++) {
+        path.push_back({0.3, -0.07});
+    }
+    return quantize_path(path);
+}
+
+// Small circles at varying speed
+static sensor_trace_t circle_trace(void) {
+    std::vector<std::pair<double, double>> path;
+    for (int i = 0; i < 2000; i++) {
+        double speed = 0.5 + 3 * (1 + std::sin(i * 0.004));
+        path.push_back({speed * std::cos(i * 0.02), speed * std::sin(i * 0.02)});
+    }
+    return quantize_path(path);
+}
+
+// Flicks accelerating to 40 counts per report and back, with sensor noise in between
+static sensor_trace_t flick_trace(void) {
+    std::vector<std::pair<double, double>> path;
+    uint32_t                               seed = 1;
+    for (int flick = 0; flick < 10; flick++) {
+        for (int i = 0; i < 100; i++) {
+            double speed = 40 * std::sin(i * M_PI / 100);
+            path.push_back({flick % 2 ? -speed : speed, speed * 0.3});
+        }
+        for (int i = 0; i < 100; i++) {
+            seed = seed * 1103515245 + 12345;
+            path.push_back({((int)((seed >> 16) % 5) - 2) * 0.2, ((int)((seed >> 8) % 5) - 2) * 0.2});
+        }
+    }
+    return quantize_path(path);
+}
+
+typedef struct {
+    const char                          *name;
+    uint16_t                             scale;
+    const pointing_device_accel_point_t *curve;
+    uint8_t                              curve_count;
+} subpixel_config_t;
+
+typedef struct {
+    const char *name;
+    sensor_trace_t (*trace)(void);
+} subpixel_trace_t;
+
+// The gain the curve gives in exact arithmetic
+static double reference_gain(const subpixel_config_t &config, double speed) {
+    if (!config.curve_count) {
+        return 1;
+    }
+    const double one = POINTING_DEVICE_FIXED_ONE;
+    if (speed <= config.curve[0].speed / one) {
+        return config.curve[0].gain / one;
+    }
+    for (uint8_t i = 1; i < config.curve_count; i++) {
+        double low_speed = config.curve[i - 1].speed / one, high_speed = config.curve[i].speed / one;
+        double low_gain = config.curve[i - 1].gain / one, high_gain = config.curve[i].gain / one;
+        if (speed <= high_speed) {
+            return low_gain + (high_gain - low_gain) * (speed - low_speed) / (high_speed - low_speed);
+        }
+    }
+    return config.curve[config.curve_count - 1].gain / one;
+}
+
+class PointingDeviceSubpixelTrace : public PointingDeviceSubpixel, public ::testing::WithParamInterface<std::tuple<subpixel_trace_t, subpixel_config_t>> {};
+
+// Replays a sensor trace, comparing where the pointer ends up against floating point and against rounding every report
+TEST_P(PointingDeviceSubpixelTrace, TracksFloatReference) {
+    TestDriver              driver;
+    const subpixel_trace_t  trace_info = std::get<0>(GetParam());
+    const subpixel_config_t config     = std::get<1>(GetParam());
+    const sensor_trace_t    trace      = trace_info.trace();
+
+    pointing_device_set_scale(config.scale);
+    pointing_device_set_accel_curve(config.curve, config.curve_count);
+
+    int32_t sent_x = 0, sent_y = 0;
+    EXPECT_CALL(driver, send_mouse_mock(_)).WillRepeatedly([&](report_mouse_t &report) {
+        sent_x += report.x;
+        sent_y += report.y;
+    });
+
+    double  reference_x = 0, reference_y = 0;
+    int32_t rounded_x = 0, rounded_y = 0;
+    double  max_error = 0, max_rounded_error = 0, path = 0;
+    int     moving = 0;
+    for (const auto &sample : trace) {
+        double x    = sample.x * config.scale / (double)POINTING_DEVICE_FIXED_ONE;
+        double y    = sample.y * config.scale / (double)POINTING_DEVICE_FIXED_ONE;
+        double gain = reference_gain(config, std::hypot(x, y));
+        reference_x += x * gain;
+        reference_y += y * gain;
+        path += std::hypot(x, y) * gain;
+        moving += sample.x || sample.y;
+        rounded_x += (int32_t)(x * gain);
+        rounded_y += (int32_t)(y * gain);
+
+        move(sample.x, sample.y);
+        max_error         = std::max(max_error, std::hypot(sent_x - reference_x, sent_y - reference_y));
+        max_rounded_error = std::max(max_rounded_error, std::hypot(rounded_x - reference_x, rounded_y - reference_y));
+    }
+    VERIFY_AND_CLEAR(driver);
+
+    printf("[ SUBPIXEL ] %s/%s: %zu reports, %.0f counts moved, max error %.2f counts, %.2f when rounding each report\n", trace_info.name, config.name, trace.size(), path, max_error, max_rounded_error);
+    RecordProperty("max_error_x100", (int)(100 * max_error));
+    RecordProperty("max_rounded_error_x100", (int)(100 * max_rounded_error));
+
+    // Less than a count behind on each axis, plus the gain and each report's motion rounded to 1/256th
+    EXPECT_LT(max_error, std::sqrt(2) + (path + moving / 2.0) / POINTING_DEVICE_FIXED_ONE);
+    EXPECT_LT(max_error * 10, max_rounded_error + 1);
+}
+
+// clang-format off
+INSTANTIATE_TEST_CASE_P(
+    Traces,
+    PointingDeviceSubpixelTrace,
+    ::testing::Combine(
+        ::testing::Values(
+            subpixel_trace_t{"SlowDrag", slow_drag_trace},
+            subpixel_trace_t{"Circle", circle_trace},
+            subpixel_trace_t{"Flick", flick_trace}
+        ),
+        ::testing::Values(
+            subpixel_config_t{"Unit", POINTING_DEVICE_FIXED(1), NULL, 0},
+            subpixel_config_t{"Scaled", POINTING_DEVICE_FIXED(0.37), NULL, 0},
+            subpixel_config_t{"Linear", POINTING_DEVICE_FIXED(1), linear_curve, 2},
+            subpixel_config_t{"ScaledCurve", POINTING_DEVICE_FIXED(0.6), s_curve, 4}
+        )
+    ),
+    [](const ::testing::TestParamInfo<std::tuple<subpixel_trace_t, subpixel_config_t>>& info) {
+        return std::string(std::get<0>(info.param).name) + std::get<1>(info.param).name;
+    });
+// clang-format on
@@ -0,0 +1,10 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define SEND_STRING_ASYNC_READY_TIMEOUT 20
+// Small enough for the alphabet to go through the queue in several parts
+#define SEND_STRING_ASYNC_BUFFER_SIZE 32
@@ -0,0 +1,176 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+
+extern "C" {
+#include "send_string.h"
+}
+
+using testing::_;
+using testing::InSequence;
+
+class SendStringAsync : public TestFixture {};
+
+TEST_F(SendStringAsync, ReturnsBeforeTyping) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    send_string_async("ab");
+    EXPECT_TRUE(send_string_async_busy());
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A)).Times(1);
+    EXPECT_REPORT(driver, (KC_B)).Times(1);
+    EXPECT_EMPTY_REPORT(driver).Times(2);
+    idle_for(10);
+    EXPECT_FALSE(send_string_async_busy());
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, SendsOneKeystrokePerScan) {
+    TestDriver driver;
+
+    send_string_async("A");
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_A));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    EXPECT_FALSE(send_string_async_busy());
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, WaitsForInterval) {
+    TestDriver driver;
+    InSequence s;
+
+    send_string_with_delay_async("a", 10);
+
+    EXPECT_REPORT(driver, (KC_A));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(9);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // The interval after the last keystroke is waited for as well
+    EXPECT_TRUE(send_string_async_busy());
+    idle_for(10);
+    EXPECT_FALSE(send_string_async_busy());
+}
+
+TEST_F(SendStringAsync, WaitsForDelayCode) {
+    TestDriver driver;
+    InSequence s;
+
+    SEND_STRING_ASYNC("a" SS_DELAY(20) "b");
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(2);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(19);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(2);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, HoldsKeystrokesUntilHostIsReady) {
+    TestDriver driver;
+    InSequence s;
+
+    driver.set_keyboard_ready(false);
+    send_string_async("a");
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+
+    driver.set_keyboard_ready(true);
+    EXPECT_REPORT(driver, (KC_A));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, SendsAnywayAfterReadyTimeout) {
+    TestDriver driver;
+    InSequence s;
+
+    driver.set_keyboard_ready(false);
+    send_string_async("a");
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(SEND_STRING_ASYNC_READY_TIMEOUT);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // Every keystroke waits for the host again
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(SEND_STRING_ASYNC_READY_TIMEOUT + 1);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, TypesStringsInOrder) {
+    TestDriver driver;
+    InSequence s;
+
+    // More keystrokes than fit in the queue, and more strings than fit in the buffer
+    static const char alphabet[] = "abcdefghijklmnopqrstuvwxyz";
+    for (int i = 0; i < 2; i++) {
+        for (const char *c = alphabet; *c; c++) {
+            EXPECT_REPORT(driver, (KC_A + *c - 'a'));
+            EXPECT_EMPTY_REPORT(driver);
+        }
+    }
+
+    // The second string waits for the first to be typed, as they don't both fit in the buffer
+    send_string_async(alphabet);
+    send_string_async(alphabet);
+    idle_for(2 * 2 * 26);
+    EXPECT_FALSE(send_string_async_busy());
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, BlockingSendKeepsOrder) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    send_string_async("a");
+    send_string("b");
+    VERIFY_AND_CLEAR(driver);
+}
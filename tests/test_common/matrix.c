@@ -26,7 +26,9 @@ void matrix_init(void) {
 }
 
 uint8_t matrix_scan(void) {
+#ifndef MATRIX_SCAN_THREAD_ENABLE
     matrix_scan_kb();
+#endif
     return 1;
 }
 
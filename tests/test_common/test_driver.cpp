@@ -31,7 +31,7 @@ uint8_t hex_digit_to_keycode(uint8_t digit) {
 }
 } // namespace
 
-TestDriver::TestDriver() : m_driver{&TestDriver::keyboard_leds, &TestDriver::send_keyboard, &TestDriver::send_nkro, &TestDriver::send_mouse, &TestDriver::send_extra} {
+TestDriver::TestDriver() : m_driver{&TestDriver::keyboard_leds, &TestDriver::send_keyboard, &TestDriver::send_nkro, &TestDriver::send_mouse, &TestDriver::send_extra, &TestDriver::keyboard_ready, &TestDriver::mouse_ready} {
     host_set_driver(&m_driver);
     m_this = this;
 }
@@ -61,6 +61,14 @@ void TestDriver::send_extra(report_extra_t* report) {
     m_this->send_extra_mock(*report);
 }
 
+bool TestDriver::keyboard_ready(void) {
+    return m_this->m_keyboard_ready;
+}
+
+bool TestDriver::mouse_ready(void) {
+    return m_this->m_mouse_ready;
+}
+
 namespace internal {
 void expect_unicode_code_point(TestDriver& driver, uint32_t code_point) {
     testing::InSequence seq;
@@ -30,6 +30,12 @@ class TestDriver {
     void set_leds(uint8_t leds) {
         m_leds = leds;
     }
+    void set_keyboard_ready(bool ready) {
+        m_keyboard_ready = ready;
+    }
+    void set_mouse_ready(bool ready) {
+        m_mouse_ready = ready;
+    }
 
     MOCK_METHOD1(send_keyboard_mock, void(report_keyboard_t&));
     MOCK_METHOD1(send_nkro_mock, void(report_nkro_t&));
@@ -42,8 +48,12 @@ class TestDriver {
     static void        send_nkro(report_nkro_t* report);
     static void        send_mouse(report_mouse_t* report);
     static void        send_extra(report_extra_t* report);
+    static bool        keyboard_ready(void);
+    static bool        mouse_ready(void);
     host_driver_t      m_driver;
-    uint8_t            m_leds = 0;
+    uint8_t            m_leds           = 0;
+    bool               m_keyboard_ready = true;
+    bool               m_mouse_ready    = true;
     static TestDriver* m_this;
 };
 
@@ -23,6 +23,13 @@
 #include "keyboard.h"
 #include "test_keymap_key.hpp"
 
+extern "C" {
+/**
+ * @brief Moves the simulated time forward by `ms` without running any tasks.
+ */
+void advance_time(uint32_t ms);
+}
+
 class TestFixture : public testing::Test {
    public:
     static TestFixture* m_this;
@@ -38,3 +38,7 @@ void KeymapKey::release() {
     uint32_t now = timer_read32();
     test_logger.trace() << std::setw(10) << std::left << "released: " << this->name << " was pressed for " << now - this->timestamp_pressed << "ms" << std::endl;
 }
+
+keyevent_t key_event_at(const KeymapKey& key, bool pressed, uint16_t time) {
+    return (keyevent_t){.key = key.position, .time = time, .type = KEY_EVENT, .pressed = pressed};
+}
@@ -54,3 +54,8 @@ struct KeymapKey {
     }
     uint32_t timestamp_pressed;
 };
+
+/**
+ * @brief Builds the event of `key` changing state at `time`, as if it had been scanned then.
+ */
+keyevent_t key_event_at(const KeymapKey& key, bool pressed, uint16_t time);
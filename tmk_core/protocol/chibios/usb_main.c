@@ -465,6 +465,16 @@ void send_keyboard(report_keyboard_t *report) {
     }
 }
 
+bool keyboard_ready(void) {
+#ifdef NKRO_ENABLE
+    // NKRO reports go out on the shared endpoint
+    if (!usb_endpoint_in_is_inactive(&usb_endpoints_in[USB_ENDPOINT_IN_SHARED])) {
+        return false;
+    }
+#endif
+    return usb_endpoint_in_is_inactive(&usb_endpoints_in[USB_ENDPOINT_IN_KEYBOARD]);
+}
+
 void send_nkro(report_nkro_t *report) {
 #ifdef NKRO_ENABLE
     send_report(USB_ENDPOINT_IN_SHARED, report, sizeof(report_nkro_t));
@@ -482,6 +492,14 @@ void send_mouse(report_mouse_t *report) {
 #endif
 }
 
+bool mouse_ready(void) {
+#ifdef MOUSE_ENABLE
+    return usb_endpoint_in_is_inactive(&usb_endpoints_in[USB_ENDPOINT_IN_MOUSE]);
+#else
+    return true;
+#endif
+}
+
 /* ---------------------------------------------------------
  *                   Extrakey functions
  * ---------------------------------------------------------
@@ -40,6 +40,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 extern keymap_config_t keymap_config;
 #endif
 
+#ifdef LATENCY_TRACE_ENABLE
+#    include "latency_trace.h"
+#endif
+
 static host_driver_t *driver;
 static uint16_t       last_system_usage   = 0;
 static uint16_t       last_consumer_usage = 0;
@@ -71,8 +75,36 @@ led_t host_keyboard_led_state(void) {
     return (led_t)host_keyboard_leds();
 }
 
+/* Whether a keyboard report sent now would go out without queueing behind earlier ones */
+bool host_keyboard_ready(void) {
+#ifdef BLUETOOTH_ENABLE
+    if (where_to_send() == OUTPUT_BLUETOOTH) {
+        return true;
+    }
+#endif
+
+    if (!driver || !driver->keyboard_ready) return true;
+    return (*driver->keyboard_ready)();
+}
+
+/* Whether a mouse report sent now would go out without queueing behind earlier ones */
+bool host_mouse_ready(void) {
+#ifdef BLUETOOTH_ENABLE
+    if (where_to_send() == OUTPUT_BLUETOOTH) {
+        return true;
+    }
+#endif
+
+    if (!driver || !driver->mouse_ready) return true;
+    return (*driver->mouse_ready)();
+}
+
 /* send report */
 void host_keyboard_send(report_keyboard_t *report) {
+#ifdef LATENCY_TRACE_ENABLE
+    latency_trace_report();
+#endif
+
 #ifdef BLUETOOTH_ENABLE
     if (where_to_send() == OUTPUT_BLUETOOTH) {
         bluetooth_send_keyboard(report);
@@ -96,6 +128,10 @@ void host_keyboard_send(report_keyboard_t *report) {
 }
 
 void host_nkro_send(report_nkro_t *report) {
+#ifdef LATENCY_TRACE_ENABLE
+    latency_trace_report();
+#endif
+
     if (!driver) return;
     report->report_id = REPORT_ID_NKRO;
     (*driver->send_nkro)(report);
@@ -37,6 +37,8 @@ host_driver_t *host_get_driver(void);
 /* host driver interface */
 uint8_t host_keyboard_leds(void);
 led_t   host_keyboard_led_state(void);
+bool    host_keyboard_ready(void);
+bool    host_mouse_ready(void);
 void    host_keyboard_send(report_keyboard_t *report);
 void    host_nkro_send(report_nkro_t *report);
 void    host_mouse_send(report_mouse_t *report);
@@ -18,6 +18,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #pragma once
 
 #include <stdint.h>
+#include <stdbool.h>
 #include "report.h"
 #ifdef MIDI_ENABLE
 #    include "midi.h"
@@ -29,6 +30,10 @@ typedef struct {
     void (*send_nkro)(report_nkro_t *);
     void (*send_mouse)(report_mouse_t *);
     void (*send_extra)(report_extra_t *);
+    // Optional, whether the last keyboard report has gone out to the host
+    bool (*keyboard_ready)(void);
+    // Optional, whether the last mouse report has gone out to the host
+    bool (*mouse_ready)(void);
 } host_driver_t;
 
 void send_joystick(report_joystick_t *report);